@@ -25,6 +25,8 @@
 #include "stdio.h"
 #include "stdlib.h"
 #include "math.h"
+#include "emmintrin.h"
+#include "atomic"
 
 
 
@@ -33,7 +35,13 @@
 #include "d3d11_graphics.cpp"
 
 #include "utf8_strings.h"
+#include "utf8_unicode_tables.h"
+#include "utf8_segmentation.h"
+#include "utf8_bidi.h"
 #include "utf8_textedit.h"
+#include "utf8_regex.h"
+#include "app_input.h"
+#include "app_atlas.h"
 #include "tests.cpp"
 
 #define STBTT_STATIC 1
@@ -42,33 +50,33 @@
 #include "stb_truetype.h"
 
 #include "app_glyph_cache.h"
+#include "app_text_run_cache.h"
 
 
 
 
 
-struct Input_Event
-{
-    u8 vk_code; // is equal to zero if str is filled
-    u8 shift : 1;
-    u8 control : 1;
-    u8 alt : 1;
-    u8 released : 1;
-    char cstr[4]; // single codepoint encoded in utf8 - zero terminated if it's less than 4 bytes
-};
-
 struct App_State
 {
+    // The window is created by the input thread - it receives all window messages
+    //   and passes them to the frame loop through input_ring.
     HWND window;
-    wchar_t wm_char_high_surrogate;
+    HANDLE window_created; // event
+    wchar_t wm_char_high_surrogate; // input thread only
     
-    Input_Event input_events[64];
-    u32 input_event_count;
+    Input_Ring input_ring;
+    Input_Recorder input_recorder; // enabled with "-record <path>" command line
+    s64 input_recorder_start_time;
     
     b8 left_mouse_down;
     b8 left_mouse_down_first_frame;
+    b8 left_mouse_down_with_alt; // adds a new cursor instead of moving the old one
+    b8 left_mouse_double_click; // selects a word
+    b8 left_mouse_down_with_control; // double click adds the word to the selection set
     v2 mouse_pos;
     void *ui_active;
+    Text_Input *ui_focused; // gets keyboard input
+    Text_Run_Cache text_runs; // labels & placeholders of all widgets
     
     s64 last_frame_time;
     f32 delta_t;
@@ -110,6 +118,20 @@ static void assert_and_throw_message(b32 expression, char *message)
 }
 
 
+static void exit_app()
+{
+    input_recorder_end(&app_state.input_recorder);
+    ExitProcess(0);
+}
+
+static void push_input_event(Input_Event event)
+{
+    u64 time_us = time_elapsed_us(time_perf(), app_state.input_recorder_start_time);
+    input_recorder_write(&app_state.input_recorder, event, time_us);
+    input_ring_push(&app_state.input_ring, event);
+}
+
+
 static LRESULT window_procedure(HWND window, UINT message, WPARAM wParam, LPARAM lParam)
 {
     LRESULT result = 0;
@@ -118,42 +140,39 @@ static LRESULT window_procedure(HWND window, UINT message, WPARAM wParam, LPARAM
         case WM_QUIT:
         case WM_CLOSE:
         {
-            ExitProcess(0);
+            exit_app();
         } break;
         
         case WM_SYSKEYDOWN:
         {
             if ((wParam == VK_F4) && (lParam & 29)) {
-                ExitProcess(0);
+                exit_app();
             }
         } break;
         
         case WM_LBUTTONDOWN:
+        case WM_LBUTTONDBLCLK:
         case WM_LBUTTONUP:
         {
-            b8 is_down = (message == WM_LBUTTONDOWN);
-            app_state.left_mouse_down_first_frame = is_down;
+            b8 is_down = (message != WM_LBUTTONUP);
             
-            if (app_state.input_event_count < array_count(app_state.input_events))
-            {
-                Input_Event *event = &app_state.input_events[app_state.input_event_count++];
-                *event = {};
-                event->vk_code = (u8)VK_LBUTTON;
-                event->released = !is_down;
-            }
+            Input_Event event = {};
+            event.vk_code = (u8)VK_LBUTTON;
+            event.released = !is_down;
+            event.double_click = (message == WM_LBUTTONDBLCLK);
+            event.control = !!(GetKeyState(VK_CONTROL) & (1 << 15));
+            event.alt = !!(GetKeyState(VK_MENU) & (1 << 15));
+            push_input_event(event);
         } break;
         
         case WM_KEYDOWN:
         {
-            if (app_state.input_event_count < array_count(app_state.input_events))
-            {
-                Input_Event *event = &app_state.input_events[app_state.input_event_count++];
-                *event = {};
-                event->vk_code = (u8)wParam;
-                event->shift = !!(GetKeyState(VK_SHIFT) & (1 << 15));
-                event->control = !!(GetKeyState(VK_CONTROL) & (1 << 15));
-                event->alt = !!(lParam & (1 << 29));
-            }
+            Input_Event event = {};
+            event.vk_code = (u8)wParam;
+            event.shift = !!(GetKeyState(VK_SHIFT) & (1 << 15));
+            event.control = !!(GetKeyState(VK_CONTROL) & (1 << 15));
+            event.alt = !!(lParam & (1 << 29));
+            push_input_event(event);
         } break;
         
         case WM_CHAR:
@@ -185,22 +204,21 @@ static LRESULT window_procedure(HWND window, UINT message, WPARAM wParam, LPARAM
             }
             
             
-            if (wide_char_count &&
-                app_state.input_event_count < array_count(app_state.input_events))
+            if (wide_char_count)
             {
                 // Filter out garbage characters that get sent when you press Control + some key
                 // (You might want to make an exception for a new line character)
                 if (!(wide_char_count == 1 && wide_chars[0] < ' ' || wide_chars[0] == 0x7F))
                 {
-                    Input_Event *event = &app_state.input_events[app_state.input_event_count++];
-                    *event = {};
-                    event->shift = !!(GetKeyState(VK_SHIFT) & (1 << 15));
-                    event->control = !!(GetKeyState(VK_CONTROL) & (1 << 15));
+                    Input_Event event = {};
+                    event.shift = !!(GetKeyState(VK_SHIFT) & (1 << 15));
+                    event.control = !!(GetKeyState(VK_CONTROL) & (1 << 15));
                     
                     s32 count = WideCharToMultiByte(CP_UTF8, 0,
                                                     wide_chars, wide_char_count,
-                                                    event->cstr, array_count(event->cstr),
+                                                    event.cstr, array_count(event.cstr),
                                                     nullptr, false);
+                    push_input_event(event);
                 }
             }
         } break;
@@ -219,11 +237,43 @@ static LRESULT window_procedure(HWND window, UINT message, WPARAM wParam, LPARAM
 
 
 
+static String get_clipboard_text(u8 *memory, u64 memory_size)
+{
+    // Converts clipboard text to utf8 - it gets truncated if it doesn't fit.
+    String result = {memory, 0};
+    if (!OpenClipboard(app_state.window)) {
+        return result;
+    }
+    
+    HANDLE data = GetClipboardData(CF_UNICODETEXT);
+    wchar_t *wide = (data ? (wchar_t *)GlobalLock(data) : nullptr);
+    if (wide)
+    {
+        // every utf16 code unit turns into at most 3 bytes
+        s32 wide_count = (s32)wcsnlen(wide, memory_size / 3);
+        if (wide_count && IS_HIGH_SURROGATE(wide[wide_count - 1])) {
+            wide_count -= 1;
+        }
+        
+        s32 count = WideCharToMultiByte(CP_UTF8, 0, wide, wide_count,
+                                        (char *)memory, (s32)memory_size, nullptr, nullptr);
+        result.size = get_max(count, 0);
+        GlobalUnlock(data);
+    }
+    
+    CloseClipboard();
+    return result;
+}
+
+
+
 static f32 render_codepoint(Font *font, u32 codepoint, f32 x, f32 y, u32 rgba)
 {
-    Glyph first_glyph = get_glyph(font, codepoint);
+    // x keeps its subpixel phase (see get_subpixel_position) so scrolled text doesn't jitter, y is rounded.
+    Subpixel_Position position = get_subpixel_position(font, x);
+    Glyph glyph = get_glyph(font, codepoint | position.phase_bits);
     
-    if (first_glyph.status == Glyph_Invalid)
+    if (glyph.status == Glyph_Invalid)
     {
         // You can do something more fancy for missing codepoints here
         // But I feel like it should be more application specific.
@@ -231,64 +281,203 @@ static f32 render_codepoint(Font *font, u32 codepoint, f32 x, f32 y, u32 rgba)
         // Or you can to draw a fancy rectangle or a valve-style-checkerboard
         rgba ^= Bitmask_24;
         codepoint = '?';
-        first_glyph = get_glyph(font, codepoint);
+        glyph = get_glyph(font, codepoint | position.phase_bits);
     }
     
     
-    Glyph glyph = first_glyph;
-    x = roundf(x + (f32)glyph.offset_x);
-    y = roundf(y + (f32)glyph.offset_y);
-    
-    for (s32 index = 0;;)
+    // whitespace & glyphs too big for the texture have only metrics
+    if (glyph.status == Glyph_Loaded)
     {
-#if 0 // debug code for coloring glyph segments
-        s32 ii = index + 1;
-        rgba = (255 << 24 |
-                ii*32 << 16 |
-                ii*32 << 8 |
-                ii*32 << 0);
-#endif
-        
         push_and_fill_quad_indicies(1);
         
         u32 *raw_u32 = push_raw_data(8);
         f32 *raw_f32 = (f32 *)raw_u32;
         raw_u32[0] = ui_state.active_clip_address;
-        raw_f32[1] = x;
-        raw_f32[2] = y;
+        raw_f32[1] = position.pixel_x + (f32)glyph.offset_x;
+        raw_f32[2] = roundf(y + (f32)glyph.offset_y);
         raw_f32[3] = (f32)glyph.width;
         raw_f32[4] = (f32)glyph.height;
         raw_f32[5] = (f32)glyph.tex_x;
         raw_f32[6] = (f32)glyph.tex_y;
         raw_u32[7] = rgba;
-        
-        
-        index += 1;
-        if (index <= (s32)first_glyph.additional_segment_count)
+    }
+    
+    return glyph.advance;
+}
+
+
+
+
+static void text_input_set_cursor_from_mouse(Text_Input *text, s64 pos)
+{
+    // called every frame while the text input is active
+    if (app_state.left_mouse_double_click)
+    {
+        // selection stays on the word until the mouse button is released
+        if (app_state.left_mouse_down_first_frame)
         {
-            x += (f32)glyph.width;
-            glyph = get_glyph(font, codepoint | (index << 21));
-            
-            if (glyph.status != Glyph_Loaded)
+            if (!app_state.left_mouse_down_with_control ||
+                !text_input_toggle_word_selection(text, pos))
             {
-                assert(0);
-                break;
+                text_input_clear_additional_cursors(text);
+                text_input_select_word(text, pos);
             }
         }
-        else
+    }
+    else
+    {
+        if (app_state.left_mouse_down_first_frame)
         {
-            break;
+            if (!app_state.left_mouse_down_with_alt ||
+                !text_input_add_cursor(text, pos, pos))
+            {
+                text_input_clear_additional_cursors(text);
+                text->mark_pos = pos;
+            }
+        }
+        
+        text->cursor_pos = pos;
+    }
+}
+
+
+
+static f32 render_text_run(Font *font, String text, f32 x, f32 y, u32 rgba)
+{
+    // Draws a whole string - quads are copied from the text run cache, glyphs are looked up only
+    //   the first time a string is drawn. Returns the advance (kerning between glyphs included).
+    x = roundf(x); // runs start at whole pixels
+    Text_Run *run = get_text_run(&app_state.text_runs, font, text);
+    if (!run)
+    {
+        // too big for the cache
+        f32 start_x = x;
+        u16 prev_stb_index = 0;
+        for (u64 index = 0; index < text.size;)
+        {
+            Unicode_Consume consume = utf8_consume(str_skip(text, index));
+            Glyph_Metrics glyph = get_glyph_metrics(font, consume.codepoint);
+            if (index) {
+                x += get_kerning(font, prev_stb_index, glyph.stb_index);
+            }
+            prev_stb_index = glyph.stb_index;
+            
+            x += render_codepoint(font, consume.codepoint, x, y, rgba);
+            index += consume.inc;
         }
+        return x - start_x;
+    }
+    
+    Text_Run_Quad *quads = get_text_run_quads(&app_state.text_runs, run);
+    for (u32 quad_index = 0; quad_index < run->quad_count; quad_index += 1)
+    {
+        Text_Run_Quad quad = quads[quad_index];
+        push_and_fill_quad_indicies(1);
+        
+        u32 *raw_u32 = push_raw_data(8);
+        f32 *raw_f32 = (f32 *)raw_u32;
+        raw_u32[0] = ui_state.active_clip_address;
+        raw_f32[1] = x + quad.x;
+        raw_f32[2] = roundf(y + quad.y);
+        raw_f32[3] = (f32)quad.width;
+        raw_f32[4] = (f32)quad.height;
+        raw_f32[5] = (f32)quad.tex_x;
+        raw_f32[6] = (f32)quad.tex_y;
+        raw_u32[7] = rgba ^ quad.rgba_xor;
+    }
+    return run->advance;
+}
+
+static void text_layout_update(Text_Layout *layout, Text_Input *text, Font *font)
+{
+    // Only boundaries after the last valid one get computed - after an edit that's the suffix after its start.
+    // Nothing happens if the text didn't change.
+    // x of a boundary includes kerning with the glyph that starts there (text_layout_invalidate cuts it too).
+    // Advances come from get_glyph_metrics - glyphs that are measured but not visible never get rasterized.
+    if (layout->font != font || layout->version != text->version)
+    {
+        layout->font = font;
+        layout->version = text->version;
+        layout->count = 0;
+    }
+    
+    if (!layout->count) {
+        layout->boundaries[layout->count++] = {0, 0.f};
+    }
+    
+    Text_Layout_Boundary boundary = layout->boundaries[layout->count - 1];
+    String text_string = str_skip(text->buffer, boundary.byte_index);
+    if (!text_string.size) {
+        return;
     }
     
-    return first_glyph.advance;
+    Unicode_Consume consume = utf8_consume(text_string);
+    Glyph_Metrics glyph = get_glyph_metrics(font, consume.codepoint);
+    
+    for (;;)
+    {
+        text_string = str_skip(text_string, consume.inc);
+        boundary.byte_index += consume.inc;
+        boundary.x += glyph.advance;
+        
+        b32 is_last = (text_string.size == 0);
+        if (!is_last)
+        {
+            consume = utf8_consume(text_string);
+            Glyph_Metrics next_glyph = get_glyph_metrics(font, consume.codepoint);
+            boundary.x += get_kerning(font, glyph.stb_index, next_glyph.stb_index);
+            glyph = next_glyph;
+        }
+        
+        assert(layout->count < layout->cap);
+        layout->boundaries[layout->count++] = boundary;
+        
+        if (is_last) {
+            break;
+        }
+    }
 }
 
+static void render_selection_range(Text_Layout *layout, Text_Bidi *bidi, f32 origin_x,
+                                   s64 min, s64 max, f32 y, f32 cursor_w, f32 h,
+                                   u32 color, u32 border_color)
+{
+    if (min >= max) {
+        return;
+    }
+    
+    if (!bidi || !bidi->has_rtl)
+    {
+        f32 x0 = origin_x + text_layout_x_of(layout, min);
+        f32 x1 = origin_x + text_layout_x_of(layout, max);
+        render_text_input_rect(x0, y, x1 - x0 + cursor_w, h,
+                               0.05f, 0.05f, color, border_color);
+        return;
+    }
+    
+    // bidi text - one rect per run that the selection touches
+    for (s64 run_index = text_bidi_first_run_ending_after(bidi, min);
+         run_index < bidi->count && bidi->runs[run_index].start < max;
+         run_index += 1)
+    {
+        Bidi_Run run = bidi->runs[run_index];
+        f32 x0 = text_bidi_x_in_run(bidi, layout, run_index, get_max(min, run.start));
+        f32 x1 = text_bidi_x_in_run(bidi, layout, run_index, get_min(max, run.one_past_end));
+        if (x0 > x1)
+        {
+            f32 temp = x0;
+            x0 = x1;
+            x1 = temp;
+        }
+        render_text_input_rect(origin_x + x0, y, x1 - x0 + cursor_w, h,
+                               0.05f, 0.05f, color, border_color);
+    }
+}
 
 
 
 static void draw_text_input_inner(Text_Input *text, Font *font,
-                                  Rect text_rect, f32 padding_x, f32 padding_y,
+                                  Rect text_rect, f32 padding_x, f32 padding_y, String placeholder,
                                   b32 update_scroll_x_and_skip_drawing)
 {
     f32 scroll_x;
@@ -322,145 +511,206 @@ static void draw_text_input_inner(Text_Input *text, Font *font,
     f32 text_x1 = text_rect.x + text_rect.w;
     f32 text_y1 = text_rect.y + text_rect.h;
     
-    f32 pos_x = text_rect.x + padding_x + scroll_x;
+    f32 origin_x = text_rect.x + padding_x + scroll_x;
     f32 base_y = text_y1 - padding_y + font->descent;
     
+    // glyph positions come from the layout - it gets recomputed only after edits
+    Text_Layout *layout = text->layout;
+    text_layout_update(layout, text, font);
+    Text_Layout_Boundary *boundaries = layout->boundaries;
+    f32 end_x = origin_x + boundaries[layout->count - 1].x;
     
-    if (!update_scroll_x_and_skip_drawing)
+    // right to left text gets reordered - bidi runs are cached the same way as the layout
+    Text_Bidi *bidi = text->bidi;
+    b32 is_bidi = false;
+    if (bidi)
     {
-        ui_state.layer = 0;
-        f32 border_share = 0.1f;
-        render_text_input_rect(text_rect, 0.2f, border_share, 0xff11aaff, 0xff001122);
-        ui_state.layer = 1;
-        
-        f32 border = border_share*text_rect.h*0.5f;
-        Rect text_rect_minus_border = rect_contract(text_rect, border);
-        set_clip_rect(text_rect_minus_border);
+        text_bidi_update(text);
+        is_bidi = bidi->has_rtl;
     }
+    auto caret_x = [&](s64 pos) {
+        return (bidi ? text_bidi_x_of(bidi, layout, pos) : text_layout_x_of(layout, pos));
+    };
     
     
     f32 cursor_y0 = text_y1 - padding_y + font->descent - font->ascent;
     f32 cursor_h = font->ascent - font->descent;
     f32 cursor_w = 2.f + cursor_h*0.05f;
     
-    
-    s64 cursor_min = get_min(text->cursor_pos, text->mark_pos);
-    s64 cursor_max = get_max(text->cursor_pos, text->mark_pos);
-    f32 selection_min = 0.f;
-    f32 selection_max = 0.f;
-    
-    f32 mouse_best_distance = 10000000.f;
     s64 mouse_set_cursor_pos = -1;
-    f32 current_target_scroll_diff = text->target_scroll_x - text->current_scroll_x;
     
     
-    s64 byte_index = 0;
-    String text_string = text->buffer;
-    
-    
-    
-    auto update_cursor = [&]() {
-        if (!update_scroll_x_and_skip_drawing)
+    if (!update_scroll_x_and_skip_drawing)
+    {
+        ui_state.layer = 0;
+        f32 border_share = 0.1f;
+        render_text_input_rect(text_rect, 0.2f, border_share, 0xff11aaff, 0xff001122);
+        ui_state.layer = 1;
+        
+        f32 border = border_share*text_rect.h*0.5f;
+        Rect text_rect_minus_border = rect_contract(text_rect, border);
+        set_clip_rect(text_rect_minus_border);
+        
+        
+        // Only glyphs that intersect the clip rect get decoded & emitted - the layout gives the first one
+        //   with a binary search so the cost depends on the visible width, not on the buffer size.
+        // Margin covers glyphs that are drawn outside of their advance.
+        f32 cull_margin = (f32)font->max_height;
+        f32 cull_x0 = text_rect.x - cull_margin - origin_x;
+        f32 cull_x1 = text_x1 + cull_margin - origin_x;
+        s64 first_visible = text_layout_last_at_or_before_x(layout, cull_x0);
+        s64 last_visible = text_layout_last_at_or_before_x(layout, cull_x1);
+        s64 visible_min = boundaries[first_visible].byte_index;
+        s64 visible_max = boundaries[last_visible].byte_index;
+        
+        if (!is_bidi)
         {
-            if (cursor_min == byte_index) {
-                selection_min = pos_x;
-            }
-            if (cursor_max == byte_index) {
-                selection_max = pos_x;
-            }
-            
-            if (text->cursor_pos == byte_index)
+            s64 one_past_last_visible = get_min(last_visible + 1, layout->count - 1);
+            for (s64 boundary_index = first_visible; boundary_index < one_past_last_visible; boundary_index += 1)
             {
-                render_text_input_rect(pos_x, cursor_y0,
-                                       cursor_w, cursor_h, 
-                                       0.05f, 0.f, 0xffff'ffff, 0xffff'ffff);
+                s64 byte_index = boundaries[boundary_index].byte_index;
+                u64 size = (u64)(boundaries[boundary_index + 1].byte_index - byte_index);
+                Unicode_Consume consume = utf8_consume(text->buffer.str + byte_index, size);
+                
+                u32 glyph_color = 0xff000513;
+                render_codepoint(font, consume.codepoint, origin_x + boundaries[boundary_index].x, base_y, glyph_color);
             }
         }
         else
         {
-            if (text->cursor_pos == byte_index)
-            {
-                if (pos_x + padding_x > text_x1)
-                {
-                    text->target_scroll_x -= (pos_x + padding_x - text_x1);
-                }
-                if (pos_x - padding_x < text_rect.x)
-                {
-                    text->target_scroll_x += (-pos_x + padding_x + text_rect.x);
-                }
-            }
-            
-            
+            // Visible slots from left to right - glyphs of a right to left run are placed from its right edge.
+            // Visible bytes aren't a single range anymore - cursors & selections aren't culled.
+            visible_min = 0;
+            visible_max = text->buffer.size;
             
-            if (app_state.ui_active == text)
+            for (s64 slot = text_bidi_slot_at_x(bidi, cull_x0);
+                 slot < bidi->count && bidi->slot_x[slot] <= cull_x1;
+                 slot += 1)
             {
-                f32 diff = fabsf(app_state.mouse_pos.x - pos_x + current_target_scroll_diff);
-                if (diff < mouse_best_distance)
+                Bidi_Run run = bidi->runs[bidi->visual[slot]];
+                b32 is_rtl = (run.level & 1);
+                f32 slot_x = origin_x + bidi->slot_x[slot];
+                s64 first = text_layout_first_after_byte(layout, run.start) - 1;
+                s64 last = text_layout_first_after_byte(layout, run.one_past_end) - 1;
+                f32 first_x = boundaries[first].x;
+                f32 last_x = boundaries[last].x;
+                
+                // clip rect in logical x of the run
+                f32 local_x0 = cull_x0 + origin_x - slot_x;
+                f32 local_x1 = cull_x1 + origin_x - slot_x;
+                f32 logical_x0 = (is_rtl ? last_x - local_x1 : first_x + local_x0);
+                f32 logical_x1 = (is_rtl ? last_x - local_x0 : first_x + local_x1);
+                s64 first_glyph = text_layout_last_at_or_before_x(layout, first, last + 1, logical_x0);
+                s64 one_past_last_glyph = get_min(text_layout_last_at_or_before_x(layout, first, last + 1, logical_x1) + 1, last);
+                
+                for (s64 boundary_index = first_glyph; boundary_index < one_past_last_glyph; boundary_index += 1)
                 {
-                    mouse_best_distance = diff;
-                    mouse_set_cursor_pos = byte_index;
+                    s64 byte_index = boundaries[boundary_index].byte_index;
+                    u64 size = (u64)(boundaries[boundary_index + 1].byte_index - byte_index);
+                    Unicode_Consume consume = utf8_consume(text->buffer.str + byte_index, size);
+                    
+                    f32 glyph_x = (is_rtl ?
+                                   slot_x + last_x - boundaries[boundary_index + 1].x :
+                                   slot_x + boundaries[boundary_index].x - first_x);
+                    u32 glyph_color = 0xff000513;
+                    render_codepoint(font, consume.codepoint, glyph_x, base_y, glyph_color);
                 }
             }
         }
-    };
-    
-    
-    
-    
-    
-    update_cursor();
-    
-    
-    
-    while (text_string.size)
-    {
-        Glyph glyph = {};
-        u32 consume_inc = 0;
-        u32 glyph_color = 0xff000513;
         
-        Unicode_Consume consume = utf8_consume(text_string);
-        consume_inc = consume.inc;
+        if (!text->buffer.size && placeholder.size) {
+            render_text_run(font, placeholder, origin_x, base_y, 0xff0a5588);
+        }
         
-        text_string = str_skip(text_string, consume.inc);
-        f32 glyph_advance = 0.f;
         
-        if (!update_scroll_x_and_skip_drawing)
+        if (text->cursor_pos >= visible_min && text->cursor_pos <= visible_max)
         {
-            glyph_advance = render_codepoint(font, consume.codepoint, pos_x, base_y, glyph_color);
+            render_text_input_rect(origin_x + caret_x(text->cursor_pos), cursor_y0,
+                                   cursor_w, cursor_h,
+                                   0.05f, 0.f, 0xffff'ffff, 0xffff'ffff);
         }
-        else
+        
+        for (u32 cursor_index = 0; cursor_index < text->cursor_count; cursor_index += 1)
         {
-            glyph_advance = get_glyph(font, consume.codepoint).advance;
+            Text_Cursor cursor = text->cursors[cursor_index];
+            if (cursor_index == text->primary_cursor_index ||
+                cursor.cursor_pos < visible_min) {
+                continue;
+            }
+            if (cursor.cursor_pos > visible_max) {
+                break;
+            }
+            
+            render_text_input_rect(origin_x + caret_x(cursor.cursor_pos), cursor_y0,
+                                   cursor_w, cursor_h,
+                                   0.05f, 0.f, 0xffaa'aaaa, 0xffaa'aaaa);
         }
         
-        pos_x += glyph_advance;
-        byte_index += consume_inc;
         
-        update_cursor();
-    }
-    
-    
-    
-    
-    if (!update_scroll_x_and_skip_drawing)
-    {
+        // selections - only ranges that overlap the visible bytes are visited
         ui_state.layer = 0;
-        if (selection_min != selection_max)
+        render_selection_range(layout, bidi, origin_x,
+                               get_min(text->cursor_pos, text->mark_pos),
+                               get_max(text->cursor_pos, text->mark_pos),
+                               cursor_y0, cursor_w, cursor_h, 0xff0000ff, 0xff000066);
+        
+        for (u32 cursor_index = 0; cursor_index < text->cursor_count; cursor_index += 1)
         {
-            f32 selection_width = selection_max - selection_min + cursor_w;
+            Text_Cursor cursor = text->cursors[cursor_index];
+            if (cursor_index == text->primary_cursor_index ||
+                text_cursor_max(cursor) < visible_min) {
+                continue;
+            }
+            if (text_cursor_min(cursor) > visible_max) {
+                break;
+            }
             
-            render_text_input_rect(selection_min, cursor_y0,
-                                   selection_width, cursor_h,
-                                   0.05f, 0.05f, 0xff0000ff, 0xff000066);
+            render_selection_range(layout, bidi, origin_x,
+                                   text_cursor_min(cursor), text_cursor_max(cursor),
+                                   cursor_y0, cursor_w, cursor_h, 0xff0000aa, 0xff000044);
+        }
+        
+        if (text->selections)
+        {
+            Text_Selection_Set *set = text->selections;
+            for (s64 range_index = selection_set_first_ending_after(set, visible_min);
+                 range_index < set->count && set->ranges[range_index].start <= visible_max;
+                 range_index += 1)
+            {
+                Text_Range range = set->ranges[range_index];
+                render_selection_range(layout, bidi, origin_x, range.start, range.one_past_end,
+                                       cursor_y0, cursor_w, cursor_h, 0xff006644, 0xff002211);
+            }
         }
         
         reset_clip_rect();
     }
     else
     {
+        f32 cursor_x = origin_x + caret_x(text->cursor_pos);
+        if (cursor_x + padding_x > text_x1)
+        {
+            text->target_scroll_x -= (cursor_x + padding_x - text_x1);
+        }
+        if (cursor_x - padding_x < text_rect.x)
+        {
+            text->target_scroll_x += (-cursor_x + padding_x + text_rect.x);
+        }
+        
+        
+        if (app_state.ui_active == text)
+        {
+            // glyphs are drawn with the current (animated) scroll
+            f32 mouse_x = app_state.mouse_pos.x - (text_rect.x + padding_x + text->current_scroll_x);
+            mouse_set_cursor_pos = (bidi ?
+                                    text_bidi_hit_test(bidi, layout, text->buffer, mouse_x) :
+                                    text_layout_hit_test(layout, mouse_x));
+        }
+        
+        
         if (text->target_scroll_x < 0)
         {
-            f32 empty_space_on_right_side = (text_x1 - padding_x) - pos_x;
+            f32 empty_space_on_right_side = (text_x1 - padding_x) - end_x;
             if (empty_space_on_right_side > 0)
             {
                 text->target_scroll_x += empty_space_on_right_side;
@@ -468,7 +718,7 @@ static void draw_text_input_inner(Text_Input *text, Font *font,
         }
         
         if (text->target_scroll_x > 0 &&
-            pos_x < (text_x1 - padding_x))
+            end_x < (text_x1 - padding_x))
         {
             text->target_scroll_x = 0;
         }
@@ -478,19 +728,15 @@ static void draw_text_input_inner(Text_Input *text, Font *font,
     }
     
     
-    if (mouse_set_cursor_pos >= 0)
-    {
-        text->cursor_pos = mouse_set_cursor_pos;
-        if (app_state.left_mouse_down_first_frame) {
-            text->mark_pos = text->cursor_pos;
-        }
+    if (mouse_set_cursor_pos >= 0) {
+        text_input_set_cursor_from_mouse(text, mouse_set_cursor_pos);
     }
 }
 
 
 
 static void draw_text_input(Text_Input *text, Font *font,
-                            Rect text_rect, f32 padding_x, f32 padding_y)
+                            Rect text_rect, f32 padding_x, f32 padding_y, String placeholder = {})
 {
     if (app_state.ui_active == text)
     {
@@ -499,28 +745,274 @@ static void draw_text_input(Text_Input *text, Font *font,
     
     if (text->is_dirty)
     {
-        draw_text_input_inner(text, font, text_rect, padding_x, padding_y, true);
+        draw_text_input_inner(text, font, text_rect, padding_x, padding_y, placeholder, true);
         text->is_dirty = false;
     }
     
-    draw_text_input_inner(text, font, text_rect, padding_x, padding_y, false);
+    draw_text_input_inner(text, font, text_rect, padding_x, padding_y, placeholder, false);
 }
 
 
 
+static void render_text_area_selection(Text_Input *text, f32 origin_x, f32 origin_y, f32 row_height,
+                                       s64 first_row, s64 one_past_last_row,
+                                       s64 min, s64 max, f32 cursor_w, f32 cursor_h,
+                                       u32 color, u32 border_color)
+{
+    // one rect per visible row that the selection touches
+    if (min >= max) {
+        return;
+    }
+    
+    Text_Wrap *wrap = text->wrap;
+    Text_Layout *layout = text->layout;
+    s64 row_a = get_max(first_row, text_wrap_row_from_pos(wrap, min));
+    s64 row_b = get_min(one_past_last_row - 1, text_wrap_row_from_pos(wrap, max));
+    
+    for (s64 row = row_a; row <= row_b; row += 1)
+    {
+        s64 row_start = wrap->row_starts[row];
+        s64 row_end = text_wrap_row_end(wrap, text->buffer, row);
+        s64 start = get_max(min, row_start);
+        s64 end = get_min(max, row_end);
+        
+        f32 row_x = text_layout_x_of(layout, row_start);
+        f32 x0 = origin_x + text_layout_x_of(layout, start) - row_x;
+        f32 x1 = origin_x + text_layout_x_of(layout, end) - row_x;
+        render_text_input_rect(x0, origin_y + (f32)row*row_height, x1 - x0 + cursor_w, cursor_h,
+                               0.05f, 0.05f, color, border_color);
+    }
+}
 
+static void draw_text_area(Text_Input *text, Font *font,
+                           Rect text_rect, f32 padding_x, f32 padding_y, String placeholder = {})
+{
+    // Multi-line version of draw_text_input - needs a line index, a layout and a wrap.
+    // Rows come from the word wrap & only the visible ones get drawn.
+    // @todo bidi - rows are drawn in logical order, reordering (L2) has to happen per row after wrapping.
+    Text_Layout *layout = text->layout;
+    Text_Wrap *wrap = text->wrap;
+    String buffer = text->buffer;
+    
+    f32 row_height = font->ascent - font->descent + font->line_gap;
+    f32 view_h = text_rect.h - 2.f*padding_y;
+    text_layout_update(layout, text, font);
+    text_wrap_update(text, get_max(text_rect.w - 2.f*padding_x, 1.f));
+    
+    
+    {
+        // keep the cursor row visible - same animation as in draw_text_input_inner
+        f32 cursor_top = (f32)text_wrap_row_from_pos(wrap, text->cursor_pos)*row_height;
+        if (cursor_top + row_height > text->target_scroll_y + view_h) {
+            text->target_scroll_y = cursor_top + row_height - view_h;
+        }
+        if (cursor_top < text->target_scroll_y) {
+            text->target_scroll_y = cursor_top;
+        }
+        
+        f32 max_scroll = get_max((f32)wrap->row_count*row_height - view_h, 0.f);
+        text->target_scroll_y = get_min(get_max(text->target_scroll_y, 0.f), max_scroll);
+        
+        f32 epsilon = 1.f;
+        f32 scroll_speed = (app_state.ui_active == text ? 10.f : 20.f);
+        f32 diff = text->target_scroll_y - text->current_scroll_y;
+        if (fabsf(diff) <= epsilon)
+        {
+            text->current_scroll_y = text->target_scroll_y;
+        }
+        else
+        {
+            text->current_scroll_y += diff * app_state.delta_t * scroll_speed;
+        }
+    }
+    
+    
+    f32 origin_x = text_rect.x + padding_x;
+    f32 origin_y = text_rect.y + padding_y - text->current_scroll_y; // top of the first row
+    
+    f32 cursor_h = font->ascent - font->descent;
+    f32 cursor_w = 2.f + cursor_h*0.05f;
+    
+    ui_state.layer = 0;
+    f32 border_share = 0.1f;
+    render_text_input_rect(text_rect, 0.2f*font->max_height/text_rect.h, border_share*font->max_height/text_rect.h,
+                           0xff11aaff, 0xff001122);
+    ui_state.layer = 1;
+    
+    f32 border = border_share*font->max_height*0.5f;
+    set_clip_rect(rect_contract(text_rect, border));
+    
+    
+    s64 first_row = (s64)(text->current_scroll_y / row_height);
+    first_row = get_min(get_max(first_row, 0), wrap->row_count - 1);
+    s64 one_past_last_row = (s64)((text->current_scroll_y + view_h) / row_height) + 2;
+    one_past_last_row = get_min(one_past_last_row, wrap->row_count);
+    
+    Text_Layout_Boundary *boundaries = layout->boundaries;
+    for (s64 row = first_row; row < one_past_last_row; row += 1)
+    {
+        s64 first = text_layout_first_after_byte(layout, wrap->row_starts[row]) - 1;
+        s64 last = text_layout_first_after_byte(layout, text_wrap_row_end(wrap, buffer, row)) - 1;
+        f32 row_x = origin_x - boundaries[first].x;
+        f32 base_y = origin_y + (f32)row*row_height + font->ascent;
+        
+        for (s64 boundary_index = first; boundary_index < last; boundary_index += 1)
+        {
+            s64 byte_index = boundaries[boundary_index].byte_index;
+            u64 size = (u64)(boundaries[boundary_index + 1].byte_index - byte_index);
+            Unicode_Consume consume = utf8_consume(buffer.str + byte_index, size);
+            
+            u32 glyph_color = 0xff000513;
+            render_codepoint(font, consume.codepoint, row_x + boundaries[boundary_index].x, base_y, glyph_color);
+        }
+    }
+    
+    if (!buffer.size && placeholder.size) {
+        render_text_run(font, placeholder, origin_x, origin_y + font->ascent, 0xff0a5588);
+    }
+    
+    
+    auto render_cursor = [&](s64 pos, u32 color) {
+        s64 row = text_wrap_row_from_pos(wrap, pos);
+        if (row >= first_row && row < one_past_last_row)
+        {
+            f32 x = text_layout_x_of(layout, pos) - text_layout_x_of(layout, wrap->row_starts[row]);
+            render_text_input_rect(origin_x + x, origin_y + (f32)row*row_height, cursor_w, cursor_h,
+                                   0.05f, 0.f, color, color);
+        }
+    };
+    
+    render_cursor(text->cursor_pos, 0xffff'ffff);
+    for (u32 cursor_index = 0; cursor_index < text->cursor_count; cursor_index += 1)
+    {
+        if (cursor_index != text->primary_cursor_index) {
+            render_cursor(text->cursors[cursor_index].cursor_pos, 0xffaa'aaaa);
+        }
+    }
+    
+    
+    // selections - only ranges that overlap the visible rows are visited
+    ui_state.layer = 0;
+    s64 visible_min = wrap->row_starts[first_row];
+    s64 visible_max = text_wrap_row_end(wrap, buffer, one_past_last_row - 1);
+    
+    render_text_area_selection(text, origin_x, origin_y, row_height, first_row, one_past_last_row,
+                               get_min(text->cursor_pos, text->mark_pos),
+                               get_max(text->cursor_pos, text->mark_pos),
+                               cursor_w, cursor_h, 0xff0000ff, 0xff000066);
+    
+    for (u32 cursor_index = 0; cursor_index < text->cursor_count; cursor_index += 1)
+    {
+        Text_Cursor cursor = text->cursors[cursor_index];
+        if (cursor_index == text->primary_cursor_index ||
+            text_cursor_max(cursor) < visible_min) {
+            continue;
+        }
+        if (text_cursor_min(cursor) > visible_max) {
+            break;
+        }
+        
+        render_text_area_selection(text, origin_x, origin_y, row_height, first_row, one_past_last_row,
+                                   text_cursor_min(cursor), text_cursor_max(cursor),
+                                   cursor_w, cursor_h, 0xff0000aa, 0xff000044);
+    }
+    
+    if (text->selections)
+    {
+        Text_Selection_Set *set = text->selections;
+        for (s64 range_index = selection_set_first_ending_after(set, visible_min);
+             range_index < set->count && set->ranges[range_index].start <= visible_max;
+             range_index += 1)
+        {
+            Text_Range range = set->ranges[range_index];
+            render_text_area_selection(text, origin_x, origin_y, row_height, first_row, one_past_last_row,
+                                       range.start, range.one_past_end,
+                                       cursor_w, cursor_h, 0xff006644, 0xff002211);
+        }
+    }
+    
+    reset_clip_rect();
+    
+    
+    if (app_state.ui_active == text)
+    {
+        s64 pos = text_wrap_hit_test(wrap, layout, buffer,
+                                     app_state.mouse_pos.x - origin_x,
+                                     app_state.mouse_pos.y - origin_y, row_height);
+        text_input_set_cursor_from_mouse(text, pos);
+    }
+}
 
+static b32 text_input_move_visually(Text_Input *text, Font *font, s64 dir, b32 select)
+{
+    // Left/right arrows in text with right to left runs - cursor moves on the screen, not in the buffer.
+    // Returns false for left to right text - text_input_handle_key moves the cursor then.
+    Text_Bidi *bidi = text->bidi;
+    if (!bidi) {
+        return false;
+    }
+    text_layout_update(text->layout, text, font);
+    text_bidi_update(text);
+    if (!bidi->has_rtl) {
+        return false;
+    }
+    
+    text_input_clear_additional_cursors(text);
+    text->is_dirty = true;
+    if (!select && text->cursor_pos != text->mark_pos)
+    {
+        // selection collapses to its edge on the side of the arrow
+        f32 cursor_x = text_bidi_x_of(bidi, text->layout, text->cursor_pos);
+        f32 mark_x = text_bidi_x_of(bidi, text->layout, text->mark_pos);
+        if ((mark_x < cursor_x) == (dir < 0)) {
+            text->cursor_pos = text->mark_pos;
+        }
+        text->mark_pos = text->cursor_pos;
+        return true;
+    }
+    
+    text->cursor_pos = text_bidi_move_visually(bidi, text->layout, text->buffer, text->cursor_pos, dir);
+    if (!select) {
+        text->mark_pos = text->cursor_pos;
+    }
+    return true;
+}
 
-int WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nShowCmd)
+static void text_area_move_vertically(Text_Input *text, Font *font, s64 dir, b32 select)
 {
-    run_string_unit_tests();
-    run_utf8_unit_tests();
-    run_text_input_unit_tests();
+    // Up/down arrows - cursor keeps its x and moves to the row above/below.
+    Text_Wrap *wrap = text->wrap;
+    if (!wrap->max_width) {
+        return; // wasn't drawn yet
+    }
+    text_layout_update(text->layout, text, font);
+    text_wrap_update(text, wrap->max_width);
     
+    text_input_clear_additional_cursors(text);
+    s64 row = text_wrap_row_from_pos(wrap, text->cursor_pos);
+    f32 x = text_layout_x_of(text->layout, text->cursor_pos) - text_layout_x_of(text->layout, wrap->row_starts[row]);
     
+    text->cursor_pos = text_wrap_pos_in_row(wrap, text->layout, text->buffer, row + dir, x);
+    if (!select) {
+        text->mark_pos = text->cursor_pos;
+    }
+}
+
+
+
+
+
+
+static DWORD WINAPI input_thread_procedure(void *parameter)
+{
+    // Window messages go to the thread that created the window - so this thread creates it
+    //   and from then on only pumps messages. Input gets captured even when the frame loop
+    //   waits for vsync.
+    HINSTANCE hInstance = (HINSTANCE)parameter;
     
     WNDCLASSEXW window_class = {};
     window_class.cbSize = sizeof(window_class);
+    window_class.style = CS_DBLCLKS;
     window_class.lpfnWndProc = &window_procedure;
     window_class.hInstance = hInstance;
     window_class.hCursor = LoadCursorA(0, IDC_ARROW);
@@ -533,6 +1025,58 @@ int WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int n
     app_state.window = CreateWindowExW(0, window_class.lpszClassName, L"Text Input",
                                        window_style, CW_USEDEFAULT, CW_USEDEFAULT,
                                        CW_USEDEFAULT, CW_USEDEFAULT, 0, 0, hInstance, nullptr);
+    SetEvent(app_state.window_created);
+    
+    for (;;)
+    {
+        // Events that didn't fit in the ring wait in its overflow array -
+        //   in that case check every millisecond if the frame loop made some space.
+        DWORD timeout = (app_state.input_ring.overflow_count ? 1 : INFINITE);
+        MsgWaitForMultipleObjects(0, nullptr, FALSE, timeout, QS_ALLINPUT);
+        input_ring_flush_overflow(&app_state.input_ring);
+        
+        MSG msg;
+        while (PeekMessageW(&msg, 0, 0, 0, PM_REMOVE))
+        {
+            TranslateMessage(&msg);
+            DispatchMessageW(&msg);
+        }
+    }
+}
+
+
+
+int WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nShowCmd)
+{
+    run_string_unit_tests();
+    run_utf8_unit_tests();
+    run_text_input_unit_tests();
+    run_regex_unit_tests();
+    run_input_unit_tests();
+    run_atlas_unit_tests();
+    
+    
+    
+    {
+        // "-record <path>" saves all input events (format in app_input.h) - see replay.cpp
+        String command_line = cstr_to_string(lpCmdLine);
+        String record_flag = "-record "_f0;
+        if (command_line.size > record_flag.size &&
+            str_equals(str_prefix(command_line, record_flag.size), record_flag))
+        {
+            char *path = lpCmdLine + record_flag.size;
+            FILE *file = fopen(path, "wb");
+            assert_and_throw_message(file != nullptr, "Failed to open the input recording file");
+            
+            app_state.input_recorder_start_time = time_perf();
+            input_recorder_begin(&app_state.input_recorder, file, 0);
+        }
+    }
+    
+    app_state.window_created = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    HANDLE input_thread = CreateThread(nullptr, 0, input_thread_procedure, hInstance, 0, nullptr);
+    assert_and_throw_message(input_thread != nullptr, "Failed to create the input thread");
+    WaitForSingleObject(app_state.window_created, INFINITE);
     
     
     initialize_d3d11_graphics(app_state.window);
@@ -569,20 +1113,91 @@ int WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int n
     
     Font *font = (Font *)VirtualAlloc(0, sizeof(Font), MEM_COMMIT|MEM_RESERVE, PAGE_READWRITE);
     initialize_font(font, font_data, 160.f);
+    initialize_text_run_cache(&app_state.text_runs, 256, 64*1024);
     
     
-    ui_state.constants.atlas_width_inv = 1.f / TEXTURE_WIDTH;
-    ui_state.constants.atlas_height_inv = 1.f / TEXTURE_HEIGHT;
     
     
     
     
     
     u8 text_input_memory[32];
+    Text_Cursor text_input_cursors[16];
     Text_Input text_input = {};
     text_input.buffer = {
         text_input_memory, 0, array_count(text_input_memory)
     };
+    text_input.cursors = text_input_cursors;
+    text_input.cursor_cap = array_count(text_input_cursors);
+    
+    u64 text_input_word_bits[3][(array_count(text_input_memory) + 64)/64];
+    Text_Word_Cache text_input_words = {
+        text_input_word_bits[0], text_input_word_bits[1], text_input_word_bits[2],
+        array_count(text_input_word_bits[0])
+    };
+    text_input_attach_word_cache(&text_input, &text_input_words);
+    
+    Text_Range text_input_selection_ranges[64];
+    Text_Selection_Set text_input_selections = {
+        text_input_selection_ranges, 0, array_count(text_input_selection_ranges)
+    };
+    text_input.selections = &text_input_selections;
+    
+    Text_Layout_Boundary text_input_layout_boundaries[array_count(text_input_memory) + 1];
+    Text_Layout text_input_layout = {
+        text_input_layout_boundaries, 0, array_count(text_input_layout_boundaries)
+    };
+    text_input.layout = &text_input_layout;
+    
+    Bidi_Run text_input_bidi_runs[array_count(text_input_memory)];
+    s64 text_input_bidi_visual[array_count(text_input_memory)];
+    s64 text_input_bidi_slot_of_run[array_count(text_input_memory)];
+    f32 text_input_bidi_slot_x[array_count(text_input_memory)];
+    u8 text_input_bidi_scratch[3*array_count(text_input_memory)];
+    Text_Bidi text_input_bidi = {
+        text_input_bidi_runs, text_input_bidi_visual, text_input_bidi_slot_of_run, text_input_bidi_slot_x,
+        0, array_count(text_input_bidi_runs), text_input_bidi_scratch
+    };
+    text_input.bidi = &text_input_bidi;
+    app_state.ui_focused = &text_input;
+    
+    
+    // multi-line text area
+    u8 text_area_memory[1024];
+    Text_Cursor text_area_cursors[16];
+    Text_Input text_area = {};
+    text_area.buffer = {
+        text_area_memory, 0, array_count(text_area_memory)
+    };
+    text_area.cursors = text_area_cursors;
+    text_area.cursor_cap = array_count(text_area_cursors);
+    
+    s64 text_area_line_starts[array_count(text_area_memory) + 1];
+    Text_Line_Index text_area_lines = {
+        text_area_line_starts, 0, array_count(text_area_line_starts)
+    };
+    text_input_attach_line_index(&text_area, &text_area_lines);
+    
+    u64 text_area_word_bits[3][(array_count(text_area_memory) + 64)/64];
+    Text_Word_Cache text_area_words = {
+        text_area_word_bits[0], text_area_word_bits[1], text_area_word_bits[2],
+        array_count(text_area_word_bits[0])
+    };
+    text_input_attach_word_cache(&text_area, &text_area_words);
+    
+    Text_Layout_Boundary text_area_layout_boundaries[array_count(text_area_memory) + 1];
+    Text_Layout text_area_layout = {
+        text_area_layout_boundaries, 0, array_count(text_area_layout_boundaries)
+    };
+    text_area.layout = &text_area_layout;
+    
+    s64 text_area_row_starts[array_count(text_area_memory) + 1];
+    Text_Wrap text_area_wrap = {
+        text_area_row_starts, 0, array_count(text_area_row_starts)
+    };
+    text_area.wrap = &text_area_wrap;
+    
+    static u8 paste_memory[64*1024]; // clipboard text converted to utf8 - cleaned up by text_input_paste
     
     
     app_state.last_frame_time = time_perf();
@@ -592,19 +1207,9 @@ int WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int n
     {
         frame_number += 1;
         start_frame_for_ui_state();
-        app_state.input_event_count = 0;
         app_state.left_mouse_down_first_frame = false;
         
         {
-            app_state.input_event_count = 0;
-            
-            MSG msg;
-            while (PeekMessageW(&msg, 0, 0, 0, PM_REMOVE))
-            {
-                TranslateMessage(&msg);
-                DispatchMessageW(&msg);
-            }
-            
             POINT mouse_point;
             GetCursorPos(&mouse_point);
             ScreenToClient(app_state.window, &mouse_point);
@@ -613,7 +1218,8 @@ int WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int n
                 (f32)mouse_point.y
             };
             
-            app_state.left_mouse_down = !!(GetKeyState(VK_LBUTTON) & (1 << 15));
+            // GetKeyState would only see messages of this thread
+            app_state.left_mouse_down = !!(GetAsyncKeyState(VK_LBUTTON) & (1 << 15));
         }
         
         {
@@ -657,76 +1263,90 @@ int WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int n
         text_input_rect.w = font->max_height*5.f + 2.f*text_padding_x;
         text_input_rect.h = font->max_height + 2.f*text_padding_y;
         text_input_rect.x = screen_width*0.5f - text_input_rect.w*0.5f;
-        text_input_rect.y = screen_height*0.5f - text_input_rect.h*0.5f;
+        text_input_rect.y = screen_height*0.3f - text_input_rect.h*0.5f;
+        
+        Rect text_area_rect = text_input_rect;
+        text_area_rect.y += text_input_rect.h + text_padding_y*2.f;
+        text_area_rect.h = get_max(screen_height - text_area_rect.y - text_padding_y*2.f, text_input_rect.h);
+        
         
         
         
+        Typed_Text typed_text = {};
         
-        for (u64 input_index = 0; input_index < app_state.input_event_count; input_index += 1)
+        Input_Event event;
+        while (input_ring_pop(&app_state.input_ring, &event))
         {
-            Input_Event event = app_state.input_events[input_index];
+            Text_Input *focused = app_state.ui_focused;
+            if (event.vk_code == 0)
+            {
+                typed_text_add(&typed_text, focused, event);
+                continue;
+            }
+            
+            typed_text_flush(&typed_text, focused);
+            if ((event.vk_code == VK_LEFT || event.vk_code == VK_RIGHT) && !event.control &&
+                text_input_move_visually(focused, font, (event.vk_code == VK_LEFT ? -1 : 1), event.shift)) {
+                continue;
+            }
+            if (text_input_handle_key(focused, event)) {
+                continue;
+            }
             
             switch (event.vk_code)
             {
-                case 0: {
-                    String new_text = cstr_to_string(event.cstr);
-                    text_input_write(&text_input, new_text);
-                } break;
-                
-                case VK_BACK:
-                case VK_DELETE: {
-                    s64 dir = (event.vk_code == VK_BACK ? -1 : 1);
-                    u32 flags = TextInputMove_Select;
-                    if (event.control) { flags |= TextInputMove_ByWords; }
+                case VK_LBUTTON: {
+                    app_state.left_mouse_down_first_frame = !event.released;
+                    if (!event.released) {
+                        app_state.left_mouse_double_click = event.double_click;
+                    }
                     
-                    if (!text_input_has_selection(&text_input)) {
-                        text_input_move_cursor(&text_input, dir, flags);
+                    app_state.ui_active = nullptr;
+                    if (!event.released)
+                    {
+                        if (v2_in_rect(text_input_rect, app_state.mouse_pos)) {
+                            app_state.ui_active = app_state.ui_focused = &text_input;
+                        } else if (v2_in_rect(text_area_rect, app_state.mouse_pos)) {
+                            app_state.ui_active = app_state.ui_focused = &text_area;
+                        }
+                        app_state.left_mouse_down_with_alt = event.alt;
+                        app_state.left_mouse_down_with_control = event.control;
                     }
-                    text_input_write(&text_input, ""_f0);
-                } break;
-                
-                case VK_LEFT:
-                case VK_RIGHT: {
-                    s64 dir = (event.vk_code == VK_LEFT ? -1 : 1);
-                    u32 flags = 0;
-                    if (event.shift) { flags |= TextInputMove_Select; }
-                    if (event.control) { flags |= TextInputMove_ByWords; }
-                    text_input_move_cursor(&text_input, dir, flags);
                 } break;
                 
-                case VK_HOME:
-                case VK_END: {
-                    s64 dir = (event.vk_code == VK_HOME ? -1 : 1);
-                    u32 flags = TextInputMove_ByMax;
-                    if (event.shift) { flags |= TextInputMove_Select; }
-                    text_input_move_cursor(&text_input, dir, flags);
+                case 'V': {
+                    if (event.control && !event.alt)
+                    {
+                        String clipboard = get_clipboard_text(paste_memory, array_count(paste_memory));
+                        text_input_paste(focused, clipboard, focused->wrap != nullptr);
+                    }
                 } break;
                 
-                case VK_LBUTTON: {
-                    if (!event.released && v2_in_rect(text_input_rect, app_state.mouse_pos)) {
-                        app_state.ui_active = &text_input;
-                    } else {
-                        app_state.ui_active = nullptr;
+                case VK_RETURN: {
+                    if (focused->wrap) {
+                        text_input_write(focused, "\n"_f0);
                     }
                 } break;
                 
-                case 'A': {
-                    if (event.control && !event.alt)
-                    {
-                        text_input_move_cursor(&text_input, -1, TextInputMove_ByMax);
-                        text_input_move_cursor(&text_input, 1, TextInputMove_ByMax | TextInputMove_Select);
+                case VK_UP:
+                case VK_DOWN: {
+                    if (focused->wrap) {
+                        text_area_move_vertically(focused, font, (event.vk_code == VK_UP ? -1 : 1), event.shift);
                     }
                 } break;
             }
         }
         
+        typed_text_flush(&typed_text, app_state.ui_focused);
+        
         if (!app_state.left_mouse_down) {
             app_state.ui_active = nullptr;
         }
         
         
         
-        draw_text_input(&text_input, font, text_input_rect, text_padding_x, text_padding_y);
+        draw_text_input(&text_input, font, text_input_rect, text_padding_x, text_padding_y, "Single line"_f0);
+        draw_text_area(&text_area, font, text_area_rect, text_padding_x, text_padding_y, "Multiple lines"_f0);
         
         
         
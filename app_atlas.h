@@ -0,0 +1,134 @@
+//
+// Atlas_Skyline
+//
+// Rectangle packer for the glyph texture (bottom-left skyline).
+// Skyline is a list of nodes from left to right that covers the whole width of the packed area -
+//   y of a node is the first free row above it. A new rectangle goes where its bottom edge ends up lowest,
+//   the narrowest node wins ties so wide gaps are kept for wide rectangles.
+// Rectangles can't be freed one by one - the whole skyline gets reset (or restored from a copy).
+//
+
+#define Atlas_MaxSkylineNodes 512
+
+struct Atlas_Skyline_Node
+{
+    u16 x, y, width;
+};
+
+struct Atlas_Skyline
+{
+    u16 x0, y0, width, height; // packed area of the texture
+    u32 node_count;
+    Atlas_Skyline_Node nodes[Atlas_MaxSkylineNodes];
+};
+
+
+static void atlas_skyline_reset(Atlas_Skyline *skyline, u16 x0, u16 y0, u16 width, u16 height)
+{
+    skyline->x0 = x0;
+    skyline->y0 = y0;
+    skyline->width = width;
+    skyline->height = height;
+    skyline->node_count = 1;
+    skyline->nodes[0] = {x0, y0, width};
+}
+
+static s32 atlas_skyline_fit(Atlas_Skyline *skyline, u32 node_index, u16 width, u16 height)
+{
+    // Returns y of a rectangle placed at the left edge of the node or -1 if it doesn't fit.
+    Atlas_Skyline_Node *nodes = skyline->nodes;
+    u32 x = nodes[node_index].x;
+    if (x + width > (u32)skyline->x0 + skyline->width) {
+        return -1;
+    }
+    
+    u32 y = 0;
+    for (u32 width_left = width; width_left > 0; node_index += 1)
+    {
+        assert(node_index < skyline->node_count);
+        y = get_max(y, (u32)nodes[node_index].y);
+        if (y + height > (u32)skyline->y0 + skyline->height) {
+            return -1;
+        }
+        width_left -= get_min(width_left, (u32)nodes[node_index].width);
+    }
+    return (s32)y;
+}
+
+static b32 atlas_skyline_pack(Atlas_Skyline *skyline, u16 width, u16 height, u16 *out_x, u16 *out_y)
+{
+    // Returns false if there is no space left for the rectangle.
+    assert(width > 0 && height > 0);
+    
+    u32 best_index = 0xFFFFFFFFu;
+    u32 best_bottom = 0xFFFFFFFFu;
+    u32 best_node_width = 0xFFFFFFFFu;
+    for (u32 node_index = 0; node_index < skyline->node_count; node_index += 1)
+    {
+        s32 y = atlas_skyline_fit(skyline, node_index, width, height);
+        if (y < 0) {
+            continue;
+        }
+        
+        u32 bottom = (u32)y + height;
+        u32 node_width = skyline->nodes[node_index].width;
+        if (bottom < best_bottom ||
+            (bottom == best_bottom && node_width < best_node_width))
+        {
+            best_index = node_index;
+            best_bottom = bottom;
+            best_node_width = node_width;
+        }
+    }
+    
+    if (best_index == 0xFFFFFFFFu || skyline->node_count == Atlas_MaxSkylineNodes) {
+        return false;
+    }
+    
+    
+    // new node over the rectangle - nodes under it get cut or removed
+    Atlas_Skyline_Node *nodes = skyline->nodes;
+    Atlas_Skyline_Node node = {nodes[best_index].x, (u16)best_bottom, width};
+    *out_x = node.x;
+    *out_y = (u16)(best_bottom - height);
+    
+    memmove(nodes + best_index + 1, nodes + best_index, (skyline->node_count - best_index)*sizeof(*nodes));
+    nodes[best_index] = node;
+    skyline->node_count += 1;
+    
+    u32 node_x1 = (u32)node.x + node.width;
+    u32 next = best_index + 1;
+    while (next < skyline->node_count && nodes[next].x < node_x1)
+    {
+        u32 next_x1 = (u32)nodes[next].x + nodes[next].width;
+        if (next_x1 <= node_x1)
+        {
+            memmove(nodes + next, nodes + next + 1, (skyline->node_count - next - 1)*sizeof(*nodes));
+            skyline->node_count -= 1;
+        }
+        else
+        {
+            nodes[next].width = (u16)(next_x1 - node_x1);
+            nodes[next].x = (u16)node_x1;
+            break;
+        }
+    }
+    
+    // neighbours at the same height become one node
+    for (u32 index = (best_index ? best_index - 1 : 0); index + 1 < skyline->node_count && index <= best_index;)
+    {
+        if (nodes[index].y == nodes[index + 1].y)
+        {
+            nodes[index].width += nodes[index + 1].width;
+            memmove(nodes + index + 1, nodes + index + 2, (skyline->node_count - index - 2)*sizeof(*nodes));
+            skyline->node_count -= 1;
+            best_index -= (index < best_index ? 1 : 0);
+        }
+        else
+        {
+            index += 1;
+        }
+    }
+    
+    return true;
+}
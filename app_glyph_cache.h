@@ -14,24 +14,48 @@ struct Glyph
     s16 offset_x, offset_y;
     f32 advance;
     Glyph_Status status;
-    u8 additional_segment_count;
+    u8 atlas_page; // index into Font::atlas_pages
+    u16 stb_index; // glyph index in the font file - used for kerning
     
     // The hash is equal to the codepoint value of the glyph.
     // This means that we do not support glyphs that are produced out of multiple connected codepoints.
     // Unicode in theory supports glyphs that can be made out of billions of codepoints
     //   for Arabic and other languages where the codepoints can connect to create one wide glyph.
     // Another example would be color skin modifiers for emojis.
-    u32 hash; // only bottom 21 bits are used
+    // Bits above the codepoint hold the subpixel phase (<< Glyph_SubpixelShift).
+    u32 hash;
     
     u16 next_in_collision;
     u16 next_in_lru;
     u16 prev_in_lru;
 };
 
+struct Glyph_Metrics
+{
+    // Everything needed for measuring & layout - filled without rasterizing the glyph.
+    f32 advance;
+    s16 offset_x, offset_y;
+    u16 width, height;
+    u16 stb_index;
+};
+
+#define Glyph_SubpixelShift 21
+#define Glyph_MaxSubpixelPhases 8
+
 #define Font_AsciiBlock_Start (' ')
 #define FontAsciiBlock_OnePastLast ('~')
 #define Font_AsciiBlock_Count (FontAsciiBlock_OnePastLast - Font_AsciiBlock_Start)
 
+#define Font_MaxAtlasPages 8
+
+struct Font_Atlas_Page
+{
+    Atlas_Skyline skyline;
+    u32 texture_page; // band of TEXTURE_HEIGHT rows in the glyph texture
+    u64 last_use; // Font::atlas_use_clock when a glyph from this page was last used - see touch_glyph_slot
+    u32 text_run_count; // cached text runs with glyphs on this page - see app_text_run_cache.h
+};
+
 struct Font
 {
     unsigned char *font_file_data;
@@ -40,11 +64,26 @@ struct Font
     f32 ascent, descent, line_gap;
     f32 space_width;
     
+    // Glyphs are rasterized at subpixel_phase_count horizontal offsets (1 = snapped to whole pixels).
+    // Phase 0 of printable ASCII lives in the ascii block, other phases go through the glyph cache.
+    u32 subpixel_phase_count;
+    u8 *glyph_bitmap; // rasterization scratch - glyph_bitmap_size bytes
+    u32 glyph_bitmap_size;
+    
     //u16 max_width, max_height;
     //u16 max_ascii_width, max_ascii_height;
     u16 max_ascii_width, max_height;
     
-    u16 tex_x, tex_y;
+    // Every glyph gets an exact-sized rectangle on one of the atlas pages. Pages are taken from the
+    //   glyph texture on demand (d3d11_allocate_glyph_texture_page) up to Font_MaxAtlasPages.
+    // The ascii block is packed first on page 0 - atlas_after_ascii is a copy of its skyline from that moment.
+    // Space of glyphs evicted from the cache isn't reused - once a glyph doesn't fit on any page and
+    //   no page can be added, the least recently used page is emptied at once (ascii block stays).
+    //   Pages that cached text runs point into are skipped unless all of them are.
+    u32 atlas_page_count;
+    Font_Atlas_Page atlas_pages[Font_MaxAtlasPages];
+    Atlas_Skyline atlas_after_ascii;
+    u64 atlas_use_clock;
     
     Glyph ascii_block[Font_AsciiBlock_Count];
     
@@ -54,6 +93,22 @@ struct Font
     u32 hash_table_count;
     u32 hash_table_key_mask;
     u16 *hash_table;
+    u32 glyph_evict_count; // incremented every time a loaded glyph leaves the cache - see app_text_run_cache.h
+    
+    // Kerning pairs - open addressing hash table with linear probing.
+    // Key is (left stb_index << 16 | right stb_index), 0 marks an empty slot. Values are in font units.
+    // Fonts with a 'kern' table get all pairs loaded up front - a miss means no kerning.
+    // GPOS kerning can't be listed by stb_truetype so it's looked up on a miss and stored (kern_lazy).
+    u32 *kern_keys;
+    s16 *kern_values;
+    u32 kern_table_count, kern_key_mask, kern_used_count;
+    b32 kern_lazy;
+    
+    // Glyph metrics - same kind of hash table as kerning, key is (codepoint + 1).
+    // Filled on a miss from hmtx & cmap data - it's cleared when it gets 3/4 full.
+    u32 *metrics_keys;
+    Glyph_Metrics *metrics_values;
+    u32 metrics_table_count, metrics_key_mask, metrics_used_count;
 };
 
 
@@ -64,7 +119,8 @@ static void clear_glyph_font_data(Glyph *glyph)
     glyph->offset_x = glyph->offset_y = 0;
     glyph->advance = 0;
     glyph->status = {};
-    glyph->additional_segment_count = 0;
+    glyph->atlas_page = 0;
+    glyph->stb_index = 0;
     glyph->hash = 0;
 }
 
@@ -85,18 +141,17 @@ static int get_stb_index_for_glyph(Font *font, u32 codepoint_hash)
 }
 
 
+static b32 pack_glyph_in_atlas(Font *font, Glyph *glyph, b32 is_ascii_block);
+
 static void initialize_glyph(Glyph *glyph, Font *font,
                              u32 codepoint_hash, int stb_glyph_index,
-                             b32 increment_texture_position = false)
+                             b32 is_ascii_block = false)
 {
     clear_glyph_font_data(glyph);
-    glyph->hash = codepoint_hash;
     
     u32 codepoint = codepoint_hash & Bitmask_21;
-    u32 horizontal_shift = codepoint_hash >> 21;
+    f32 subpixel_x = (f32)(codepoint_hash >> Glyph_SubpixelShift) / (f32)font->subpixel_phase_count;
     
-    // @todo Use this: stbtt_MakeCodepointBitmap() -- renders into bitmap provided by the user
-    // Currently it uses malloc inside stb_truetype.h
     stbtt_fontinfo *info = &font->stb_info;
     if (stb_glyph_index <= 0) {
         stb_glyph_index = get_stb_index_for_glyph(font, codepoint_hash);
@@ -105,14 +160,16 @@ static void initialize_glyph(Glyph *glyph, Font *font,
     
     if (stb_glyph_index > 0)
     {
-        s32 width, height, offset_x, offset_y;
-        u8 *mono_bitmap = stbtt_GetGlyphBitmapSubpixel(info, 0, font->font_scale,
-                                                       0.f, 0.f, // subpixel position
-                                                       stb_glyph_index,
-                                                       &width, &height, &offset_x, &offset_y);
+        glyph->stb_index = (u16)stb_glyph_index;
         
-        glyph->offset_x = (s16)offset_x;
-        glyph->offset_y = (s16)offset_y;
+        s32 x0, y0, x1, y1;
+        stbtt_GetGlyphBitmapBoxSubpixel(info, stb_glyph_index, font->font_scale, font->font_scale,
+                                        subpixel_x, 0.f, &x0, &y0, &x1, &y1);
+        s32 width = x1 - x0;
+        s32 height = y1 - y0;
+        
+        glyph->offset_x = (s16)x0;
+        glyph->offset_y = (s16)y0;
         glyph->width = (u16)width;
         glyph->height = (u16)height;
         
@@ -121,31 +178,23 @@ static void initialize_glyph(Glyph *glyph, Font *font,
         glyph->advance = (f32)advance * font->font_scale;
         
         
-        if (mono_bitmap && width > 0 &&
-            height > 0 && height < font->max_height)
+        b32 has_bitmap = (width > 0 && height > 0 && height < font->max_height &&
+                          (u32)(width*height) <= font->glyph_bitmap_size);
+        if (has_bitmap) {
+            has_bitmap = pack_glyph_in_atlas(font, glyph, is_ascii_block);
+        }
+        
+        
+        if (has_bitmap)
         {
             glyph->status = Glyph_Loaded;
             s32 pitch = width;
-            u8 *bitmap = mono_bitmap;
-            
-            if (increment_texture_position)
-            {
-                glyph->tex_x = font->tex_x;
-                glyph->tex_y = font->tex_y;
-                font->tex_x += (u16)width;
-            }
-            else
-            {
-                glyph->additional_segment_count = (u8)((glyph->width + font->max_ascii_width - 1) / font->max_ascii_width) - 1;
-                
-                u32 width_left = (width - font->max_ascii_width*horizontal_shift);
-                glyph->width = (u16)get_min(width_left, font->max_ascii_width);
-                
-                u32 horizontal_offset = font->max_ascii_width * horizontal_shift;
-                bitmap += horizontal_offset;
-            }
+            u8 *bitmap = font->glyph_bitmap;
+            stbtt_MakeGlyphBitmapSubpixel(info, bitmap, width, height, pitch,
+                                          font->font_scale, font->font_scale, subpixel_x, 0.f,
+                                          stb_glyph_index);
             
-            d3d11_update_glyph_texture(glyph->tex_x, glyph->tex_y, glyph->width, height, pitch, bitmap);
+            d3d11_update_glyph_texture(glyph->tex_x, glyph->tex_y, glyph->width, glyph->height, pitch, bitmap);
         }
         else if (glyph->advance != 0)
         {
@@ -156,28 +205,380 @@ static void initialize_glyph(Glyph *glyph, Font *font,
             glyph->status = Glyph_Invalid;
             assert(0);
         }
+    }
+    else
+    {
+        glyph->status = Glyph_Invalid;
+    }
+    
+    // set last - evict_atlas_page clears glyphs with a hash
+    glyph->hash = codepoint_hash;
+}
+
+
+
+//
+// Kerning
+//
+
+static u32 hash_u32(u32 key)
+{
+    u32 hash = key * 0x9E3779B1u;
+    hash ^= hash >> 15;
+    hash *= 0x85EBCA77u;
+    hash ^= hash >> 13;
+    return hash;
+}
+
+static u32 get_kerning_slot(Font *font, u32 key)
+{
+    // slot with the key or the first empty slot on its probe sequence
+    u32 slot = hash_u32(key) & font->kern_key_mask;
+    
+    while (font->kern_keys[slot] && font->kern_keys[slot] != key)
+    {
+        slot = (slot + 1) & font->kern_key_mask;
+    }
+    return slot;
+}
+
+static b32 insert_kerning_pair(Font *font, u32 key, s16 value)
+{
+    // keeps at least 1/4 of the slots empty so probe sequences stay short
+    if (4*(font->kern_used_count + 1) > 3*font->kern_table_count) {
+        return false;
+    }
+    
+    u32 slot = get_kerning_slot(font, key);
+    if (!font->kern_keys[slot])
+    {
+        font->kern_keys[slot] = key;
+        font->kern_used_count += 1;
+    }
+    font->kern_values[slot] = value;
+    return true;
+}
+
+static void initialize_font_kerning(Font *font)
+{
+    stbtt_fontinfo *info = &font->stb_info;
+    
+    // stbtt_GetGlyphKernAdvance prefers GPOS over 'kern' - same here
+    s32 pair_count = (info->gpos ? 0 : stbtt_GetKerningTableLength(info));
+    font->kern_lazy = (info->gpos != 0);
+    if (!pair_count && !font->kern_lazy) {
+        return;
+    }
+    
+    u32 wanted_count = (font->kern_lazy ? 32*1024 : (u32)pair_count*2);
+    Bit_Scan_Result msb = find_most_significant_bit(get_max(wanted_count, 16u));
+    font->kern_table_count = (1u << (msb.index + 1));
+    font->kern_key_mask = font->kern_table_count - 1;
+    
+    u64 total_size = (sizeof(u32) + sizeof(s16))*font->kern_table_count;
+    font->kern_keys = (u32 *)allocate_memory(total_size);
+    font->kern_values = (s16 *)(font->kern_keys + font->kern_table_count);
+    
+    if (pair_count)
+    {
+        stbtt_kerningentry *entries = (stbtt_kerningentry *)malloc(sizeof(stbtt_kerningentry)*pair_count);
+        pair_count = stbtt_GetKerningTable(info, entries, pair_count);
         
+        for (s32 pair_index = 0; pair_index < pair_count; pair_index += 1)
+        {
+            stbtt_kerningentry entry = entries[pair_index];
+            if (entry.glyph1 > 0 && entry.glyph2 > 0 && entry.advance)
+            {
+                u32 key = ((u32)entry.glyph1 << 16) | (u32)entry.glyph2;
+                insert_kerning_pair(font, key, (s16)entry.advance);
+            }
+        }
+        free(entries);
+    }
+}
+
+static f32 get_kerning(Font *font, u16 left_stb_index, u16 right_stb_index)
+{
+    // Offset added to the advance of the left glyph when it's followed by the right one.
+    if (!font->kern_table_count || !left_stb_index || !right_stb_index) {
+        return 0.f;
+    }
+    
+    u32 key = ((u32)left_stb_index << 16) | right_stb_index;
+    u32 slot = get_kerning_slot(font, key);
+    s32 value = font->kern_values[slot];
+    
+    if (!font->kern_keys[slot])
+    {
+        value = 0;
+        if (font->kern_lazy)
+        {
+            // when the table is full pairs just don't get stored
+            value = stbtt_GetGlyphKernAdvance(&font->stb_info, left_stb_index, right_stb_index);
+            insert_kerning_pair(font, key, (s16)value);
+        }
+    }
+    
+    return (f32)value * font->font_scale;
+}
+
+
+
+//
+// Glyph metrics
+//
+
+static void initialize_font_glyph_metrics(Font *font)
+{
+    font->metrics_table_count = 4096;
+    font->metrics_key_mask = font->metrics_table_count - 1;
+    
+    u64 total_size = (sizeof(u32) + sizeof(Glyph_Metrics))*font->metrics_table_count;
+    font->metrics_keys = (u32 *)allocate_memory(total_size);
+    font->metrics_values = (Glyph_Metrics *)(font->metrics_keys + font->metrics_table_count);
+}
+
+static u32 get_glyph_metrics_slot(Font *font, u32 key)
+{
+    // slot with the key or the first empty slot on its probe sequence
+    u32 slot = hash_u32(key) & font->metrics_key_mask;
+    
+    while (font->metrics_keys[slot] && font->metrics_keys[slot] != key)
+    {
+        slot = (slot + 1) & font->metrics_key_mask;
+    }
+    return slot;
+}
+
+static Glyph_Metrics get_glyph_metrics(Font *font, u32 codepoint)
+{
+    // Metrics of the glyph that gets drawn for the codepoint - '?' for missing ones (same as render_codepoint).
+    // Doesn't rasterize & doesn't touch the glyph cache - measuring can't evict glyphs that are visible.
+    if (codepoint >= Font_AsciiBlock_Start &&
+        codepoint < FontAsciiBlock_OnePastLast)
+    {
+        Glyph *glyph = font->ascii_block + (codepoint - Font_AsciiBlock_Start);
+        return {glyph->advance, glyph->offset_x, glyph->offset_y, glyph->width, glyph->height, glyph->stb_index};
+    }
+    
+    u32 key = codepoint + 1;
+    u32 slot = get_glyph_metrics_slot(font, key);
+    if (!font->metrics_keys[slot])
+    {
+        // keeps at least 1/4 of the slots empty so probe sequences stay short
+        if (4*(font->metrics_used_count + 1) > 3*font->metrics_table_count)
+        {
+            memset(font->metrics_keys, 0, sizeof(u32)*font->metrics_table_count);
+            font->metrics_used_count = 0;
+            slot = get_glyph_metrics_slot(font, key);
+        }
         
-        if (mono_bitmap)
+        Glyph_Metrics metrics;
+        stbtt_fontinfo *info = &font->stb_info;
+        s32 stb_glyph_index = stbtt_FindGlyphIndex(info, codepoint);
+        if (stb_glyph_index > 0)
         {
-            stbtt_FreeBitmap(mono_bitmap, 0);
+            s32 advance, left_side_bearing;
+            stbtt_GetGlyphHMetrics(info, stb_glyph_index, &advance, &left_side_bearing);
+            
+            s32 x0, y0, x1, y1;
+            stbtt_GetGlyphBitmapBox(info, stb_glyph_index, font->font_scale, font->font_scale, &x0, &y0, &x1, &y1);
+            
+            metrics.advance = (f32)advance * font->font_scale;
+            metrics.offset_x = (s16)x0;
+            metrics.offset_y = (s16)y0;
+            metrics.width = (u16)(x1 - x0);
+            metrics.height = (u16)(y1 - y0);
+            metrics.stb_index = (u16)stb_glyph_index;
         }
+        else
+        {
+            metrics = get_glyph_metrics(font, '?');
+        }
+        
+        font->metrics_keys[slot] = key;
+        font->metrics_values[slot] = metrics;
+        font->metrics_used_count += 1;
     }
-    else
+    
+    return font->metrics_values[slot];
+}
+
+
+static f32 str_measure_width(Font *font, String text)
+{
+    // Sum of advances with kerning - the same width that text_layout_update & render_text_run produce.
+    // Printable ASCII is read straight from the ascii block without decoding utf8.
+    f32 width = 0.f;
+    u16 prev_stb_index = 0;
+    
+    for (u64 index = 0; index < text.size;)
     {
-        glyph->status = Glyph_Invalid;
+        u8 byte = text.str[index];
+        f32 advance;
+        u16 stb_index;
+        
+        if (byte >= Font_AsciiBlock_Start &&
+            byte < FontAsciiBlock_OnePastLast)
+        {
+            Glyph *glyph = font->ascii_block + (byte - Font_AsciiBlock_Start);
+            advance = glyph->advance;
+            stb_index = glyph->stb_index;
+            index += 1;
+        }
+        else
+        {
+            Unicode_Consume consume = utf8_consume(str_skip(text, index));
+            Glyph_Metrics metrics = get_glyph_metrics(font, consume.codepoint);
+            advance = metrics.advance;
+            stb_index = metrics.stb_index;
+            index += consume.inc;
+        }
+        
+        width += get_kerning(font, prev_stb_index, stb_index);
+        width += advance;
+        prev_stb_index = stb_index;
+    }
+    
+    return width;
+}
+
+
+
+//
+// Atlas pages
+//
+
+static b32 add_atlas_page(Font *font)
+{
+    // Returns false when the font has all its pages or the glyph texture has no free page.
+    u32 texture_page;
+    if (font->atlas_page_count == Font_MaxAtlasPages ||
+        !d3d11_allocate_glyph_texture_page(&texture_page))
+    {
+        return false;
+    }
+    
+    Font_Atlas_Page *page = font->atlas_pages + font->atlas_page_count;
+    font->atlas_page_count += 1;
+    
+    page->texture_page = texture_page;
+    page->last_use = font->atlas_use_clock;
+    atlas_skyline_reset(&page->skyline, 0, (u16)(texture_page*TEXTURE_HEIGHT), TEXTURE_WIDTH, TEXTURE_HEIGHT);
+    return true;
+}
+
+static void unlink_glyph_from_hash_table(Font *font, Glyph *glyph)
+{
+    u32 key = (glyph->hash & font->hash_table_key_mask);
+    u16 *scan_for_hash_table_index = font->hash_table + key;
+    
+    for (;;)
+    {
+        Glyph *glyph_check = font->data_table + *scan_for_hash_table_index;
+        
+        if (glyph_check == glyph)
+        {
+            *scan_for_hash_table_index = glyph_check->next_in_collision;
+            glyph_check->next_in_collision = 0;
+            break;
+        }
+        
+        assert(glyph_check->next_in_collision);
+        scan_for_hash_table_index = &glyph_check->next_in_collision;
     }
 }
 
+static void evict_atlas_page(Font *font, u32 page_index)
+{
+    // Glyphs on the page leave the cache at once - their slots go to the end of the LRU to be reused first.
+    for (u32 data_index = 1; data_index < font->data_table_count; data_index += 1)
+    {
+        Glyph *glyph = font->data_table + data_index;
+        if (!glyph->hash || glyph->status != Glyph_Loaded || glyph->atlas_page != page_index) {
+            continue;
+        }
+        
+        unlink_glyph_from_hash_table(font, glyph);
+        clear_glyph_font_data(glyph);
+        
+        font->data_table[glyph->prev_in_lru].next_in_lru = glyph->next_in_lru;
+        font->data_table[glyph->next_in_lru].prev_in_lru = glyph->prev_in_lru;
+        glyph->next_in_lru = 0;
+        glyph->prev_in_lru = font->data_table[0].prev_in_lru;
+        font->data_table[glyph->prev_in_lru].next_in_lru = (u16)data_index;
+        font->data_table[0].prev_in_lru = (u16)data_index;
+    }
+    
+    Font_Atlas_Page *page = font->atlas_pages + page_index;
+    if (page_index == 0) {
+        page->skyline = font->atlas_after_ascii;
+    } else {
+        atlas_skyline_reset(&page->skyline, 0, (u16)(page->texture_page*TEXTURE_HEIGHT), TEXTURE_WIDTH, TEXTURE_HEIGHT);
+    }
+    font->glyph_evict_count += 1;
+}
 
+static b32 pack_glyph_on_atlas_page(Font *font, Glyph *glyph, u32 page_index)
+{
+    Font_Atlas_Page *page = font->atlas_pages + page_index;
+    if (!atlas_skyline_pack(&page->skyline, glyph->width, glyph->height, &glyph->tex_x, &glyph->tex_y)) {
+        return false;
+    }
+    
+    glyph->atlas_page = (u8)page_index;
+    page->last_use = ++font->atlas_use_clock;
+    return true;
+}
 
-static void initialize_font(Font *font, char *font_file_data, f32 pixel_scale)
+static b32 pack_glyph_in_atlas(Font *font, Glyph *glyph, b32 is_ascii_block)
+{
+    // Pages are tried from the newest one. When none has space a page gets added -
+    //   if that's not possible the least recently used page is emptied (preferring pages without text runs).
+    for (u32 page_index = font->atlas_page_count; page_index-- > 0;)
+    {
+        if (pack_glyph_on_atlas_page(font, glyph, page_index)) {
+            return true;
+        }
+    }
+    
+    // ascii block always has to fit
+    assert(!is_ascii_block);
+    
+    u32 page_index = font->atlas_page_count;
+    if (!add_atlas_page(font))
+    {
+        page_index = 0;
+        for (u32 index = 1; index < font->atlas_page_count; index += 1)
+        {
+            Font_Atlas_Page *page = font->atlas_pages + index;
+            Font_Atlas_Page *best = font->atlas_pages + page_index;
+            b32 has_runs = (page->text_run_count > 0);
+            b32 best_has_runs = (best->text_run_count > 0);
+            if (has_runs < best_has_runs ||
+                (has_runs == best_has_runs && page->last_use < best->last_use))
+            {
+                page_index = index;
+            }
+        }
+        evict_atlas_page(font, page_index);
+    }
+    
+    return pack_glyph_on_atlas_page(font, glyph, page_index);
+}
+
+
+
+static void initialize_font(Font *font, char *font_file_data, f32 pixel_scale, u32 subpixel_phase_count = 4)
 {
     font->font_file_data = (unsigned char *)font_file_data;
     
     assert(pixel_scale >= 1.f);
     pixel_scale = get_max(pixel_scale, 1.f);
     
+    assert(subpixel_phase_count >= 1 && subpixel_phase_count <= Glyph_MaxSubpixelPhases);
+    font->subpixel_phase_count = get_min(get_max(subpixel_phase_count, 1u), (u32)Glyph_MaxSubpixelPhases);
+    
     
     int init_offset = stbtt_GetFontOffsetForIndex(font->font_file_data, 0);
     b32 ok = (init_offset >= 0);
@@ -200,6 +601,10 @@ static void initialize_font(Font *font, char *font_file_data, f32 pixel_scale)
                 
                 //font->max_width = (u16)get_max(1.f, ceilf(bounding_width) + 1); @delete
                 font->max_height = (u16)get_max(1.f, ceilf(bounding_height) + 1);
+                
+                // + 2 - subpixel offset can make the bitmap a pixel wider
+                font->glyph_bitmap_size = (u32)(ceilf(bounding_width) + 2)*font->max_height;
+                font->glyph_bitmap = (u8 *)allocate_memory(font->glyph_bitmap_size);
             }
             
             {
@@ -216,6 +621,13 @@ static void initialize_font(Font *font, char *font_file_data, f32 pixel_scale)
                 font->space_width = (f32)advance_width * font->font_scale;
             }
             
+            ok = add_atlas_page(font);
+        }
+        
+        if (ok)
+        {
+            u64 ascii_area = 0;
+            
             for (s32 ascii_index = 0;
                  ascii_index < array_count(font->ascii_block);
                  ascii_index += 1)
@@ -228,7 +640,17 @@ static void initialize_font(Font *font, char *font_file_data, f32 pixel_scale)
                 if (glyph->width > font->max_ascii_width) {
                     font->max_ascii_width = glyph->width;
                 }
+                ascii_area += (u64)glyph->width*glyph->height;
             }
+            font->atlas_after_ascii = font->atlas_pages[0].skyline;
+            
+            // slots for dynamic glyphs - as many as ascii-sized glyphs that fit on all pages
+            u64 area_left = (u64)TEXTURE_WIDTH*TEXTURE_HEIGHT*Font_MaxAtlasPages - ascii_area;
+            u64 average_area = get_max(ascii_area / array_count(font->ascii_block), 1ull);
+            font->data_table_count = (u32)get_min(get_max(area_left / average_area, 16ull), 0xFFFEull) + 1; // + 1 for "null slot" with index 0
+            
+            initialize_font_kerning(font);
+            initialize_font_glyph_metrics(font);
         }
     }
     
@@ -236,13 +658,9 @@ static void initialize_font(Font *font, char *font_file_data, f32 pixel_scale)
     
     if (ok)
     {
-        s32 texture_width_left = (TEXTURE_WIDTH - font->tex_x);
-        s32 dynamic_glyph_slots = texture_width_left / font->max_ascii_width;
+        u32 dynamic_glyph_slots = font->data_table_count - 1;
         
-        if (dynamic_glyph_slots > 0)
         {
-            font->data_table_count = dynamic_glyph_slots + 1; // + 1 for "null slot" with index 0
-            
             Bit_Scan_Result msb = find_most_significant_bit(dynamic_glyph_slots * 4 / 3);
             font->hash_table_count = (1 << (msb.index + 1));
             font->hash_table_key_mask = font->hash_table_count - 1;
@@ -261,24 +679,12 @@ static void initialize_font(Font *font, char *font_file_data, f32 pixel_scale)
                 Glyph *glyph = font->data_table + data_index;
                 glyph->next_in_lru = (u16)(data_index + 1);
                 glyph->prev_in_lru = (u16)(data_index - 1);
-                
-                if (data_index > 0)
-                {
-                    glyph->tex_x = font->tex_x;
-                    glyph->tex_y = font->tex_y;
-                    font->tex_x += font->max_ascii_width;
-                    assert(font->tex_x <= TEXTURE_WIDTH);
-                }
             }
             
             u64 last_index = (font->data_table_count - 1);
             font->data_table[0].prev_in_lru = (u16)last_index;
             font->data_table[last_index].next_in_lru = 0;
         }
-        else
-        {
-            assert(0);
-        }
     }
     else
     {
@@ -309,26 +715,11 @@ static Glyph *get_free_glyph_slot(Font *font)
     if (glyph_oldest->hash)
     {
         // used glyph - needs to be evicted
-        u32 key = 1 + (glyph_oldest->hash & font->hash_table_key_mask);
-        u16 *scan_for_hash_table_index = font->hash_table + key;
-        
-        for (;;)
-        {
-            Glyph *glyph_check = font->data_table + *scan_for_hash_table_index;
-            
-            if (glyph_check == glyph_oldest)
-            {
-                *scan_for_hash_table_index = glyph_check->next_in_collision;
-                glyph_check->next_in_collision = 0;
-                break;
-            }
-            
-            assert(glyph_check->next_in_collision);
-            scan_for_hash_table_index = &glyph_check->next_in_collision;
-        }
+        unlink_glyph_from_hash_table(font, glyph_oldest);
         
         assert(!glyph_oldest->next_in_collision);
         clear_glyph_font_data(glyph_oldest);
+        font->glyph_evict_count += 1;
     }
     
     return glyph_oldest;
@@ -349,8 +740,56 @@ static u16 get_data_index_from_glyph_pointer(Font *font, Glyph *glyph)
 
 
 
-static Glyph get_glyph(Font *font, u32 codepoint_hash)
+static void touch_glyph_slot(Font *font, u16 data_index)
+{
+    // Marks a cached glyph as used - front of the LRU and its atlas page becomes the most recently used one.
+    // Callers that keep slots from get_glyph (text runs) have to check glyph_evict_count first.
+    Glyph *glyph = font->data_table + data_index;
+    assert(data_index);
+    
+    if (glyph->status == Glyph_Loaded) {
+        font->atlas_pages[glyph->atlas_page].last_use = ++font->atlas_use_clock;
+    }
+    
+    Glyph *next = font->data_table + glyph->next_in_lru;
+    Glyph *prev = font->data_table + glyph->prev_in_lru;
+    prev->next_in_lru = glyph->next_in_lru;
+    next->prev_in_lru = glyph->prev_in_lru;
+    
+    glyph->next_in_lru = font->data_table[0].next_in_lru;
+    glyph->prev_in_lru = 0;
+    
+    font->data_table[glyph->next_in_lru].prev_in_lru = data_index;
+    font->data_table[glyph->prev_in_lru].next_in_lru = data_index;
+}
+
+
+struct Subpixel_Position
+{
+    f32 pixel_x; // whole pixels
+    u32 phase_bits; // goes to the glyph hash
+};
+
+static Subpixel_Position get_subpixel_position(Font *font, f32 x)
+{
+    // x rounded to the nearest 1/subpixel_phase_count of a pixel
+    f32 phase_count = (f32)font->subpixel_phase_count;
+    f32 units = floorf(x*phase_count + 0.5f);
+    
+    Subpixel_Position result;
+    result.pixel_x = floorf(units / phase_count);
+    result.phase_bits = (u32)(units - result.pixel_x*phase_count) << Glyph_SubpixelShift;
+    return result;
+}
+
+
+static Glyph get_glyph(Font *font, u32 codepoint_hash, u16 *out_slot = nullptr)
 {
+    // out_slot gets the cache slot of dynamic glyphs (0 for the ascii block & missing glyphs) - see touch_glyph_slot.
+    if (out_slot) {
+        *out_slot = 0;
+    }
+    
     if (codepoint_hash >= Font_AsciiBlock_Start &&
         codepoint_hash < FontAsciiBlock_OnePastLast)
     {
@@ -358,7 +797,7 @@ static Glyph get_glyph(Font *font, u32 codepoint_hash)
         return font->ascii_block[glyph_index];
     }
     
-    u32 key = 1 + (codepoint_hash & font->hash_table_key_mask);
+    u32 key = (codepoint_hash & font->hash_table_key_mask);
     
     Glyph *glyph = font->data_table + font->hash_table[key];
     for (;;)
@@ -395,19 +834,13 @@ static Glyph get_glyph(Font *font, u32 codepoint_hash)
     }
     
     
-    // update position in LRU
+    u16 data_index = get_data_index_from_glyph_pointer(font, glyph);
+    if (data_index) // codepoint 0 matches the "null slot"
     {
-        Glyph *next = font->data_table + glyph->next_in_lru;
-        Glyph *prev = font->data_table + glyph->prev_in_lru;
-        prev->next_in_lru = glyph->next_in_lru;
-        next->prev_in_lru = glyph->prev_in_lru;
-        
-        glyph->next_in_lru = font->data_table[0].next_in_lru;
-        glyph->prev_in_lru = 0;
-        
-        u16 this_glyph_index = get_data_index_from_glyph_pointer(font, glyph);
-        font->data_table[glyph->next_in_lru].prev_in_lru = this_glyph_index;
-        font->data_table[glyph->prev_in_lru].next_in_lru = this_glyph_index;
+        touch_glyph_slot(font, data_index);
+        if (out_slot) {
+            *out_slot = data_index;
+        }
     }
     
     return *glyph;
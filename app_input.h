@@ -0,0 +1,333 @@
+struct Input_Event
+{
+    u8 vk_code; // is equal to zero if str is filled
+    u8 shift : 1;
+    u8 control : 1;
+    u8 alt : 1;
+    u8 released : 1;
+    u8 double_click : 1; // VK_LBUTTON only
+    char cstr[4]; // single codepoint encoded in utf8 - zero terminated if it's less than 4 bytes
+};
+
+
+
+//
+// Input_Ring
+//
+// Lock-free queue with a single producer (thread that owns the window) and a single consumer (frame loop).
+// Events are never dropped - if the ring is full they wait in the overflow array of the producer
+//   (it grows as needed) and get moved to the ring once the consumer makes some space.
+//
+
+#define INPUT_RING_SIZE 256 // has to be a power of two
+
+struct Input_Ring
+{
+    Input_Event events[INPUT_RING_SIZE];
+    
+    // indices only grow (and wrap around u32) - count of events in the ring is write_index - read_index
+    alignas(64) std::atomic<u32> write_index; // written by the producer
+    alignas(64) std::atomic<u32> read_index; // written by the consumer
+    
+    // producer only
+    alignas(64) Input_Event *overflow;
+    u32 overflow_count, overflow_cap;
+};
+
+
+static b32 input_ring_flush_overflow(Input_Ring *ring)
+{
+    // Producer side. Returns true if the overflow array is empty afterwards.
+    if (!ring->overflow_count) {
+        return true;
+    }
+    
+    u32 write_index = ring->write_index.load(std::memory_order_relaxed);
+    u32 read_index = ring->read_index.load(std::memory_order_acquire);
+    u32 space = INPUT_RING_SIZE - (write_index - read_index);
+    u32 move_count = get_min(space, ring->overflow_count);
+    
+    for (u32 index = 0; index < move_count; index += 1) {
+        ring->events[(write_index + index) & (INPUT_RING_SIZE - 1)] = ring->overflow[index];
+    }
+    ring->write_index.store(write_index + move_count, std::memory_order_release);
+    
+    ring->overflow_count -= move_count;
+    memmove(ring->overflow, ring->overflow + move_count, ring->overflow_count*sizeof(Input_Event));
+    return (ring->overflow_count == 0);
+}
+
+static void input_ring_push(Input_Ring *ring, Input_Event event)
+{
+    // Producer side.
+    if (input_ring_flush_overflow(ring))
+    {
+        u32 write_index = ring->write_index.load(std::memory_order_relaxed);
+        u32 read_index = ring->read_index.load(std::memory_order_acquire);
+        if (write_index - read_index < INPUT_RING_SIZE)
+        {
+            ring->events[write_index & (INPUT_RING_SIZE - 1)] = event;
+            ring->write_index.store(write_index + 1, std::memory_order_release);
+            return;
+        }
+    }
+    
+    // order is kept - once something is in the overflow array every new event goes there too
+    if (ring->overflow_count == ring->overflow_cap)
+    {
+        ring->overflow_cap = get_max(ring->overflow_cap*2, INPUT_RING_SIZE);
+        ring->overflow = (Input_Event *)realloc(ring->overflow, ring->overflow_cap*sizeof(Input_Event));
+        assert(ring->overflow);
+    }
+    ring->overflow[ring->overflow_count++] = event;
+}
+
+static b32 input_ring_pop(Input_Ring *ring, Input_Event *out_event)
+{
+    // Consumer side. Returns false if the ring is empty.
+    u32 read_index = ring->read_index.load(std::memory_order_relaxed);
+    u32 write_index = ring->write_index.load(std::memory_order_acquire);
+    if (read_index == write_index) {
+        return false;
+    }
+    
+    *out_event = ring->events[read_index & (INPUT_RING_SIZE - 1)];
+    ring->read_index.store(read_index + 1, std::memory_order_release);
+    return true;
+}
+
+
+
+//
+// Applying events to a text input - shared by the app and the headless replay
+//
+
+struct Typed_Text
+{
+    // Characters typed in a row are written to the text input as a single edit -
+    //   typing 'a' then 'b' is the same as writing "ab" (including replacement of the selection).
+    u8 memory[256];
+    u64 size;
+};
+
+static void typed_text_flush(Typed_Text *typed, Text_Input *text_input)
+{
+    if (typed->size)
+    {
+        text_input_write(text_input, {typed->memory, typed->size});
+        typed->size = 0;
+    }
+}
+
+static void typed_text_add(Typed_Text *typed, Text_Input *text_input, Input_Event event)
+{
+    u64 size = strnlen(event.cstr, sizeof(event.cstr));
+    if (typed->size + size > array_count(typed->memory)) {
+        typed_text_flush(typed, text_input);
+    }
+    
+    memcpy(typed->memory + typed->size, event.cstr, size);
+    typed->size += size;
+}
+
+static b32 text_input_handle_key(Text_Input *text_input, Input_Event event)
+{
+    // Keyboard editing & cursor movement. Returns false if the key isn't handled here.
+    switch (event.vk_code)
+    {
+        case VK_BACK:
+        case VK_DELETE: {
+            s64 dir = (event.vk_code == VK_BACK ? -1 : 1);
+            u32 flags = 0;
+            if (event.control) { flags |= TextInputMove_ByWords; }
+            
+            text_input_delete(text_input, dir, flags);
+        } break;
+        
+        case VK_LEFT:
+        case VK_RIGHT: {
+            s64 dir = (event.vk_code == VK_LEFT ? -1 : 1);
+            u32 flags = 0;
+            if (event.shift) { flags |= TextInputMove_Select; }
+            if (event.control) { flags |= TextInputMove_ByWords; }
+            text_input_move_cursor(text_input, dir, flags);
+        } break;
+        
+        case VK_HOME:
+        case VK_END: {
+            s64 dir = (event.vk_code == VK_HOME ? -1 : 1);
+            u32 flags = TextInputMove_ByMax;
+            if (event.shift) { flags |= TextInputMove_Select; }
+            text_input_move_cursor(text_input, dir, flags);
+        } break;
+        
+        case VK_ESCAPE: {
+            text_input_clear_additional_cursors(text_input);
+            if (text_input->selections) {
+                text_input->selections->count = 0;
+            }
+            text_input->is_dirty = true;
+        } break;
+        
+        case 'A': {
+            if (!event.control || event.alt) {
+                return false;
+            }
+            text_input_move_cursor(text_input, -1, TextInputMove_ByMax);
+            text_input_move_cursor(text_input, 1, TextInputMove_ByMax | TextInputMove_Select);
+        } break;
+        
+        default: {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+
+//
+// Recording
+//
+// Binary format:
+//   header: u32 magic, u32 version
+//   every event: time since the previous event in microseconds (LEB128),
+//     vk_code byte, flags byte (shift, control, alt, released, double_click bits),
+//     utf8 bytes of the codepoint if vk_code is 0 (their count comes from the first byte)
+//
+
+#define INPUT_RECORDING_MAGIC 0x43455249 // "IREC"
+#define INPUT_RECORDING_VERSION 1
+
+struct Input_Recorder
+{
+    FILE *file;
+    u64 last_time_us;
+};
+
+struct Input_Replay
+{
+    u8 *at, *end;
+    u64 time_us;
+};
+
+
+static void input_recorder_begin(Input_Recorder *recorder, FILE *file, u64 time_us)
+{
+    u32 header[] = {INPUT_RECORDING_MAGIC, INPUT_RECORDING_VERSION};
+    fwrite(header, sizeof(header), 1, file);
+    recorder->file = file;
+    recorder->last_time_us = time_us;
+}
+
+static u32 input_recording_encode(u8 *out, Input_Event event, u64 delta_us)
+{
+    // Writes at most 16 bytes. Returns count of written bytes.
+    u32 count = 0;
+    do
+    {
+        u8 low = (u8)(delta_us & 0x7F);
+        delta_us >>= 7;
+        out[count++] = (u8)(low | (delta_us ? 0x80 : 0));
+    } while (delta_us);
+    
+    out[count++] = event.vk_code;
+    out[count++] = (u8)(event.shift | (event.control << 1) | (event.alt << 2) |
+                        (event.released << 3) | (event.double_click << 4));
+    
+    if (!event.vk_code)
+    {
+        u32 size = utf8_top5b_class[(u8)event.cstr[0] >> 3];
+        size = (size >= 1 && size <= 4 ? size : 1);
+        memcpy(out + count, event.cstr, size);
+        count += size;
+    }
+    return count;
+}
+
+static void input_recorder_write(Input_Recorder *recorder, Input_Event event, u64 time_us)
+{
+    if (!recorder->file) {
+        return;
+    }
+    
+    u64 delta_us = (time_us > recorder->last_time_us ? time_us - recorder->last_time_us : 0);
+    recorder->last_time_us = get_max(time_us, recorder->last_time_us);
+    
+    u8 bytes[16];
+    u32 count = input_recording_encode(bytes, event, delta_us);
+    fwrite(bytes, count, 1, recorder->file);
+}
+
+static void input_recorder_end(Input_Recorder *recorder)
+{
+    if (recorder->file)
+    {
+        fclose(recorder->file);
+        recorder->file = nullptr;
+    }
+}
+
+
+static b32 input_replay_begin(Input_Replay *replay, String recording)
+{
+    u32 header[2];
+    if (recording.size < sizeof(header)) {
+        return false;
+    }
+    memcpy(header, recording.str, sizeof(header));
+    
+    replay->at = recording.str + sizeof(header);
+    replay->end = recording.str + recording.size;
+    replay->time_us = 0;
+    return (header[0] == INPUT_RECORDING_MAGIC && header[1] == INPUT_RECORDING_VERSION);
+}
+
+static b32 input_replay_next(Input_Replay *replay, Input_Event *out_event)
+{
+    // Returns false at the end of the recording (or if it's truncated).
+    u64 delta = 0;
+    for (u32 shift = 0; ; shift += 7)
+    {
+        if (replay->at >= replay->end || shift > 63) {
+            return false;
+        }
+        u8 byte = *replay->at++;
+        delta |= (u64)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            break;
+        }
+    }
+    
+    if (replay->end - replay->at < 2) {
+        return false;
+    }
+    
+    Input_Event event = {};
+    event.vk_code = replay->at[0];
+    u8 flags = replay->at[1];
+    event.shift = (flags >> 0) & 1;
+    event.control = (flags >> 1) & 1;
+    event.alt = (flags >> 2) & 1;
+    event.released = (flags >> 3) & 1;
+    event.double_click = (flags >> 4) & 1;
+    replay->at += 2;
+    
+    if (!event.vk_code)
+    {
+        if (replay->at >= replay->end) {
+            return false;
+        }
+        u32 size = utf8_top5b_class[replay->at[0] >> 3];
+        size = (size >= 1 && size <= 4 ? size : 1);
+        if ((u64)(replay->end - replay->at) < size) {
+            return false;
+        }
+        memcpy(event.cstr, replay->at, size);
+        replay->at += size;
+    }
+    
+    replay->time_us += delta;
+    *out_event = event;
+    return true;
+}
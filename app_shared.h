@@ -80,6 +80,19 @@ static f32 time_elapsed(s64 recent, s64 old)
     return result;
 }
 
+static u64 time_elapsed_us(s64 recent, s64 old)
+{
+    // integer microseconds - doesn't lose precision over long sessions like time_elapsed
+    LARGE_INTEGER perfomance_freq;
+    QueryPerformanceFrequency(&perfomance_freq);
+    
+    s64 delta = get_max(recent - old, 0);
+    s64 seconds = delta / perfomance_freq.QuadPart;
+    s64 remainder = delta % perfomance_freq.QuadPart;
+    u64 result = (u64)(seconds*1000000 + remainder*1000000 / perfomance_freq.QuadPart);
+    return result;
+}
+
 
 
 
@@ -0,0 +1,361 @@
+//
+// Text run cache
+//
+// Strings that are drawn every frame (labels, placeholders, repeated values) get turned into quads once.
+// Runs are keyed by (font, hash of the string) and shared by all widgets - a run holds a copy of the
+//   string (hash collisions are checked) followed by its quads with positions relative to the pen.
+// Eviction is least recently used and bounded by bytes: run data is bump allocated from one block
+//   and live runs get compacted once the top of the block is reached.
+// Runs start at whole pixels - glyphs after the first one keep their subpixel phases.
+// Quads point into the glyph texture - runs that use glyphs from the dynamic part of the glyph cache
+//   are rebuilt after the font evicts any glyph (see Font::glyph_evict_count).
+// Runs keep the cache slots of those glyphs and touch them on every hit - otherwise glyphs & atlas pages
+//   of labels drawn every frame would look unused to the glyph cache and get evicted first.
+// Atlas pages that cached runs point into are counted (Font_Atlas_Page::text_run_count) so the glyph cache
+//   empties other pages first.
+//
+
+struct Text_Run_Quad
+{
+    f32 x; // whole pixels from the start of the run - glyphs are rasterized at their subpixel phase
+    f32 y; // relative to the pen position, rounded when drawn
+    u16 width, height;
+    u16 tex_x, tex_y;
+    u32 rgba_xor; // missing codepoints are drawn as '?' with inverted color (same as render_codepoint)
+};
+
+struct Text_Run
+{
+    Font *font; // nullptr in free slots
+    u64 hash;
+    u32 size; // of the string
+    u32 quad_count;
+    u32 glyph_slot_count; // of dynamic glyphs - see get_glyph
+    u32 atlas_page_mask; // pages of the dynamic glyphs
+    u32 data_offset; // string bytes (padded to 4) followed by quads and glyph slots (padded to 4)
+    u32 glyph_evict_count;
+    f32 advance; // includes kerning between glyphs of the run
+    
+    u32 next_in_collision;
+    u32 next_in_lru;
+    u32 prev_in_lru;
+};
+
+struct Text_Run_Cache
+{
+    // Run with index 0 is the head of the LRU list and the "null run" of collision chains.
+    // Free slots are kept at the end of the LRU list.
+    Text_Run *runs;
+    u32 run_count;
+    u32 *hash_table;
+    u32 hash_table_key_mask;
+    u64 *compact_scratch; // run_count entries
+    
+    u8 *memory;
+    u64 memory_size;
+    u64 memory_top; // everything above is free
+    u64 memory_live; // bytes used by cached runs - memory_top minus this is garbage
+};
+
+
+
+static void initialize_text_run_cache(Text_Run_Cache *cache, u32 max_run_count, u64 memory_size)
+{
+    assert(max_run_count > 0 && memory_size < 0xFFFFFFFF);
+    cache->run_count = max_run_count + 1; // + 1 for "null run" with index 0
+    
+    Bit_Scan_Result msb = find_most_significant_bit(get_max(max_run_count * 4 / 3, 2u));
+    u32 hash_table_count = (1u << (msb.index + 1));
+    cache->hash_table_key_mask = hash_table_count - 1;
+    
+    u64 total_size = (sizeof(Text_Run)*cache->run_count +
+                      sizeof(u64)*cache->run_count +
+                      sizeof(u32)*hash_table_count +
+                      memory_size);
+    
+    cache->runs = (Text_Run *)allocate_memory(total_size);
+    cache->compact_scratch = (u64 *)(cache->runs + cache->run_count);
+    cache->hash_table = (u32 *)(cache->compact_scratch + cache->run_count);
+    cache->memory = (u8 *)(cache->hash_table + hash_table_count);
+    cache->memory_size = memory_size;
+    cache->memory_top = cache->memory_live = 0;
+    
+    for (u32 run_index = 0; run_index < cache->run_count; run_index += 1)
+    {
+        Text_Run *run = cache->runs + run_index;
+        run->next_in_lru = (run_index + 1) % cache->run_count;
+        run->prev_in_lru = (run_index + cache->run_count - 1) % cache->run_count;
+    }
+}
+
+
+static u64 get_text_run_hash(Font *font, String text)
+{
+    // FNV-1a with the font pointer as the seed
+    u64 hash = 0xcbf29ce484222325ull ^ ((u64)font * 0x9E3779B97F4A7C15ull);
+    for (u64 index = 0; index < text.size; index += 1)
+    {
+        hash ^= text.str[index];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+static u32 get_text_run_data_size(u32 size, u32 quad_count, u32 glyph_slot_count)
+{
+    return (((size + 3) & ~3u) + quad_count*(u32)sizeof(Text_Run_Quad) +
+            ((glyph_slot_count*(u32)sizeof(u16) + 3) & ~3u));
+}
+
+static Text_Run_Quad *get_text_run_quads(Text_Run_Cache *cache, Text_Run *run)
+{
+    return (Text_Run_Quad *)(cache->memory + run->data_offset + ((run->size + 3) & ~3u));
+}
+
+static u16 *get_text_run_glyph_slots(Text_Run_Cache *cache, Text_Run *run)
+{
+    return (u16 *)(get_text_run_quads(cache, run) + run->quad_count);
+}
+
+
+static void text_run_move_in_lru(Text_Run_Cache *cache, u32 run_index, b32 to_front)
+{
+    Text_Run *runs = cache->runs;
+    Text_Run *run = runs + run_index;
+    runs[run->prev_in_lru].next_in_lru = run->next_in_lru;
+    runs[run->next_in_lru].prev_in_lru = run->prev_in_lru;
+    
+    run->prev_in_lru = (to_front ? 0 : runs[0].prev_in_lru);
+    run->next_in_lru = runs[run->prev_in_lru].next_in_lru;
+    runs[run->prev_in_lru].next_in_lru = run_index;
+    runs[run->next_in_lru].prev_in_lru = run_index;
+}
+
+static void text_run_count_atlas_pages(Text_Run *run, s32 delta)
+{
+    for (u32 mask = run->atlas_page_mask; mask; mask &= mask - 1)
+    {
+        Font_Atlas_Page *page = run->font->atlas_pages + find_least_significant_bit(mask).index;
+        assert(delta > 0 || page->text_run_count > 0);
+        page->text_run_count += (u32)delta;
+    }
+}
+
+static void evict_text_run(Text_Run_Cache *cache, u32 run_index)
+{
+    Text_Run *run = cache->runs + run_index;
+    assert(run->font);
+    
+    u32 *scan = cache->hash_table + (run->hash & cache->hash_table_key_mask);
+    while (*scan != run_index)
+    {
+        assert(*scan);
+        scan = &cache->runs[*scan].next_in_collision;
+    }
+    *scan = run->next_in_collision;
+    
+    cache->memory_live -= get_text_run_data_size(run->size, run->quad_count, run->glyph_slot_count);
+    text_run_count_atlas_pages(run, -1);
+    run->font = nullptr;
+    run->next_in_collision = 0;
+    text_run_move_in_lru(cache, run_index, false);
+}
+
+static int compare_u64(const void *a, const void *b)
+{
+    u64 value_a = *(u64 *)a;
+    u64 value_b = *(u64 *)b;
+    return (value_a < value_b ? -1 : (value_a > value_b ? 1 : 0));
+}
+
+static void compact_text_run_memory(Text_Run_Cache *cache)
+{
+    // Live runs get moved down in the order of their data - sorted by (data_offset << 32 | run_index).
+    u32 live_count = 0;
+    for (u32 run_index = 1; run_index < cache->run_count; run_index += 1)
+    {
+        Text_Run *run = cache->runs + run_index;
+        if (run->font) {
+            cache->compact_scratch[live_count++] = ((u64)run->data_offset << 32) | run_index;
+        }
+    }
+    qsort(cache->compact_scratch, live_count, sizeof(u64), compare_u64);
+    
+    u64 top = 0;
+    for (u32 index = 0; index < live_count; index += 1)
+    {
+        Text_Run *run = cache->runs + (u32)cache->compact_scratch[index];
+        u32 data_size = get_text_run_data_size(run->size, run->quad_count, run->glyph_slot_count);
+        memmove(cache->memory + top, cache->memory + run->data_offset, data_size);
+        run->data_offset = (u32)top;
+        top += data_size;
+    }
+    
+    assert(top == cache->memory_live);
+    cache->memory_top = top;
+}
+
+
+static u32 layout_text_run(Font *font, String text, Text_Run_Quad *out_quads, u16 *out_glyph_slots, Text_Run *out_run)
+{
+    // Same glyphs & positions as render_codepoint with kerning from text_layout_update.
+    // Returns count of quads - out_quads & out_glyph_slots can be null to get just the counts.
+    u32 quad_count = 0;
+    u32 glyph_slot_count = 0;
+    u32 atlas_page_mask = 0;
+    f32 pen_x = 0.f;
+    u16 prev_stb_index = 0;
+    u32 glyph_evict_count = font->glyph_evict_count; // if glyphs get evicted while the run is built it's rebuilt next time
+    
+    for (u64 index = 0; index < text.size;)
+    {
+        Unicode_Consume consume = utf8_consume(str_skip(text, index));
+        index += consume.inc;
+        
+        u32 codepoint = consume.codepoint;
+        Glyph_Metrics metrics = get_glyph_metrics(font, codepoint);
+        pen_x += get_kerning(font, prev_stb_index, metrics.stb_index);
+        prev_stb_index = metrics.stb_index;
+        
+        Subpixel_Position position = get_subpixel_position(font, pen_x);
+        u32 rgba_xor = 0;
+        u16 glyph_slot;
+        Glyph glyph = get_glyph(font, codepoint | position.phase_bits, &glyph_slot);
+        if (glyph.status == Glyph_Invalid)
+        {
+            rgba_xor = Bitmask_24;
+            codepoint = '?';
+            glyph = get_glyph(font, codepoint | position.phase_bits, &glyph_slot);
+        }
+        
+        if (glyph_slot)
+        {
+            if (out_glyph_slots)
+            {
+                assert(glyph_slot_count < out_run->glyph_slot_count);
+                out_glyph_slots[glyph_slot_count] = glyph_slot;
+            }
+            glyph_slot_count += 1;
+            atlas_page_mask |= (glyph.status == Glyph_Loaded ? 1u << glyph.atlas_page : 0);
+        }
+        
+        if (glyph.status == Glyph_Loaded)
+        {
+            if (out_quads)
+            {
+                assert(quad_count < out_run->quad_count);
+                out_quads[quad_count] = {position.pixel_x + (f32)glyph.offset_x, (f32)glyph.offset_y,
+                                         glyph.width, glyph.height,
+                                         glyph.tex_x, glyph.tex_y, rgba_xor};
+            }
+            quad_count += 1;
+        }
+        
+        pen_x += glyph.advance;
+    }
+    
+    if (out_run)
+    {
+        out_run->advance = pen_x;
+        out_run->glyph_slot_count = glyph_slot_count;
+        out_run->atlas_page_mask = atlas_page_mask;
+        out_run->glyph_evict_count = glyph_evict_count;
+    }
+    return quad_count;
+}
+
+
+static Text_Run *get_text_run(Text_Run_Cache *cache, Font *font, String text)
+{
+    // Returns nullptr if the run can't fit in the cache - the caller has to draw it without the cache.
+    u64 hash = get_text_run_hash(font, text);
+    u32 *bucket = cache->hash_table + (hash & cache->hash_table_key_mask);
+    
+    u32 run_index = *bucket;
+    while (run_index)
+    {
+        Text_Run *run = cache->runs + run_index;
+        if (run->hash == hash && run->font == font && run->size == text.size &&
+            memcmp(cache->memory + run->data_offset, text.str, text.size) == 0)
+        {
+            break;
+        }
+        run_index = run->next_in_collision;
+    }
+    
+    if (run_index)
+    {
+        Text_Run *run = cache->runs + run_index;
+        if (run->glyph_slot_count)
+        {
+            u16 *glyph_slots = get_text_run_glyph_slots(cache, run);
+            if (run->glyph_evict_count != font->glyph_evict_count)
+            {
+                // counts don't change - rewritten in place
+                text_run_count_atlas_pages(run, -1);
+                layout_text_run(font, text, get_text_run_quads(cache, run), glyph_slots, run);
+                text_run_count_atlas_pages(run, 1);
+            }
+            else
+            {
+                for (u32 slot_index = 0; slot_index < run->glyph_slot_count; slot_index += 1) {
+                    touch_glyph_slot(font, glyph_slots[slot_index]);
+                }
+            }
+        }
+        
+        text_run_move_in_lru(cache, run_index, true);
+        return run;
+    }
+    
+    
+    if (text.size > cache->memory_size) {
+        return nullptr;
+    }
+    Text_Run counts = {};
+    u32 quad_count = layout_text_run(font, text, nullptr, nullptr, &counts);
+    u64 data_size = get_text_run_data_size((u32)text.size, quad_count, counts.glyph_slot_count);
+    if (data_size > cache->memory_size) {
+        return nullptr;
+    }
+    
+    // free bytes starting from the least recently used run
+    for (u32 index = cache->runs[0].prev_in_lru; index && cache->memory_live + data_size > cache->memory_size;)
+    {
+        u32 prev = cache->runs[index].prev_in_lru;
+        if (cache->runs[index].font) {
+            evict_text_run(cache, index);
+        }
+        index = prev;
+    }
+    
+    // free slots are at the end of the LRU list - if there aren't any the oldest run goes
+    run_index = cache->runs[0].prev_in_lru;
+    if (cache->runs[run_index].font) {
+        evict_text_run(cache, run_index);
+    }
+    
+    if (cache->memory_top + data_size > cache->memory_size) {
+        compact_text_run_memory(cache);
+    }
+    
+    
+    Text_Run *run = cache->runs + run_index;
+    run->font = font;
+    run->hash = hash;
+    run->size = (u32)text.size;
+    run->quad_count = quad_count;
+    run->glyph_slot_count = counts.glyph_slot_count;
+    run->data_offset = (u32)cache->memory_top;
+    cache->memory_top += data_size;
+    cache->memory_live += data_size;
+    
+    memcpy(cache->memory + run->data_offset, text.str, text.size);
+    layout_text_run(font, text, get_text_run_quads(cache, run), get_text_run_glyph_slots(cache, run), run);
+    text_run_count_atlas_pages(run, 1);
+    
+    run->next_in_collision = *bucket;
+    *bucket = run_index;
+    text_run_move_in_lru(cache, run_index, true);
+    return run;
+}
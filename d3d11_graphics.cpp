@@ -7,6 +7,7 @@
 
 struct D3d11_State
 {
+    ID3D11Device1* device;
     ID3D11DeviceContext1* device_context;
     IDXGISwapChain1* swap_chain;
     
@@ -31,6 +32,8 @@ struct D3d11_State
     
     ID3D11Texture2D* texture;
     ID3D11ShaderResourceView* texture_view;
+    u32 texture_page_count; // glyph atlas pages handed out - see d3d11_allocate_glyph_texture_page
+    u32 texture_page_capacity; // texture is TEXTURE_HEIGHT*texture_page_capacity rows tall
     ID3D11SamplerState* sampler_state;
     
     ID3D11BlendState* blend_state;
@@ -76,11 +79,69 @@ static D3d11_State d3_state;
 static Ui_State ui_state;
 
 #define TEXTURE_WIDTH  (2048*4)
-#define TEXTURE_HEIGHT (256)
+#define TEXTURE_HEIGHT (256) // of one glyph atlas page - pages are stacked vertically
+#define TEXTURE_MAX_PAGES (16)
 
 
 
 
+static void d3d11_create_glyph_texture(u32 page_capacity)
+{
+    // Glyph atlas pages are bands of TEXTURE_HEIGHT rows, so quads keep plain texel coordinates.
+    // Growing recreates the texture with the old pages copied over.
+    assert(page_capacity > d3_state.texture_page_capacity && page_capacity <= TEXTURE_MAX_PAGES);
+    
+    D3D11_TEXTURE2D_DESC texture_desc = {};
+    texture_desc.Width              = TEXTURE_WIDTH;
+    texture_desc.Height             = TEXTURE_HEIGHT*page_capacity;
+    texture_desc.MipLevels          = 1;
+    texture_desc.ArraySize          = 1;
+    texture_desc.Format             = DXGI_FORMAT_A8_UNORM;
+    texture_desc.SampleDesc.Count   = 1;
+    texture_desc.Usage              = D3D11_USAGE_DEFAULT;
+    texture_desc.BindFlags          = D3D11_BIND_SHADER_RESOURCE;
+    
+    ID3D11Texture2D* texture;
+    d3_state.device->CreateTexture2D(&texture_desc, nullptr, &texture);
+    
+    if (d3_state.texture)
+    {
+        D3D11_BOX copy_box = {};
+        copy_box.right = TEXTURE_WIDTH;
+        copy_box.bottom = TEXTURE_HEIGHT*d3_state.texture_page_capacity;
+        copy_box.back = 1;
+        d3_state.device_context->CopySubresourceRegion(texture, 0, 0, 0, 0, d3_state.texture, 0, &copy_box);
+        
+        d3_state.texture_view->Release();
+        d3_state.texture->Release();
+    }
+    
+    d3_state.texture = texture;
+    d3_state.device->CreateShaderResourceView(d3_state.texture, nullptr, &d3_state.texture_view);
+    d3_state.texture_page_capacity = page_capacity;
+    
+    ui_state.constants.atlas_width_inv = 1.f / TEXTURE_WIDTH;
+    ui_state.constants.atlas_height_inv = 1.f / (TEXTURE_HEIGHT*page_capacity);
+}
+
+static b32 d3d11_allocate_glyph_texture_page(u32 *out_page)
+{
+    // Returns false when all TEXTURE_MAX_PAGES are taken - fonts then reuse their own pages.
+    if (d3_state.texture_page_count == TEXTURE_MAX_PAGES) {
+        return false;
+    }
+    
+    if (d3_state.texture_page_count == d3_state.texture_page_capacity) {
+        d3d11_create_glyph_texture(get_min(d3_state.texture_page_capacity*2, (u32)TEXTURE_MAX_PAGES));
+    }
+    
+    *out_page = d3_state.texture_page_count;
+    d3_state.texture_page_count += 1;
+    return true;
+}
+
+
+
 static void d3d11_check_debug_errors()
 {
 #if defined(_DEBUG)
@@ -342,26 +403,8 @@ static void initialize_d3d11_graphics(HWND window)
     
     
     ////////////////////////////
-    {
-        D3D11_TEXTURE2D_DESC texture_desc = {};
-        texture_desc.Width              = TEXTURE_WIDTH;  // in data.h
-        texture_desc.Height             = TEXTURE_HEIGHT; // in data.h
-        texture_desc.MipLevels          = 1;
-        texture_desc.ArraySize          = 1;
-        texture_desc.Format             = DXGI_FORMAT_A8_UNORM;
-        texture_desc.SampleDesc.Count   = 1;
-        texture_desc.Usage              = D3D11_USAGE_DEFAULT;
-        texture_desc.BindFlags          = D3D11_BIND_SHADER_RESOURCE;
-        
-        //D3D11_SUBRESOURCE_DATA texture_data = {};
-        //texture_data.pSysMem            = raw_texture_data;
-        //texture_data.SysMemPitch        = TEXTURE_WIDTH * 1; // 4 bytes per pixel
-        //
-        //device->CreateTexture2D(&texture_desc, &texture_data, &d3_state.texture);
-        device->CreateTexture2D(&texture_desc, nullptr, &d3_state.texture);
-        
-        device->CreateShaderResourceView(d3_state.texture, nullptr, &d3_state.texture_view);
-    }
+    d3_state.device = device;
+    d3d11_create_glyph_texture(1);
     
     
     ////////////////////////////
@@ -397,7 +440,7 @@ static void d3d11_update_glyph_texture(u32 tex_x, u32 tex_y,
     update_box.right = tex_x + image_width;
     update_box.top = tex_y;
     update_box.bottom = tex_y + image_height;
-    assert(update_box.right <= TEXTURE_WIDTH && update_box.bottom <= TEXTURE_HEIGHT);
+    assert(update_box.right <= TEXTURE_WIDTH && update_box.bottom <= TEXTURE_HEIGHT*d3_state.texture_page_capacity);
     
     d3_state.device_context->UpdateSubresource(d3_state.texture, 0, &update_box,
                                                image_memory, image_pitch,
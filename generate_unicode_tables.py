@@ -0,0 +1,231 @@
+# Generates utf8_unicode_tables.h
+#
+# Usage: python generate_unicode_tables.py > utf8_unicode_tables.h
+#
+# Properties are derived from Python's unicodedata (general categories, bidi classes) plus
+# explicit codepoint lists from UAX #29 / emoji-data.txt that can't be derived from categories.
+# Tables are stored as sorted run starts: (first_codepoint << 5) | property.
+# Every run lasts until the start of the next one - lookup is a binary search.
+
+import sys
+import unicodedata
+
+MAX_CODEPOINT = 0x10FFFF
+
+
+def ranges_to_set(ranges):
+    result = set()
+    for r in ranges:
+        if isinstance(r, tuple):
+            result.update(range(r[0], r[1] + 1))
+        else:
+            result.add(r)
+    return result
+
+
+def category(cp):
+    return unicodedata.category(chr(cp))
+
+
+EXTENDED_PICTOGRAPHIC = ranges_to_set([
+    0x00A9, 0x00AE, 0x203C, 0x2049, 0x2122, 0x2139, (0x2194, 0x2199), (0x21A9, 0x21AA),
+    (0x231A, 0x231B), 0x2328, 0x2388, 0x23CF, (0x23E9, 0x23F3), (0x23F8, 0x23FA), 0x24C2,
+    (0x25AA, 0x25AB), 0x25B6, 0x25C0, (0x25FB, 0x25FE), (0x2600, 0x2605), (0x2607, 0x2612),
+    (0x2614, 0x2685), (0x2690, 0x2705), (0x2708, 0x2712), 0x2714, 0x2716, 0x271D, 0x2721,
+    0x2728, (0x2733, 0x2734), 0x2744, 0x2747, 0x274C, 0x274E, (0x2753, 0x2755), 0x2757,
+    (0x2763, 0x2767), (0x2795, 0x2797), 0x27A1, 0x27B0, 0x27BF, (0x2934, 0x2935),
+    (0x2B05, 0x2B07), (0x2B1B, 0x2B1C), 0x2B50, 0x2B55, 0x3030, 0x303D, 0x3297, 0x3299,
+    (0x1F000, 0x1F0FF), (0x1F10D, 0x1F10F), 0x1F12F, (0x1F16C, 0x1F171), (0x1F17E, 0x1F17F),
+    0x1F18E, (0x1F191, 0x1F19A), (0x1F1AD, 0x1F1E5), (0x1F201, 0x1F20F), 0x1F21A, 0x1F22F,
+    (0x1F232, 0x1F23A), (0x1F23C, 0x1F23F), (0x1F249, 0x1F3FA), (0x1F400, 0x1F53D),
+    (0x1F546, 0x1F64F), (0x1F680, 0x1F6FF), (0x1F774, 0x1F77F), (0x1F7D5, 0x1F7FF),
+    (0x1F80C, 0x1F80F), (0x1F848, 0x1F84F), (0x1F85A, 0x1F85F), (0x1F888, 0x1F88F),
+    (0x1F8AE, 0x1F8FF), (0x1F90C, 0x1F93A), (0x1F93C, 0x1F945), (0x1F947, 0x1FAFF),
+    (0x1FC00, 0x1FFFD),
+])
+
+OTHER_GRAPHEME_EXTEND = ranges_to_set([
+    0x09BE, 0x09D7, 0x0B3E, 0x0B57, 0x0BBE, 0x0BD7, 0x0CC2, (0x0CD5, 0x0CD6), 0x0D3E, 0x0D57,
+    0x0DCF, 0x0DDF, 0x1B35, (0x200C, 0x200C), (0x302E, 0x302F), (0xFF9E, 0xFF9F), 0x1133E,
+    0x11357, 0x114B0, 0x114BD, 0x115AF, 0x11930, 0x1D165, (0x1D16E, 0x1D172),
+    (0xE0020, 0xE007F), (0x1F3FB, 0x1F3FF),
+])
+
+PREPEND = ranges_to_set([
+    (0x0600, 0x0605), 0x06DD, 0x070F, (0x0890, 0x0891), 0x08E2, 0x0D4E, 0x110BD, 0x110CD,
+    (0x111C2, 0x111C3), 0x1193F, 0x11941, 0x11A3A, (0x11A84, 0x11A89), 0x11D46,
+])
+
+# Spacing marks that are not GCB=SpacingMark
+NOT_SPACING_MARK = ranges_to_set([
+    0x102B, 0x102C, 0x1038, (0x1062, 0x1064), (0x1067, 0x106D), 0x1083, (0x1087, 0x108C),
+    0x108F, (0x109A, 0x109C), 0x1A61, 0x1A63, 0x1A64, 0xAA7B, 0xAA7D, 0x11720, 0x11721,
+])
+
+
+GRAPHEME_BREAK = [
+    'Other', 'CR', 'LF', 'Control', 'Extend', 'ZWJ', 'RegionalIndicator', 'Prepend',
+    'SpacingMark', 'L', 'V', 'T', 'LV_LVT', 'ExtendedPictographic',
+    'LV', 'LVT', # only produced at runtime - LV_LVT gets resolved arithmetically
+]
+
+
+def grapheme_break(cp):
+    if cp == 0x0D: return 'CR'
+    if cp == 0x0A: return 'LF'
+    if cp == 0x200D: return 'ZWJ'
+    if 0x1F1E6 <= cp <= 0x1F1FF: return 'RegionalIndicator'
+    if cp in PREPEND: return 'Prepend'
+    if 0x1100 <= cp <= 0x115F or 0xA960 <= cp <= 0xA97C: return 'L'
+    if 0x1160 <= cp <= 0x11A7 or 0xD7B0 <= cp <= 0xD7C6: return 'V'
+    if 0x11A8 <= cp <= 0x11FF or 0xD7CB <= cp <= 0xD7FB: return 'T'
+    if 0xAC00 <= cp <= 0xD7A3: return 'LV_LVT' # resolved arithmetically at runtime
+    if cp in EXTENDED_PICTOGRAPHIC: return 'ExtendedPictographic'
+
+    cat = category(cp)
+    if cat in ('Mn', 'Me') or cp in OTHER_GRAPHEME_EXTEND: return 'Extend'
+    if cat in ('Cc', 'Zl', 'Zp', 'Cf', 'Cs'): return 'Control'
+    if (cat == 'Mc' and cp not in NOT_SPACING_MARK) or cp in (0x0E33, 0x0EB3): return 'SpacingMark'
+    return 'Other'
+
+
+WORD_BREAK = [
+    'Other', 'CR', 'LF', 'Newline', 'Extend', 'ZWJ', 'RegionalIndicator', 'Format', 'Katakana',
+    'HebrewLetter', 'ALetter', 'SingleQuote', 'DoubleQuote', 'MidNumLet', 'MidLetter', 'MidNum',
+    'Numeric', 'ExtendNumLet', 'WSegSpace', 'ExtendedPictographic',
+    'OtherLetter', # not in UAX #29 - letters that break like Other (ideographs, Hiragana, Thai...) but still form words
+]
+
+MID_NUM_LET = {0x002E, 0x2018, 0x2019, 0x2024, 0xFE52, 0xFF07, 0xFF0E}
+MID_LETTER = {0x003A, 0x00B7, 0x0387, 0x055F, 0x05F4, 0x2027, 0xFE13, 0xFE55, 0xFF1A}
+MID_NUM = {0x002C, 0x003B, 0x037E, 0x0589, 0x060C, 0x060D, 0x066C, 0x07F8, 0x2044,
+           0xFE10, 0xFE14, 0xFE50, 0xFE54, 0xFF0C, 0xFF1B}
+
+# Non-letter codepoints that are ALetter anyway
+EXTRA_ALETTER = ranges_to_set([
+    (0x02C2, 0x02C5), (0x02D2, 0x02D7), (0x02DE, 0x02DF), (0x02E5, 0x02EB), 0x02ED,
+    (0x02EF, 0x02FF), (0x055A, 0x055C), 0x055E, 0x058A, 0x05F3, (0x24B6, 0x24E9),
+    (0xA708, 0xA716), (0xA720, 0xA721), (0xA789, 0xA78A), 0xAB5B,
+])
+
+EXTRA_KATAKANA = ranges_to_set([
+    (0x3031, 0x3035), 0x309B, 0x309C, 0x30A0, 0x30FC, 0xFF70, (0x3300, 0x3357),
+])
+
+# Scripts without spaces between words (Line_Break=SA) - UAX #29 leaves them to dictionaries
+COMPLEX_CONTEXT_PREFIXES = ('THAI', 'LAO', 'MYANMAR', 'KHMER', 'TAI LE', 'NEW TAI LUE',
+                            'TAI THAM', 'TAI VIET', 'AHOM')
+IDEOGRAPHIC_PREFIXES = ('CJK UNIFIED IDEOGRAPH', 'CJK COMPATIBILITY IDEOGRAPH', 'TANGUT',
+                        'NUSHU', 'KHITAN SMALL SCRIPT')
+
+
+def word_break(cp):
+    if cp == 0x0D: return 'CR'
+    if cp == 0x0A: return 'LF'
+    if cp in (0x0B, 0x0C, 0x85, 0x2028, 0x2029): return 'Newline'
+    if cp == 0x200D: return 'ZWJ'
+    if 0x1F1E6 <= cp <= 0x1F1FF: return 'RegionalIndicator'
+    if cp == 0x27: return 'SingleQuote'
+    if cp == 0x22: return 'DoubleQuote'
+    if cp in MID_NUM_LET: return 'MidNumLet'
+    if cp in MID_LETTER: return 'MidLetter'
+    if cp in MID_NUM: return 'MidNum'
+
+    cat = category(cp)
+    name = unicodedata.name(chr(cp), '')
+    if cat in ('Mn', 'Me', 'Mc') or cp in OTHER_GRAPHEME_EXTEND: return 'Extend'
+    if cat == 'Cf' and cp != 0x200B and cp not in PREPEND: return 'Format'
+    if cp in EXTRA_KATAKANA or ('KATAKANA' in name and 'MIDDLE DOT' not in name): return 'Katakana'
+    if cat == 'Lo' and name.startswith('HEBREW LETTER'): return 'HebrewLetter'
+    if cat == 'Nd' or cp == 0x066B: return 'Numeric'
+    if cat == 'Pc' or cp == 0x202F: return 'ExtendNumLet'
+    if cat == 'Zs' and cp not in (0x00A0, 0x2007): return 'WSegSpace'
+
+    if cat[0] == 'L' or cat == 'Nl' or cp in EXTRA_ALETTER:
+        if (name.startswith(IDEOGRAPHIC_PREFIXES) or name.startswith(COMPLEX_CONTEXT_PREFIXES) or
+            'HIRAGANA' in name or cp in (0x3005, 0x3006, 0x3007) or
+            0x3021 <= cp <= 0x3029 or 0x3038 <= cp <= 0x303B):
+            return 'OtherLetter'
+        return 'ALetter'
+
+    if cp in EXTENDED_PICTOGRAPHIC: return 'ExtendedPictographic'
+    return 'Other'
+
+
+BIDI_CLASS = [
+    'L', 'R', 'AL', 'EN', 'ES', 'ET', 'AN', 'CS', 'NSM', 'BN', 'B', 'S', 'WS', 'ON',
+    'LRE', 'LRO', 'RLE', 'RLO', 'PDF', 'LRI', 'RLI', 'FSI', 'PDI',
+]
+
+# Defaults of unassigned codepoints from DerivedBidiClass.txt - everything else is L
+BIDI_DEFAULT_R = ranges_to_set([
+    (0x0590, 0x05FF), (0x07C0, 0x085F), (0xFB1D, 0xFB4F), (0x10800, 0x10CFF), (0x10D40, 0x10EBF),
+    (0x10F00, 0x10F2F), (0x10F70, 0x10FFF), (0x1E800, 0x1EC6F), (0x1ECC0, 0x1ECFF),
+    (0x1ED50, 0x1EDFF), (0x1EF00, 0x1EFFF),
+])
+BIDI_DEFAULT_AL = ranges_to_set([
+    (0x0600, 0x07BF), (0x0860, 0x08FF), (0xFB50, 0xFDCF), (0xFDF0, 0xFDFF), (0xFE70, 0xFEFF),
+    (0x10D00, 0x10D3F), (0x10EC0, 0x10EFF), (0x10F30, 0x10F6F), (0x1EC70, 0x1ECBF),
+    (0x1ED00, 0x1ED4F), (0x1EE00, 0x1EEFF),
+])
+
+
+def bidi_class(cp):
+    value = unicodedata.bidirectional(chr(cp))
+    if value: return value
+    if cp in BIDI_DEFAULT_R: return 'R'
+    if cp in BIDI_DEFAULT_AL: return 'AL'
+    if 0x20A0 <= cp <= 0x20CF: return 'ET'
+    if 0xFDD0 <= cp <= 0xFDEF or (cp & 0xFFFE) == 0xFFFE or 0xE0000 <= cp <= 0xE0FFF: return 'BN'
+    return 'L'
+
+
+def build_runs(property_function):
+    runs = []
+    last = None
+    for cp in range(MAX_CODEPOINT + 1):
+        value = property_function(cp)
+        if value != last:
+            runs.append((cp, value))
+            last = value
+    return runs
+
+
+def emit_enum(out, type_name, prefix, values):
+    out.write('enum %s : u8\n{\n' % type_name)
+    for value in values:
+        out.write('    %s_%s,\n' % (prefix, value))
+    out.write('};\n\n')
+
+
+def emit_table(out, table_name, prefix, values, runs):
+    out.write('static u32 %s[%d] =\n{\n' % (table_name, len(runs)))
+    line = '   '
+    for cp, value in runs:
+        entry = ' 0x%08X,' % ((cp << 5) | values.index(value))
+        if len(line) + len(entry) > 100:
+            out.write(line + '\n')
+            line = '   '
+        line += entry
+    out.write(line + '\n};\n\n')
+
+
+def main():
+    out = sys.stdout
+    out.write('// Generated by generate_unicode_tables.py - do not edit by hand.\n')
+    out.write('// Unicode version: %s\n' % unicodedata.unidata_version)
+    out.write('// Entries: (first_codepoint << 5) | property - every run lasts until the next entry.\n\n\n')
+
+    emit_enum(out, 'Grapheme_Break', 'GraphemeBreak', GRAPHEME_BREAK)
+    emit_table(out, 'unicode_grapheme_break_table', 'GraphemeBreak', GRAPHEME_BREAK,
+               build_runs(grapheme_break))
+    emit_enum(out, 'Word_Break', 'WordBreak', WORD_BREAK)
+    emit_table(out, 'unicode_word_break_table', 'WordBreak', WORD_BREAK,
+               build_runs(word_break))
+    emit_enum(out, 'Bidi_Class', 'Bidi', BIDI_CLASS)
+    emit_table(out, 'unicode_bidi_class_table', 'Bidi', BIDI_CLASS,
+               build_runs(bidi_class))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,219 @@
+//
+// Headless replay of input recordings - made with: App.exe -record <path> (format is in app_input.h)
+//
+// Events are applied to a text input the same way the app does it, without a window.
+// Events get grouped into frames by their timestamps, so the replay is deterministic and
+//   characters typed within one frame are coalesced like in the app.
+// Mouse events need layout & fonts and the clipboard isn't recorded - both are skipped.
+//
+// Build on Linux: g++ -O2 -std=c++17 replay.cpp -o replay
+// Usage: replay <recording> [-repeat count] [-cap buffer_bytes] [-frame_us microseconds]
+//
+
+#if _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include "Windows.h"
+#else
+#include "time.h"
+#define IsDebuggerPresent() 0
+#define __debugbreak()
+#define ExitProcess(Code) exit(Code)
+
+union LARGE_INTEGER
+{
+    long long QuadPart;
+};
+
+static int QueryPerformanceCounter(LARGE_INTEGER *value)
+{
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    value->QuadPart = time.tv_sec*1000000000ll + time.tv_nsec;
+    return 1;
+}
+
+static int QueryPerformanceFrequency(LARGE_INTEGER *value)
+{
+    value->QuadPart = 1000000000ll;
+    return 1;
+}
+
+#define VK_LBUTTON 0x01
+#define VK_BACK 0x08
+#define VK_ESCAPE 0x1B
+#define VK_END 0x23
+#define VK_HOME 0x24
+#define VK_LEFT 0x25
+#define VK_RIGHT 0x27
+#define VK_DELETE 0x2E
+#endif
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "emmintrin.h"
+#include "atomic"
+
+#include "app_shared.h"
+#include "utf8_strings.h"
+#include "utf8_unicode_tables.h"
+#include "utf8_segmentation.h"
+#include "utf8_bidi.h"
+#include "utf8_textedit.h"
+#include "app_input.h"
+
+
+
+
+static String read_entire_file(char *path)
+{
+    String result = {};
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return result;
+    }
+    
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    
+    result.str = (u8 *)malloc(get_max(size, 1));
+    result.size = fread(result.str, 1, size, file);
+    fclose(file);
+    return result;
+}
+
+static int compare_u64(const void *a, const void *b)
+{
+    u64 value_a = *(u64 *)a;
+    u64 value_b = *(u64 *)b;
+    return (value_a > value_b) - (value_a < value_b);
+}
+
+
+
+int main(int argument_count, char **arguments)
+{
+    if (argument_count < 2)
+    {
+        printf("Usage: %s <recording> [-repeat count] [-cap buffer_bytes] [-frame_us microseconds]\n", arguments[0]);
+        return 1;
+    }
+    
+    u64 repeat_count = 1;
+    u64 buffer_cap = 32; // same as the app
+    u64 frame_us = 16667;
+    for (s32 argument_index = 2; argument_index + 1 < argument_count; argument_index += 2)
+    {
+        String name = cstr_to_string(arguments[argument_index]);
+        u64 value = strtoull(arguments[argument_index + 1], nullptr, 10);
+        
+        if (str_equals(name, "-repeat"_f0)) { repeat_count = value; }
+        else if (str_equals(name, "-cap"_f0)) { buffer_cap = value; }
+        else if (str_equals(name, "-frame_us"_f0)) { frame_us = get_max(value, 1); }
+    }
+    
+    String recording = read_entire_file(arguments[1]);
+    Input_Replay replay = {};
+    if (!input_replay_begin(&replay, recording))
+    {
+        printf("Failed to read recording: %s\n", arguments[1]);
+        return 1;
+    }
+    
+    
+    // same setup as the app
+    Text_Input text_input = {};
+    text_input.buffer = {(u8 *)malloc(buffer_cap), 0, buffer_cap};
+    Text_Cursor text_input_cursors[16];
+    text_input.cursors = text_input_cursors;
+    text_input.cursor_cap = array_count(text_input_cursors);
+    
+    s64 word_count = (s64)(buffer_cap + 64)/64;
+    u64 *word_bits = (u64 *)calloc(3*word_count, sizeof(u64));
+    Text_Word_Cache text_input_words = {
+        word_bits, word_bits + word_count, word_bits + 2*word_count, word_count
+    };
+    text_input_attach_word_cache(&text_input, &text_input_words);
+    
+    
+    u64 frame_cap = 1024;
+    u64 frame_count = 0;
+    u64 *frame_times_ns = (u64 *)malloc(frame_cap*sizeof(u64));
+    u64 event_count = 0;
+    u64 total_ns = 0;
+    
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+    f64 ns_per_tick = 1e9 / (f64)frequency.QuadPart;
+    
+    for (u64 repeat_index = 0; repeat_index < repeat_count; repeat_index += 1)
+    {
+        // every run starts from the same empty state as the app
+        input_replay_begin(&replay, recording);
+        text_input.buffer.size = 0;
+        text_input.cursor_pos = text_input.mark_pos = 0;
+        text_input.cursor_count = 0;
+        text_input.primary_cursor_index = 0;
+        word_cache_clear(&text_input_words);
+        
+        Input_Event event;
+        b32 has_event = input_replay_next(&replay, &event);
+        while (has_event)
+        {
+            // one frame - all events up to the end of its time slice
+            u64 frame_end_us = (replay.time_us / frame_us + 1)*frame_us;
+            Typed_Text typed_text = {};
+            
+            s64 start_time = time_perf();
+            while (has_event && replay.time_us < frame_end_us)
+            {
+                if (event.vk_code == 0) {
+                    typed_text_add(&typed_text, &text_input, event);
+                } else {
+                    typed_text_flush(&typed_text, &text_input);
+                    text_input_handle_key(&text_input, event);
+                }
+                
+                event_count += 1;
+                has_event = input_replay_next(&replay, &event);
+            }
+            typed_text_flush(&typed_text, &text_input);
+            s64 end_time = time_perf();
+            
+            u64 frame_ns = (u64)((f64)(end_time - start_time)*ns_per_tick);
+            total_ns += frame_ns;
+            
+            if (frame_count == frame_cap)
+            {
+                frame_cap *= 2;
+                frame_times_ns = (u64 *)realloc(frame_times_ns, frame_cap*sizeof(u64));
+            }
+            frame_times_ns[frame_count++] = frame_ns;
+        }
+    }
+    
+    
+    // FNV-1a of the final state - has to be the same for every run of the same recording
+    u64 state_hash = 14695981039346656037ull;
+    for (u64 index = 0; index < text_input.buffer.size; index += 1) {
+        state_hash = (state_hash ^ text_input.buffer.str[index])*1099511628211ull;
+    }
+    state_hash = (state_hash ^ (u64)text_input.cursor_pos)*1099511628211ull;
+    state_hash = (state_hash ^ (u64)text_input.mark_pos)*1099511628211ull;
+    
+    qsort(frame_times_ns, frame_count, sizeof(u64), compare_u64);
+    u64 p50 = (frame_count ? frame_times_ns[frame_count/2] : 0);
+    u64 p99 = (frame_count ? frame_times_ns[(frame_count*99)/100] : 0);
+    u64 max = (frame_count ? frame_times_ns[frame_count - 1] : 0);
+    f64 seconds = (f64)total_ns / 1e9;
+    
+    printf("events: %llu, frames: %llu, total: %.3f ms\n",
+           (unsigned long long)event_count, (unsigned long long)frame_count, seconds*1000.0);
+    printf("throughput: %.0f events/s\n", (seconds > 0 ? (f64)event_count / seconds : 0.0));
+    printf("frame time: p50 %llu ns, p99 %llu ns, max %llu ns\n",
+           (unsigned long long)p50, (unsigned long long)p99, (unsigned long long)max);
+    printf("final state: %llu bytes, hash %016llx\n",
+           (unsigned long long)text_input.buffer.size, (unsigned long long)state_hash);
+    return 0;
+}
@@ -172,6 +172,7 @@ static void run_utf8_unit_tests()
         "Tosty"_f0,
         "Łabędzie"_f0,
         "漢字"_f0,
+        "ok\x8D"_f0, "\xC5\x82\x82"_f0, // stray continuation bytes
     };
     for_array(consume_string_index, consume_strings)
     {
@@ -253,6 +254,124 @@ static void run_text_input_unit_tests()
     
     
     
+    {
+        // word boundaries
+        String in_text[] = {
+            "can't stop"_f0, "3.14, ok"_f0, "foo.bar:baz"_f0, "a  b\r\n"_f0,
+            "你好world"_f0, "カタカナ漢"_f0, "e\xCC\x81t\xC3\xA9 x_1"_f0,
+        };
+        s64 boundaries[][8] = {
+            {5, 6, 10}, {4, 5, 6, 8}, {11}, {1, 3, 4, 6},
+            {3, 6, 11}, {12, 15}, {6, 7, 10},
+        };
+        assert_eq_array_count(in_text, boundaries);
+        
+        for_array(i, in_text)
+        {
+            s64 pos = 0;
+            for (s64 boundary_index = 0; pos < (s64)in_text[i].size; boundary_index += 1)
+            {
+                pos = str_next_word_boundary(in_text[i], pos);
+                assert(pos == boundaries[i][boundary_index]);
+            }
+        }
+        
+        // long ASCII lines go through the 64 byte fast path
+        String long_line = "The quick brown fox jumps over the lazy dog. It's 3.14 or 2,5 - can't tell; key:value_2 ok"_f0;
+        s64 expected[] = {3, 4, 9, 10, 15, 16, 19, 20, 25, 26, 30, 31, 34, 35, 39, 40, 43, 44, 45,
+            49, 50, 54, 55, 57, 58, 61, 62, 63, 64, 69, 70, 74, 75, 76, 87, 88, 90};
+        s64 pos = 0;
+        for_array(i, expected) {
+            pos = str_next_word_boundary(long_line, pos);
+            assert(pos == expected[i]);
+            assert(str_word_boundary_at_or_before(long_line, pos) == pos);
+        }
+        
+        assert(str_move_pos_by_words("你好 ab"_f0, 0, 1) == 3);
+        assert(str_move_pos_by_words("你好 ab"_f0, 6, 1) == 9);
+        assert(str_move_pos_by_words("你好 ab"_f0, 9, -2) == 3);
+        assert(str_move_pos_by_words("it's ok"_f0, 1, 1) == 5);
+        assert(str_move_pos_by_words(long_line, 90, -14) == 16);
+        
+        // text without spaces - backward motion restarts between two ideographs
+        String ideographs = "中文字符串abc中文"_f0;
+        for (s64 ideograph_pos = 0; ideograph_pos <= 15; ideograph_pos += 3) {
+            assert(str_word_boundary_at_or_before(ideographs, ideograph_pos) == ideograph_pos);
+        }
+        assert(str_word_boundary_restart_pos(ideographs, 12) == 12);
+        assert(str_word_boundary_safe_pos_after(ideographs, 4) == 9);
+        assert(str_word_boundary_at_or_before(ideographs, 17) == 15);
+        assert(str_move_pos_by_words(ideographs, 24, -3) == 15);
+    }
+    
+    
+    
+    {
+        String in_text[] = {
+            "e\xCC\x81x"_f0, "👍🏽!"_f0, "👨‍👩‍👧"_f0, "🇵🇱🇩🇪"_f0, "a\r\nb"_f0,
+            "\xE1\x84\x80\xE1\x85\xA1\xE1\x86\xA8x"_f0, "\xEA\xB0\x81\xE1\x86\xA8\xE1\x86\xA8x"_f0, "\xD8\x80x y"_f0, "ab"_f0,
+        };
+        s64 in_pos[] = {
+            0, 0, 0, 0, 1,
+            0, 0, 0, 2,
+        };
+        s64 in_move_by_graphemes[] = {
+            1, 1, 1, 1, 1,
+            1, 1, 1, -1,
+        };
+        s64 out[] = {
+            3, 8, 18, 8, 3,
+            9, 9, 3, 1,
+        };
+        assert_eq_array_count4(in_text, in_pos, in_move_by_graphemes, out);
+        
+        for_array(i, in_text)
+        {
+            s64 res = str_move_pos_by_graphemes(in_text[i], in_pos[i], in_move_by_graphemes[i]);
+            assert(res == out[i]);
+            
+            // every forward boundary is also found when walking backwards
+            if (in_move_by_graphemes[i] > 0) {
+                assert(str_move_pos_by_graphemes(in_text[i], res, -1) == in_pos[i]);
+            }
+        }
+        
+        // pairs of regional indicators
+        String flags = "🇵🇱🇩🇪🇺"_f0;
+        assert(str_move_pos_by_graphemes(flags, 0, 2) == 16);
+        assert(str_move_pos_by_graphemes(flags, 0, 3) == 20);
+        assert(str_move_pos_by_graphemes(flags, 20, -1) == 16);
+        assert(str_move_pos_by_graphemes(flags, 16, -1) == 8);
+        assert(!str_is_grapheme_boundary(flags, 4));
+        assert(str_is_grapheme_boundary(flags, 8));
+        assert(!str_is_grapheme_boundary(flags, 12));
+        assert(!str_is_grapheme_boundary(flags, 1));
+    }
+    
+    
+    
+    {
+        u8 memory[32];
+        Text_Input text = {};
+        text.buffer.str = memory;
+        text.buffer.cap = array_count(memory);
+        text_input_write(&text, "ae\xCC\x81👍🏽"_f0);
+        
+        // backspace removes the whole cluster
+        text_input_delete(&text, -1, 0);
+        assert(str_equals(text.buffer, "ae\xCC\x81"_f0));
+        text_input_delete(&text, -1, 0);
+        assert(str_equals(text.buffer, "a"_f0));
+        
+        text_input_write(&text, "\r\nb"_f0);
+        text_input_move_cursor(&text, -2, 0);
+        assert(text.cursor_pos == 1);
+        text_input_delete(&text, 1, 0);
+        assert(str_equals(text.buffer, "ab"_f0));
+    }
+    
+    
+    
     
     
     
@@ -342,5 +461,886 @@ static void run_text_input_unit_tests()
         assert(text.cursor_pos == 8);
         assert(str_equals(text.buffer, "123456ł"_f0));
     }
+    
+    
+    
+    
+    {
+        u8 memory[32];
+        Text_Cursor cursors[8];
+        Text_Input text = {};
+        text.buffer.str = memory;
+        text.buffer.cap = array_count(memory);
+        text.cursors = cursors;
+        text.cursor_cap = array_count(cursors);
+        
+        text_input_write(&text, "ab cd ef"_f0);
+        text.cursor_pos = text.mark_pos = 0;
+        assert(text_input_add_cursor(&text, 3, 3));
+        assert(text_input_add_cursor(&text, 6, 6));
+        assert(text_input_add_cursor(&text, 6, 6)); // duplicate gets merged
+        assert(text.cursor_count == 3);
+        
+        text_input_write(&text, "ł"_f0);
+        assert(str_equals(text.buffer, "łab łcd łef"_f0));
+        assert(text.cursors[0].cursor_pos == 2);
+        assert(text.cursors[1].cursor_pos == 7);
+        assert(text.cursors[2].cursor_pos == 12);
+        assert(text.cursor_pos == 12 && text.primary_cursor_index == 2);
+        
+        text_input_delete(&text, -1, 0);
+        assert(str_equals(text.buffer, "ab cd ef"_f0));
+        assert(text.cursor_pos == 6 && text.mark_pos == 6);
+        
+        // selections of different lengths - tail moves left and right in the same pass
+        text.cursors[0] = {0, 2};
+        text.cursors[1] = {3, 3};
+        text.mark_pos = 8;
+        text_input_write(&text, "XYZ"_f0);
+        assert(str_equals(text.buffer, "XYZ XYZcd XYZ"_f0));
+        assert(text.cursors[0].cursor_pos == 3);
+        assert(text.cursors[1].cursor_pos == 7);
+        assert(text.cursor_pos == 13);
+        
+        // selecting with cursors that run into each other merges them
+        text_input_move_cursor(&text, -1, TextInputMove_ByMax | TextInputMove_Select);
+        assert(text.cursor_count == 1);
+        assert(text.cursor_pos == 0 && text.mark_pos == 13);
+        
+        // every copy has to fit - "ZZZZZ" gets truncated to "ZZ" at 3 cursors with 6 free bytes
+        text_input_clear_additional_cursors(&text);
+        text.cursor_pos = 0;
+        text.mark_pos = text.buffer.size;
+        text_input_write(&text, "0123456789abcdefghij012345"_f0);
+        text.cursor_pos = text.mark_pos = 0;
+        text_input_add_cursor(&text, 10, 10);
+        text_input_add_cursor(&text, 20, 20);
+        text_input_write(&text, "ZZZZZ"_f0);
+        assert(str_equals(text.buffer, "ZZ0123456789ZZabcdefghijZZ012345"_f0));
+        
+        text_input_write(&text, "ł"_f0); // doesn't fit anywhere
+        assert(str_equals(text.buffer, "ZZ0123456789ZZabcdefghijZZ012345"_f0));
+    }
+    
+    
+    
+    {
+        u8 memory[16];
+        Text_Input text = {};
+        text.buffer.str = memory;
+        text.buffer.cap = array_count(memory);
+        text_input_write(&text, "ab cab ab"_f0);
+        text.cursor_pos = 5; // inside of the 2nd match
+        text.mark_pos = 9;
+        
+        Text_Edit edits[] = {
+            {0, 2, "łx"_f0},
+            {4, 6, "łx"_f0},
+            {7, 9, "łx"_f0},
+        };
+        assert(text_input_apply_edits(&text, edits, array_count(edits)));
+        assert(str_equals(text.buffer, "łx cłx łx"_f0));
+        assert(text.cursor_pos == 8);
+        assert(text.mark_pos == 12);
+        
+        // capacity is checked once for the whole batch - last replacements get truncated
+        Text_Edit edits2[] = {
+            {0, 0, "1"_f0},
+            {3, 3, "2"_f0},
+            {12, 12, "ł345"_f0},
+        };
+        assert(text_input_apply_edits(&text, edits2, array_count(edits2)));
+        assert(str_equals(text.buffer, "1łx2 cłx łxł"_f0));
+        assert(edits2[2].replacement.size == 2);
+    }
+    
+    
+    
+    {
+        u8 memory[32];
+        s64 line_starts[array_count(memory) + 1];
+        Text_Line_Index lines = {line_starts, 0, array_count(line_starts)};
+        
+        Text_Input text = {};
+        text.buffer.str = memory;
+        text.buffer.cap = array_count(memory);
+        text_input_attach_line_index(&text, &lines);
+        assert(lines.line_count == 1);
+        
+        text_input_write(&text, "ab\ncd\n\nef"_f0);
+        assert(lines.line_count == 4);
+        assert(line_index_line_from_pos(&lines, 0) == 0);
+        assert(line_index_line_from_pos(&lines, 2) == 0);
+        assert(line_index_line_from_pos(&lines, 3) == 1);
+        assert(line_index_line_from_pos(&lines, 7) == 3);
+        assert(line_index_line_start(&lines, 3) == 7);
+        assert(line_index_line_end(&lines, text.buffer, 1) == 5);
+        assert(line_index_line_end(&lines, text.buffer, 3) == 9);
+        
+        // replace "d\n\ne" with "X\nY" - one line less, every line start after it gets shifted
+        text.cursor_pos = 4;
+        text.mark_pos = 8;
+        text_input_write(&text, "X\nY"_f0);
+        assert(str_equals(text.buffer, "ab\ncX\nYf"_f0));
+        
+        s64 expected[] = {0, 3, 6};
+        assert(lines.line_count == array_count(expected));
+        for_array(i, expected) {
+            assert(lines.line_starts[i] == expected[i]);
+        }
+        
+        text.cursor_pos = 0;
+        text.mark_pos = 0;
+        text_input_write(&text, "\n\n"_f0);
+        s64 expected2[] = {0, 1, 2, 5, 8};
+        assert(lines.line_count == array_count(expected2));
+        for_array(i, expected2) {
+            assert(lines.line_starts[i] == expected2[i]);
+        }
+    }
+    
+    
+    
+    {
+        u8 memory[160];
+        u64 known[(array_count(memory) + 64)/64];
+        u64 boundaries[array_count(known)];
+        u64 word_starts[array_count(known)];
+        Text_Word_Cache words = {known, boundaries, word_starts, array_count(known)};
+        
+        Text_Input text = {};
+        text.buffer.str = memory;
+        text.buffer.cap = array_count(memory);
+        text_input_attach_word_cache(&text, &words);
+        text_input_write(&text, "The quick brown fox jumps over the lazy dog, it's 3.14 - "_f0);
+        text_input_write(&text, "can't tell; 你好 key:value_2 ok, one two three four five six"_f0);
+        
+        for (s64 pos = 0; pos <= (s64)text.buffer.size; pos += 1)
+        {
+            for (s64 move_by = -3; move_by <= 3; move_by += 1)
+            {
+                s64 expected = str_move_pos_by_words(text.buffer, pos, move_by);
+                assert(text_move_pos_by_words(text.buffer, &words, pos, move_by) == expected);
+            }
+        }
+        
+        // edit in the middle - cached bits after the edit are shifted, not rebuilt
+        text.cursor_pos = text.mark_pos = 4;
+        text_input_write(&text, "very "_f0);
+        assert(bit_array_get(words.known, 120));
+        text.cursor_pos = 40;
+        text.mark_pos = 46;
+        text_input_write(&text, "dog."_f0);
+        
+        for (s64 pos = 0; pos <= (s64)text.buffer.size; pos += 1)
+        {
+            assert(word_cache_boundary_at_or_before(&words, text.buffer, pos) ==
+                   str_word_boundary_at_or_before(text.buffer, pos));
+            assert(text_move_pos_by_words(text.buffer, &words, pos, 1) == str_move_pos_by_words(text.buffer, pos, 1));
+        }
+        
+        text_input_select_word(&text, 12);
+        assert(text.mark_pos == 9 && text.cursor_pos == 14);
+    }
+    
+    
+    
+    {
+        u8 memory[64];
+        u8 query_memory[16];
+        Text_Match matches[8];
+        Text_Search search = {};
+        search.query = {query_memory, 0, array_count(query_memory)};
+        search.matches = matches;
+        search.match_cap = array_count(matches);
+        
+        Text_Input text = {};
+        text.buffer.str = memory;
+        text.buffer.cap = array_count(memory);
+        text_input_write(&text, "Łabędź łabędzie ŁABĘDŹ aaa"_f0);
+        text_input_attach_search(&text, &search);
+        
+        text_search_set_query(&search, text.buffer, "łab"_f0, true);
+        assert(search.match_count == 3);
+        assert(search.matches[1].start == 10 && search.matches[1].one_past_end == 14);
+        
+        // extending the query filters previous matches
+        text_search_set_query(&search, text.buffer, "łabędź"_f0, true);
+        assert(search.match_count == 2);
+        assert(search.matches[0].start == 0 && search.matches[1].start == 21);
+        
+        text_search_set_query(&search, text.buffer, "łabędź"_f0, false);
+        assert(search.match_count == 0);
+        
+        text_search_set_query(&search, text.buffer, "aa"_f0, false);
+        assert(search.match_count == 2); // overlapping matches
+        
+        // edits keep matches valid - matches after the edit get shifted
+        text_search_set_query(&search, text.buffer, "ŁAB"_f0, true);
+        text.cursor_pos = text.mark_pos = 0;
+        text_input_write(&text, "łab "_f0);
+        assert(search.match_count == 4);
+        assert(search.matches[0].start == 0 && search.matches[3].start == 26);
+        
+        // deletion joins "ł" with "abędź"
+        text.cursor_pos = 2;
+        text.mark_pos = 7;
+        text_input_write(&text, ""_f0);
+        assert(str_equals(str_prefix(text.buffer, 7), "łabęd"_f0));
+        assert(search.match_count == 3);
+        assert(search.matches[0].start == 0 && search.matches[0].one_past_end == 4);
+        assert(search.matches[1].start == 10);
+    }
+    
+    {
+        // fuzzy matching for autocomplete
+        String candidates[] = {
+            "text_input_write"_f0, "TextInput"_f0, "test"_f0, "input"_f0,
+            "tiw"_f0, "write_text"_f0, "żółw"_f0,
+        };
+        u32 masks[(array_count(candidates) + 3) & ~3];
+        u32 matches[array_count(candidates)];
+        s32 scores[array_count(candidates)];
+        u8 query_memory[32];
+        
+        Text_Fuzzy_Matcher matcher = {};
+        matcher.candidate_masks = masks;
+        matcher.matches = matches;
+        matcher.scores = scores;
+        matcher.query.str = query_memory;
+        matcher.query.cap = array_count(query_memory);
+        text_fuzzy_set_candidates(&matcher, candidates, array_count(candidates));
+        assert(matcher.match_count == array_count(candidates)); // empty query matches everything
+        
+        u8 memory[64];
+        Text_Input text = {};
+        text.buffer.str = memory;
+        text.buffer.cap = array_count(memory);
+        text_input_attach_autocomplete(&text, &matcher);
+        
+        text_input_write(&text, "ti"_f0);
+        u32 expected_ti[] = {0, 1, 4};
+        assert(matcher.match_count == array_count(expected_ti));
+        for_array(i, expected_ti) {
+            assert(matcher.matches[i] == expected_ti[i]);
+        }
+        
+        // appending only filters previous matches
+        text_input_write(&text, "W"_f0);
+        u32 top[4];
+        s64 top_count = text_fuzzy_top(&matcher, top, array_count(top));
+        assert(top_count == 2);
+        assert(top[0] == 4 && top[1] == 0); // "tiw" matches at the start, consecutively
+        
+        // anything else runs the prefilter & scoring again
+        text.cursor_pos = text.mark_pos = 0;
+        text_input_write(&text, "Ż"_f0);
+        assert(matcher.match_count == 0);
+        text.cursor_pos = 0;
+        text.mark_pos = (s64)text.buffer.size;
+        text_input_write(&text, "ŻÓW"_f0);
+        assert(matcher.match_count == 1 && matcher.matches[0] == 6);
+        
+        s32 score_a = 0, score_b = 0;
+        assert(text_fuzzy_score("text_input"_f0, "ti"_f0, &score_a));
+        assert(text_fuzzy_score("TextInput"_f0, "ti"_f0, &score_b));
+        assert(score_b > score_a); // no gap before the camelCase hump
+        assert(!text_fuzzy_score("input"_f0, "ti"_f0, &score_a));
+    }
+    
+    {
+        // paste ingest
+        u8 out[64];
+        String in = "line 1\r\nline 2\rline 3\n\x01\x7F\xC2\x85tab\there \xC0\xAF\xED\xA0\x80\xF4\x90\x80\x80ź"_f0;
+        Text_Ingest_Result ingest = text_ingest(out, array_count(out), in, true);
+        assert(ingest.consumed == in.size);
+        assert(str_equals({out, ingest.written}, "line 1\nline 2\nline 3\ntab\there ź"_f0));
+        
+        ingest = text_ingest(out, array_count(out), "a\r\nb"_f0, false);
+        assert(str_equals({out, ingest.written}, "a b"_f0));
+        
+        // long ascii runs & clipping at a codepoint boundary
+        String long_text = "The quick brown fox jumps over the lazy dog, twice: żółw!"_f0;
+        ingest = text_ingest(out, 53, long_text, true);
+        assert(ingest.written == 52 && ingest.consumed == 52); // "ż" doesn't fit
+        ingest = text_ingest(out, array_count(out), long_text, true);
+        assert(str_equals({out, ingest.written}, long_text));
+        
+        u8 memory[16];
+        Text_Input text = {};
+        text.buffer.str = memory;
+        text.buffer.cap = array_count(memory);
+        text_input_write(&text, "abcdef"_f0);
+        text.cursor_pos = 1;
+        text.mark_pos = 3;
+        text_input_paste(&text, "X\r\nY"_f0, false);
+        assert(str_equals(text.buffer, "aX Ydef"_f0) && text.cursor_pos == 4);
+        
+        text_input_paste(&text, "0123456789"_f0, false);
+        assert(str_equals(text.buffer, "aX Y012345678def"_f0) && text.cursor_pos == 13);
+        
+        text.mark_pos = 4;
+        text_input_paste(&text, "Q"_f0, false);
+        assert(str_equals(text.buffer, "aX YQdef"_f0) && text.cursor_pos == 5);
+        
+        // multiple cursors
+        Text_Cursor cursors[4];
+        text.cursors = cursors;
+        text.cursor_cap = array_count(cursors);
+        text.cursor_pos = text.mark_pos = 0;
+        text.buffer.size = 0;
+        text_input_write(&text, "ab"_f0);
+        text.cursor_pos = text.mark_pos = 1;
+        text_input_add_cursor(&text, 2, 2);
+        text_input_paste(&text, "\t\x02-"_f0, false);
+        assert(str_equals(text.buffer, "a\t-b\t-"_f0));
+    }
+    
+    {
+        // Characters typed during a frame get written as one edit -
+        //   that has to give the same result as writing them one by one.
+        String typed[] = {"x"_f0, "ź"_f0, "y"_f0};
+        u8 memory_a[16], memory_b[16];
+        Text_Cursor cursors_a[4], cursors_b[4];
+        Text_Input text_a = {};
+        Text_Input text_b = {};
+        text_a.buffer = {memory_a, 0, array_count(memory_a)};
+        text_b.buffer = {memory_b, 0, array_count(memory_b)};
+        text_a.cursors = cursors_a;
+        text_b.cursors = cursors_b;
+        text_a.cursor_cap = text_b.cursor_cap = array_count(cursors_a);
+        
+        text_input_write(&text_a, "abc def"_f0);
+        text_input_write(&text_b, "abc def"_f0);
+        text_a.cursor_pos = text_b.cursor_pos = 1; // selection "bc"
+        text_a.mark_pos = text_b.mark_pos = 3;
+        text_input_add_cursor(&text_a, 7, 7);
+        text_input_add_cursor(&text_b, 7, 7);
+        
+        for_array(i, typed) {
+            text_input_write(&text_a, typed[i]);
+        }
+        text_input_write(&text_b, "xźy"_f0);
+        
+        assert(str_equals(text_a.buffer, "axźy defxźy"_f0));
+        assert(str_equals(text_a.buffer, text_b.buffer));
+        assert(text_a.cursor_pos == text_b.cursor_pos && text_a.cursor_count == text_b.cursor_count);
+    }
+    
+    {
+        // selection set
+        Text_Range ranges[4];
+        Text_Selection_Set set = {ranges, 0, array_count(ranges)};
+        assert(selection_set_insert(&set, {10, 12}));
+        assert(selection_set_insert(&set, {2, 4}));
+        assert(selection_set_insert(&set, {6, 8}));
+        assert(selection_set_insert(&set, {20, 20})); // empty ranges are ignored
+        assert(set.count == 3);
+        assert(selection_set_find(&set, 3) == 0 && selection_set_find(&set, 4) == -1);
+        assert(selection_set_find(&set, 11) == 2 && selection_set_find(&set, 12) == -1);
+        
+        assert(selection_set_insert(&set, {4, 6})); // touching ranges get merged
+        assert(set.count == 2 && ranges[0].start == 2 && ranges[0].one_past_end == 8);
+        assert(selection_set_insert(&set, {1, 11}));
+        assert(set.count == 1 && ranges[0].start == 1 && ranges[0].one_past_end == 12);
+        
+        assert(selection_set_remove(&set, {3, 5})); // split
+        assert(set.count == 2 && ranges[0].one_past_end == 3 && ranges[1].start == 5);
+        assert(selection_set_insert(&set, {14, 15}) && selection_set_insert(&set, {17, 18}));
+        assert(!selection_set_remove(&set, {6, 7})); // no space for the split
+        assert(set.count == 4);
+        assert(selection_set_remove(&set, {0, 15}));
+        assert(set.count == 1 && ranges[0].start == 17);
+        
+        // ranges follow edits
+        u8 memory[32];
+        Text_Input text = {};
+        text.buffer = {memory, 0, array_count(memory)};
+        text_input_write(&text, "one two three"_f0);
+        text.selections = &set;
+        set.count = 0;
+        selection_set_insert(&set, {0, 3});
+        selection_set_insert(&set, {8, 13});
+        
+        text.cursor_pos = 4;
+        text.mark_pos = 7;
+        text_input_write(&text, "2"_f0); // "one 2 three"
+        assert(set.count == 2 && ranges[1].start == 6 && ranges[1].one_past_end == 11);
+        
+        text.cursor_pos = 2;
+        text.mark_pos = 7;
+        text_input_write(&text, "_"_f0); // "on_hree" - ranges get cut and end up touching so they're merged
+        assert(set.count == 1 && ranges[0].start == 0 && ranges[0].one_past_end == 7);
+        
+        // ranges that were replaced completely disappear
+        Text_Edit edits[] = {{5, 5, "!"_f0}, {6, 7, "?"_f0}};
+        selection_set_insert(&set, {8, 9});
+        selection_set_remap(&set, edits, array_count(edits));
+        assert(set.count == 2 && ranges[0].one_past_end == 8 && ranges[1].start == 9);
+        
+        Text_Edit replace_all[] = {{0, 10, "x"_f0}};
+        selection_set_remap(&set, replace_all, array_count(replace_all));
+        assert(set.count == 0);
+        
+        selection_set_insert(&set, {0, 1});
+        text_input_handle_key(&text, {VK_ESCAPE});
+        assert(set.count == 0);
+    }
+    
+    {
+        // layout - edits keep boundaries up to the edit start
+        u8 memory[16];
+        Text_Layout_Boundary boundaries[17];
+        Text_Layout layout = {boundaries, 0, array_count(boundaries)};
+        Text_Input text = {};
+        text.buffer = {memory, 0, array_count(memory)};
+        text.layout = &layout;
+        text_input_write(&text, "abżcd"_f0);
+        
+        // what text_layout_update makes out of it with every glyph 10 units wide
+        s64 starts[] = {0, 1, 2, 4, 5, 6};
+        for_array(i, starts) {
+            boundaries[i] = {starts[i], 10.f*(f32)i};
+        }
+        layout.count = array_count(starts);
+        assert(layout.count == 6 && layout.version == text.version);
+        assert(text_layout_x_of(&layout, 4) == 30.f && text_layout_x_of(&layout, 100) == 50.f);
+        assert(text_layout_last_at_or_before_x(&layout, 25.f) == 2);
+        assert(text_layout_last_at_or_before_x(&layout, -5.f) == 0);
+        
+        text.cursor_pos = text.mark_pos = 4;
+        text_input_write(&text, "x"_f0);
+        assert(layout.count == 3 && layout.version == text.version); // boundaries before 'c' stay
+        
+        text.version += 1; // buffer changed behind the layout's back
+        text_input_write(&text, "y"_f0);
+        assert(layout.count == 0);
+    }
+    
+    {
+        // hit testing - "ab\ncd" with every glyph 10 units wide
+        String text = "ab\ncd"_f0;
+        Text_Layout_Boundary boundaries[6];
+        for_array(i, boundaries) {
+            boundaries[i] = {(s64)i, 10.f*(f32)i};
+        }
+        Text_Layout layout = {boundaries, array_count(boundaries), array_count(boundaries)};
+        
+        assert(text_layout_hit_test(&layout, -20.f) == 0);
+        assert(text_layout_hit_test(&layout, 14.f) == 1);
+        assert(text_layout_hit_test(&layout, 16.f) == 2);
+        assert(text_layout_hit_test(&layout, 1000.f) == 5);
+        
+        s64 line_starts[2];
+        Text_Line_Index lines = {line_starts, 0, array_count(line_starts)};
+        line_index_rebuild(&lines, text);
+        assert(text_layout_hit_test_lines(&layout, &lines, text, 12.f, 15.f, 10.f) == 4);
+        assert(text_layout_hit_test_lines(&layout, &lines, text, 100.f, 0.f, 10.f) == 2); // stays before the new line
+        assert(text_layout_hit_test_lines(&layout, &lines, text, -5.f, 1000.f, 10.f) == 3);
+        
+        boundaries[4].x = boundaries[3].x; // zero width glyph - cursor goes after it
+        assert(text_layout_hit_test(&layout, 28.f) == 4);
+    }
+    
+    {
+        // word wrap - every glyph 10 units wide
+        u8 memory[64];
+        s64 line_starts[65];
+        Text_Line_Index lines = {line_starts, 0, array_count(line_starts)};
+        Text_Layout_Boundary boundaries[65];
+        Text_Layout layout = {boundaries, 0, array_count(boundaries)};
+        s64 row_starts[65];
+        Text_Wrap wrap = {row_starts, 0, array_count(row_starts)};
+        
+        Text_Input text = {};
+        text.buffer = {memory, 0, array_count(memory)};
+        text_input_attach_line_index(&text, &lines);
+        text.layout = &layout;
+        text.wrap = &wrap;
+        
+        auto update = [&](f32 max_width) {
+            for (s64 i = 0; i <= (s64)text.buffer.size; i += 1) {
+                boundaries[i] = {i, 10.f*(f32)i};
+            }
+            layout.count = text.buffer.size + 1;
+            layout.version = text.version;
+            text_wrap_update(&text, max_width);
+        };
+        
+        text_input_write(&text, "aaa bbb ccc\nabcdefghij"_f0);
+        update(75.f);
+        s64 expected[] = {0, 8, 12, 19}; // "aaa bbb |ccc\n|abcdefg|hij"
+        assert(wrap.row_count == array_count(expected));
+        for_array(i, expected) {
+            assert(row_starts[i] == expected[i]);
+        }
+        
+        assert(text_wrap_row_from_pos(&wrap, 8) == 1);
+        assert(text_wrap_row_end(&wrap, text.buffer, 0) == 8 && text_wrap_row_end(&wrap, text.buffer, 1) == 11);
+        assert(text_wrap_hit_test(&wrap, &layout, text.buffer, 1000.f, 5.f, 10.f) == 7); // stays on the soft wrapped row
+        assert(text_wrap_hit_test(&wrap, &layout, text.buffer, 1000.f, 15.f, 10.f) == 11);
+        assert(text_wrap_hit_test(&wrap, &layout, text.buffer, 12.f, 25.f, 10.f) == 13);
+        
+        // only the edited line gets rewrapped - result has to be the same as wrapping everything
+        text.cursor_pos = text.mark_pos = 0;
+        text_input_write(&text, "xxxx "_f0);
+        update(75.f);
+        s64 expected_edit[] = {0, 5, 13, 17, 24}; // "xxxx |aaa bbb |ccc\n|abcdefg|hij"
+        assert(wrap.row_count == array_count(expected_edit));
+        for_array(i, expected_edit) {
+            assert(row_starts[i] == expected_edit[i]);
+        }
+        
+        update(1000.f); // width changed
+        assert(wrap.row_count == 2 && row_starts[1] == 17);
+    }
+    
+    
+    
+    {
+        // bidi - levels & visual order of runs (א = \xD7\x90, ا = \xD8\xA7 in the comments)
+        String in_text[] = {
+            "abc \xD7\x90\xD7\x91 def"_f0, // abc אב def
+            "\xD7\x90\xD7\x91 12 \xD7\x92"_f0, // RTL paragraph with a number
+            "\xD8\xA7 12.5"_f0, // numbers after Arabic letters are Arabic numbers - separator included
+            "abc \xD7\x90 "_f0, // trailing whitespace goes back to the paragraph level
+            "\xE2\x80\xAE" "ab"_f0, // RLO
+            "10$ \xD7\x90"_f0, // terminator next to a number
+        };
+        Bidi_Run out[][3] = {
+            {{0, 4, 0}, {4, 8, 1}, {8, 12, 0}},
+            {{0, 5, 1}, {5, 7, 2}, {7, 10, 1}},
+            {{0, 3, 1}, {3, 7, 2}},
+            {{0, 4, 0}, {4, 6, 1}, {6, 7, 0}},
+            {{0, 5, 1}},
+            {{0, 3, 2}, {3, 6, 1}},
+        };
+        s64 out_count[] = {3, 3, 2, 3, 1, 2};
+        s64 out_visual[][3] = {
+            {0, 1, 2}, {2, 1, 0}, {1, 0}, {0, 1, 2}, {0}, {1, 0},
+        };
+        assert_eq_array_count4(in_text, out, out_count, out_visual);
+        
+        for_array(i, in_text)
+        {
+            u8 scratch[64];
+            Bidi_Run runs[16];
+            s64 visual[16];
+            assert(str_has_rtl(in_text[i]));
+            
+            s64 count = bidi_resolve_runs(in_text[i], 0, scratch, runs, array_count(runs));
+            bidi_reorder_runs(runs, count, visual);
+            assert(count == out_count[i]);
+            for (s64 run = 0; run < count; run += 1)
+            {
+                assert(runs[run].start == out[i][run].start && runs[run].one_past_end == out[i][run].one_past_end);
+                assert(runs[run].level == out[i][run].level);
+                assert(visual[run] == out_visual[i][run]);
+            }
+        }
+        
+        // all-LTR fast path - long text is checked 16 bytes at a time
+        assert(!str_has_rtl("Łabędzie 12 \xE2\x80\xAA ok"_f0)); // LRE doesn't make anything right to left
+        assert(!str_has_rtl("0123456789abcdefghijklmnopqrstuvwxyz \xD6\x80"_f0));
+        assert(str_has_rtl("0123456789abcdefghijklmnopqrstuvwxyz \xD7\x90"_f0));
+        assert(str_has_rtl("\xD9\xA1"_f0)); // Arabic-Indic digit
+    }
+    
+    
+    
+    {
+        // bidi cache - every glyph 10 units wide
+        u8 memory[32];
+        Text_Layout_Boundary boundaries[33];
+        Text_Layout layout = {boundaries, 0, array_count(boundaries)};
+        Bidi_Run runs[32];
+        s64 visual[32], slot_of_run[32];
+        f32 slot_x[32];
+        u8 scratch[3*32];
+        Text_Bidi bidi = {runs, visual, slot_of_run, slot_x, 0, array_count(runs), scratch};
+        
+        Text_Input text = {};
+        text.buffer = {memory, 0, array_count(memory)};
+        text.layout = &layout;
+        text.bidi = &bidi;
+        
+        auto update = [&]() {
+            s64 count = 0;
+            for (s64 pos = 0; pos < (s64)text.buffer.size; pos = str_move_pos_by_codepoints(text.buffer, pos, 1)) {
+                boundaries[count] = {pos, 10.f*(f32)count};
+                count += 1;
+            }
+            boundaries[count] = {(s64)text.buffer.size, 10.f*(f32)count};
+            layout.count = count + 1;
+            layout.version = text.version;
+            text_bidi_update(&text);
+        };
+        
+        text_input_write(&text, "ab\ncd"_f0);
+        update();
+        assert(bidi.count == 2 && !bidi.has_rtl); // one run per paragraph
+        assert(text_bidi_x_of(&bidi, &layout, 4) == 40.f);
+        
+        text_input_write(&text, " \xD7\x90\xD7\x91"_f0); // ab\ncd אב
+        update();
+        assert(bidi.count == 3 && bidi.has_rtl);
+        assert(runs[0].one_past_end == 3 && runs[1].start == 3 && runs[2].start == 6 && runs[2].level == 1);
+        
+        // logical -> visual: אב is drawn from the right, the end of the text is its left edge
+        assert(text_bidi_x_of(&bidi, &layout, 6) == 80.f);
+        assert(text_bidi_x_of(&bidi, &layout, 8) == 70.f);
+        assert(text_bidi_x_of(&bidi, &layout, 10) == 60.f);
+        assert(text_bidi_hit_test(&bidi, &layout, text.buffer, 79.f) == 6);
+        assert(text_bidi_hit_test(&bidi, &layout, text.buffer, 61.f) == 10);
+        
+        // arrows move on the screen
+        assert(text_bidi_move_visually(&bidi, &layout, text.buffer, 5, 1) == 10);
+        assert(text_bidi_move_visually(&bidi, &layout, text.buffer, 10, 1) == 8);
+        assert(text_bidi_move_visually(&bidi, &layout, text.buffer, 8, 1) == 6);
+        assert(text_bidi_move_visually(&bidi, &layout, text.buffer, 6, 1) == 6);
+        assert(text_bidi_move_visually(&bidi, &layout, text.buffer, 10, -1) == 5);
+        
+        // edit in the second paragraph keeps the first one
+        text.cursor_pos = text.mark_pos = 4;
+        text_input_write(&text, "x"_f0);
+        assert(bidi.count == 1 && bidi.resolved_end == 3);
+        update();
+        assert(bidi.count == 3 && runs[2].start == 7 && slot_x[2] == 70.f);
+        
+        text.cursor_pos = text.mark_pos = 0;
+        text_input_write(&text, "\xD7\x92"_f0); // first paragraph becomes right to left
+        assert(bidi.count == 0);
+        update();
+        assert(runs[0].level == 1 && runs[1].level == 2 && visual[0] == 2 && visual[1] == 1 && visual[2] == 0); // גab\n - "ab" on the left of ג
+    }
+}
+
+static void run_regex_unit_tests()
+{
+    static Regex regex; // big - keep it off the stack
+    
+    {
+        assert(regex_compile(&regex, "ab*c"_f0));
+        assert(regex_matches(&regex, "ac"_f0));
+        assert(regex_matches(&regex, "abbbc"_f0));
+        assert(!regex_matches(&regex, "abbb"_f0));
+        assert(!regex_matches(&regex, "abcx"_f0));
+        assert(regex_matches_prefix(&regex, "abb"_f0));
+        assert(!regex_matches_prefix(&regex, "abx"_f0));
+    }
+    
+    {
+        // input mask
+        assert(regex_compile(&regex, "\\d\\d\\d\\d-\\d\\d-\\d\\d"_f0));
+        assert(regex_matches(&regex, "2024-01-31"_f0));
+        assert(regex_matches_prefix(&regex, "2024-0"_f0));
+        assert(!regex_matches_prefix(&regex, "2024x"_f0));
+    }
+    
+    {
+        // classes work on codepoints, not bytes
+        assert(regex_compile(&regex, "[à-ž]+"_f0));
+        assert(regex_matches(&regex, "żółć"_f0));
+        assert(!regex_matches(&regex, "zolc"_f0));
+        
+        assert(regex_compile(&regex, "[^a]"_f0));
+        assert(regex_matches(&regex, "\xF0\x9F\x98\x80"_f0));
+        assert(!regex_matches(&regex, "\xF0\x9F"_f0));
+        assert(!regex_matches(&regex, "\xED\xA0\x80"_f0)); // surrogate
+        
+        assert(regex_compile(&regex, "a.c"_f0));
+        assert(regex_matches(&regex, "aźc"_f0));
+        assert(!regex_matches(&regex, "a\nc"_f0));
+    }
+    
+    {
+        // leftmost-longest search
+        assert(regex_compile(&regex, "ab|abcd|b"_f0));
+        Regex_Match match = regex_find(&regex, "xxabcde"_f0, 0);
+        assert(match.found && match.start == 2 && match.one_past_end == 6);
+        
+        match = regex_find(&regex, "xxabcde"_f0, 3);
+        assert(match.found && match.start == 3 && match.one_past_end == 4);
+        
+        assert(regex_compile(&regex, "\\w+$"_f0));
+        match = regex_find(&regex, "one two three"_f0, 0);
+        assert(match.found && match.start == 8 && match.one_past_end == 13);
+        
+        assert(regex_compile(&regex, "^t"_f0));
+        match = regex_find(&regex, "one two three"_f0, 0);
+        assert(!match.found);
+    }
+    
+    {
+        // invalid patterns
+        assert(!regex_compile(&regex, "(ab"_f0));
+        assert(!regex_compile(&regex, "ab)"_f0));
+        assert(!regex_compile(&regex, "*a"_f0));
+        assert(!regex_compile(&regex, "[a-"_f0));
+        assert(!regex_compile(&regex, "[z-a]"_f0));
+        assert(!regex_matches(&regex, ""_f0));
+    }
+    
+    {
+        // many DFA states - the cache gets flushed and matching falls back to NFA simulation
+        assert(regex_compile(&regex, "(a|b)*a(a|b)(a|b)(a|b)(a|b)(a|b)(a|b)(a|b)"_f0));
+        char text[2048];
+        u32 random = 12345;
+        for (u32 i = 0; i < array_count(text); i += 1) {
+            random = random*1664525 + 1013904223;
+            text[i] = ((random >> 16) & 1 ? 'a' : 'b');
+        }
+        text[array_count(text) - 8] = 'a';
+        assert(regex_matches(&regex, {(u8 *)text, array_count(text)}));
+        text[array_count(text) - 8] = 'b';
+        assert(!regex_matches(&regex, {(u8 *)text, array_count(text)}));
+        assert(regex.dfa_flush_count > 0);
+    }
+}
+
+static void run_input_unit_tests()
+{
+    {
+        // events that don't fit in the ring wait in the overflow array - order is kept
+        static Input_Ring ring;
+        u32 pushed = 0;
+        u32 popped = 0;
+        
+        for (u32 round = 0; round < 3; round += 1)
+        {
+            for (u32 i = 0; i < INPUT_RING_SIZE + 100; i += 1)
+            {
+                Input_Event event = {};
+                event.vk_code = (u8)(pushed % 200 + 1);
+                event.cstr[0] = (char)(pushed / 200);
+                input_ring_push(&ring, event);
+                pushed += 1;
+            }
+            assert(ring.overflow_count > 0);
+            
+            Input_Event event;
+            for (u32 i = 0; i < INPUT_RING_SIZE / 2; i += 1)
+            {
+                assert(input_ring_pop(&ring, &event));
+                assert(event.vk_code == popped % 200 + 1 && event.cstr[0] == (char)(popped / 200));
+                popped += 1;
+            }
+        }
+        
+        Input_Event event;
+        while (popped < pushed)
+        {
+            if (!input_ring_pop(&ring, &event))
+            {
+                // the producer moves waiting events to the ring once there is space
+                assert(ring.overflow_count > 0);
+                input_ring_flush_overflow(&ring);
+                continue;
+            }
+            assert(event.vk_code == popped % 200 + 1 && event.cstr[0] == (char)(popped / 200));
+            popped += 1;
+        }
+        
+        assert(ring.overflow_count == 0);
+        assert(!input_ring_pop(&ring, &event));
+        free(ring.overflow);
+    }
+    
+    {
+        // recording format round trip
+        Input_Event events[4] = {};
+        events[0].vk_code = VK_LEFT;
+        events[0].shift = true;
+        events[0].control = true;
+        events[1].cstr[0] = 'a';
+        memcpy(events[2].cstr, "\xF0\x9F\x98\x80", 4);
+        events[3].vk_code = VK_LBUTTON;
+        events[3].double_click = true;
+        u64 deltas[] = {0, 127, 128, 10000000000ull};
+        
+        u8 memory[8 + array_count(events)*16];
+        u32 header[] = {INPUT_RECORDING_MAGIC, INPUT_RECORDING_VERSION};
+        memcpy(memory, header, sizeof(header));
+        u64 size = sizeof(header);
+        for_array(i, events) {
+            size += input_recording_encode(memory + size, events[i], deltas[i]);
+        }
+        
+        Input_Replay replay = {};
+        assert(input_replay_begin(&replay, {memory, size}));
+        u64 time_us = 0;
+        for_array(i, events)
+        {
+            Input_Event event;
+            assert(input_replay_next(&replay, &event));
+            time_us += deltas[i];
+            assert(replay.time_us == time_us);
+            assert(memcmp(&event, &events[i], sizeof(event)) == 0);
+        }
+        
+        Input_Event event;
+        assert(!input_replay_next(&replay, &event));
+        replay.at -= 1; // truncated recording
+        assert(!input_replay_next(&replay, &event));
+    }
 }
 
+
+static void run_atlas_unit_tests()
+{
+    {
+        // exact fit - 4 squares fill the area, nodes merge back into one
+        Atlas_Skyline skyline;
+        atlas_skyline_reset(&skyline, 100, 50, 20, 20);
+        u16 x, y;
+        assert(atlas_skyline_pack(&skyline, 10, 10, &x, &y) && x == 100 && y == 50);
+        assert(atlas_skyline_pack(&skyline, 10, 10, &x, &y) && x == 110 && y == 50);
+        assert(skyline.node_count == 1 && skyline.nodes[0].y == 60);
+        assert(atlas_skyline_pack(&skyline, 10, 10, &x, &y) && x == 100 && y == 60);
+        assert(atlas_skyline_pack(&skyline, 10, 10, &x, &y) && x == 110 && y == 60);
+        assert(!atlas_skyline_pack(&skyline, 1, 1, &x, &y));
+        assert(!atlas_skyline_pack(&skyline, 21, 1, &x, &y));
+    }
+    
+    {
+        // glyph-like rectangles - no overlaps, everything inside the area & most of it gets used
+        static u8 used[64][256];
+        memset(used, 0, sizeof(used));
+        Atlas_Skyline skyline;
+        atlas_skyline_reset(&skyline, 0, 0, 256, 64);
+        
+        u32 random = 12345;
+        u32 packed_area = 0;
+        u32 fail_count = 0;
+        while (fail_count < 16)
+        {
+            random = random*1664525 + 1013904223;
+            u16 width = (u16)(2 + (random >> 16) % 12);
+            u16 height = (u16)(8 + (random >> 24) % 6);
+            
+            u16 x, y;
+            if (!atlas_skyline_pack(&skyline, width, height, &x, &y))
+            {
+                fail_count += 1;
+                continue;
+            }
+            assert(x + width <= 256 && y + height <= 64);
+            
+            for (u32 row = y; row < (u32)y + height; row += 1) {
+                for (u32 column = x; column < (u32)x + width; column += 1) {
+                    assert(!used[row][column]);
+                    used[row][column] = 1;
+                }
+            }
+            packed_area += width*height;
+            
+            u32 covered = 0;
+            for (u32 node = 0; node < skyline.node_count; node += 1) {
+                assert(skyline.nodes[node].x == covered);
+                covered += skyline.nodes[node].width;
+            }
+            assert(covered == 256);
+        }
+        assert(packed_area > 256*64*3/4);
+    }
+}
@@ -0,0 +1,523 @@
+//
+// Bidirectional text (UAX #9) based on the bidi class table from utf8_unicode_tables.h
+//
+// A paragraph gets resolved to runs of codepoints with the same embedding level - odd levels are right to left.
+// Simplified compared to the full algorithm:
+//   - isolating run sequences are just level runs - text on both sides of an isolate is resolved separately
+//   - bracket pairs (N0) aren't matched & there are no mirrored glyphs (L4)
+//
+
+#define BIDI_MAX_DEPTH 125
+
+struct Bidi_Run
+{
+    s64 start, one_past_end; // byte offsets
+    u8 level;
+};
+
+
+static Bidi_Class bidi_class_property(u32 codepoint)
+{
+    // fast path for ASCII letters & digits
+    if ((codepoint|0x20) >= 'a' && (codepoint|0x20) <= 'z') {
+        return Bidi_L;
+    }
+    if (codepoint >= '0' && codepoint <= '9') {
+        return Bidi_EN;
+    }
+    if (codepoint > 0x10FFFF) {
+        return Bidi_ON; // invalid utf8
+    }
+    
+    Bidi_Class result = (Bidi_Class)unicode_table_lookup(unicode_bidi_class_table,
+                                                         array_count(unicode_bidi_class_table),
+                                                         codepoint);
+    return result;
+}
+
+static b32 bidi_class_can_be_rtl(Bidi_Class value)
+{
+    // Everything that can produce an odd level. LRE & co. only add even levels - they don't change the order.
+    return (value == Bidi_R || value == Bidi_AL || value == Bidi_AN ||
+            value == Bidi_RLE || value == Bidi_RLO || value == Bidi_RLI || value == Bidi_FSI);
+}
+
+static b32 str_has_rtl(String text)
+{
+    // All-LTR fast path - text without any of these doesn't need the bidi algorithm.
+    // Nothing below U+0590 is right to left so only codepoints with lead bytes >= 0xD6 get decoded,
+    //   bytes are checked 16 at a time.
+    __m128i first_rtl_lead = _mm_set1_epi8((char)0xD6);
+    s64 pos = 0;
+    s64 size = (s64)text.size;
+    
+    while (pos < size)
+    {
+        if (size - pos >= 16)
+        {
+            __m128i chunk = _mm_loadu_si128((__m128i *)(text.str + pos));
+            __m128i is_candidate = _mm_cmpeq_epi8(_mm_max_epu8(chunk, first_rtl_lead), chunk);
+            u32 candidate_bits = (u32)_mm_movemask_epi8(is_candidate);
+            if (!candidate_bits)
+            {
+                pos += 16;
+                continue;
+            }
+            pos += find_least_significant_bit(candidate_bits).index;
+        }
+        else if (text.str[pos] < 0xD6)
+        {
+            pos += 1;
+            continue;
+        }
+        
+        Unicode_Consume consume = utf8_consume(text.str + pos, size - pos);
+        if (bidi_class_can_be_rtl(bidi_class_property(consume.codepoint))) {
+            return true;
+        }
+        pos += consume.inc;
+    }
+    
+    return false;
+}
+
+
+
+static s32 bidi_first_strong(u8 *classes, s64 first, s64 one_past_last)
+{
+    // P2 - direction of the first strong codepoint outside of isolates: 0 (L), 1 (R) or -1 if there is none.
+    // Stops at the PDI that closes an isolate started before first (FSI looks only inside of itself).
+    s64 depth = 0;
+    for (s64 index = first; index < one_past_last; index += 1)
+    {
+        switch (classes[index])
+        {
+            case Bidi_L: {
+                if (!depth) { return 0; }
+            } break;
+            
+            case Bidi_R:
+            case Bidi_AL: {
+                if (!depth) { return 1; }
+            } break;
+            
+            case Bidi_LRI:
+            case Bidi_RLI:
+            case Bidi_FSI: {
+                depth += 1;
+            } break;
+            
+            case Bidi_PDI: {
+                if (!depth) { return -1; }
+                depth -= 1;
+            } break;
+        }
+    }
+    return -1;
+}
+
+static b32 bidi_is_neutral_or_isolate(u8 type) { // NI
+    return (type == Bidi_B || type == Bidi_S || type == Bidi_WS || type == Bidi_ON ||
+            type == Bidi_LRI || type == Bidi_RLI || type == Bidi_FSI || type == Bidi_PDI);
+}
+static b32 bidi_is_removed_or_whitespace(u8 type) { // L1 - reset to the paragraph level at the end of a line
+    return (type == Bidi_WS || type == Bidi_BN || (type >= Bidi_LRE && type <= Bidi_PDI));
+}
+
+static s64 bidi_next_index(u8 *types, s64 index, s64 one_past_last)
+{
+    // skips codepoints removed by X9
+    do {
+        index += 1;
+    } while (index < one_past_last && types[index] == Bidi_BN);
+    return index;
+}
+
+static s64 bidi_prev_index(u8 *types, s64 index, s64 first)
+{
+    // returns first - 1 if there is nothing before index
+    do {
+        index -= 1;
+    } while (index >= first && types[index] == Bidi_BN);
+    return index;
+}
+
+static void bidi_resolve_level_run(u8 *types, u8 *levels, s64 first, s64 one_past_last, u8 sos, u8 eos)
+{
+    // W1-W7, N1-N2, I1-I2 on one level run. sos & eos are Bidi_L or Bidi_R.
+    u8 level = levels[first];
+    u8 embedding = ((level & 1) ? Bidi_R : Bidi_L);
+    s64 start = (types[first] == Bidi_BN ? bidi_next_index(types, first, one_past_last) : first);
+    
+    // W1 - NSM takes the type of the previous codepoint
+    u8 prev = sos;
+    for (s64 index = start; index < one_past_last; index = bidi_next_index(types, index, one_past_last))
+    {
+        if (types[index] == Bidi_NSM) {
+            types[index] = (u8)((prev >= Bidi_LRI && prev <= Bidi_PDI) ? Bidi_ON : prev);
+        }
+        prev = types[index];
+    }
+    
+    // W2 - EN after AL becomes AN, W3 - AL becomes R
+    u8 last_strong = sos;
+    for (s64 index = start; index < one_past_last; index = bidi_next_index(types, index, one_past_last))
+    {
+        u8 type = types[index];
+        if (type == Bidi_L || type == Bidi_R || type == Bidi_AL) {
+            last_strong = type;
+        }
+        if (type == Bidi_EN && last_strong == Bidi_AL) {
+            types[index] = Bidi_AN;
+        }
+        if (type == Bidi_AL) {
+            types[index] = Bidi_R;
+        }
+    }
+    
+    // W4 - single separator between two numbers of the same type
+    for (s64 index = start; index < one_past_last; index = bidi_next_index(types, index, one_past_last))
+    {
+        u8 type = types[index];
+        if (type != Bidi_ES && type != Bidi_CS) {
+            continue;
+        }
+        s64 prev_index = bidi_prev_index(types, index, start);
+        s64 next_index = bidi_next_index(types, index, one_past_last);
+        if (prev_index < start || next_index >= one_past_last) {
+            continue;
+        }
+        
+        u8 before = types[prev_index];
+        u8 after = types[next_index];
+        if (before == after && (before == Bidi_EN || (before == Bidi_AN && type == Bidi_CS))) {
+            types[index] = before;
+        }
+    }
+    
+    // W5 - terminators next to European numbers, W6 - other separators & terminators become ON
+    for (s64 index = start; index < one_past_last;)
+    {
+        u8 type = types[index];
+        if (type != Bidi_ET)
+        {
+            if (type == Bidi_ES || type == Bidi_CS) {
+                types[index] = Bidi_ON;
+            }
+            index = bidi_next_index(types, index, one_past_last);
+            continue;
+        }
+        
+        s64 end = index;
+        while (end < one_past_last && types[end] == Bidi_ET) {
+            end = bidi_next_index(types, end, one_past_last);
+        }
+        s64 prev_index = bidi_prev_index(types, index, start);
+        b32 touches_number = ((prev_index >= start && types[prev_index] == Bidi_EN) ||
+                              (end < one_past_last && types[end] == Bidi_EN));
+        
+        for (s64 at = index; at < end; at = bidi_next_index(types, at, one_past_last)) {
+            types[at] = (touches_number ? Bidi_EN : Bidi_ON);
+        }
+        index = end;
+    }
+    
+    // W7 - European numbers after L become L
+    last_strong = sos;
+    for (s64 index = start; index < one_past_last; index = bidi_next_index(types, index, one_past_last))
+    {
+        u8 type = types[index];
+        if (type == Bidi_L || type == Bidi_R) {
+            last_strong = type;
+        }
+        if (type == Bidi_EN && last_strong == Bidi_L) {
+            types[index] = Bidi_L;
+        }
+    }
+    
+    // N1, N2 - neutrals take the direction of their surroundings if it's the same on both sides
+    //   (numbers count as R), otherwise the embedding direction
+    for (s64 index = start; index < one_past_last;)
+    {
+        if (!bidi_is_neutral_or_isolate(types[index]))
+        {
+            index = bidi_next_index(types, index, one_past_last);
+            continue;
+        }
+        
+        s64 end = index;
+        while (end < one_past_last && bidi_is_neutral_or_isolate(types[end])) {
+            end = bidi_next_index(types, end, one_past_last);
+        }
+        s64 prev_index = bidi_prev_index(types, index, start);
+        u8 before = (u8)(prev_index >= start ? (types[prev_index] == Bidi_L ? Bidi_L : Bidi_R) : sos);
+        u8 after = (u8)(end < one_past_last ? (types[end] == Bidi_L ? Bidi_L : Bidi_R) : eos);
+        u8 resolved = (before == after ? before : embedding);
+        
+        for (s64 at = index; at < end; at = bidi_next_index(types, at, one_past_last)) {
+            types[at] = resolved;
+        }
+        index = end;
+    }
+    
+    // I1, I2 - implicit levels
+    for (s64 index = start; index < one_past_last; index = bidi_next_index(types, index, one_past_last))
+    {
+        u8 type = types[index];
+        if (!(level & 1))
+        {
+            if (type == Bidi_R) { levels[index] = (u8)(level + 1); }
+            else if (type == Bidi_AN || type == Bidi_EN) { levels[index] = (u8)(level + 2); }
+        }
+        else if (type == Bidi_L || type == Bidi_EN || type == Bidi_AN)
+        {
+            levels[index] = (u8)(level + 1);
+        }
+    }
+}
+
+static s64 bidi_resolve_runs(String paragraph, s64 offset, u8 *scratch, Bidi_Run *out, s64 out_cap)
+{
+    // Resolves levels of a single paragraph (only its last codepoint can be a paragraph separator).
+    // Runs are in logical order with byte offsets shifted by offset. Returns count of runs.
+    // scratch needs 3 bytes per byte of the paragraph, out at most one run per codepoint.
+    s64 size = (s64)paragraph.size;
+    u8 *classes = scratch;
+    u8 *types = scratch + size;
+    u8 *levels = scratch + 2*size;
+    
+    s64 count = 0;
+    for (s64 pos = 0; pos < size; count += 1)
+    {
+        Unicode_Consume consume = utf8_consume(paragraph.str + pos, size - pos);
+        classes[count] = bidi_class_property(consume.codepoint);
+        pos += consume.inc;
+    }
+    
+    // P2, P3
+    u8 paragraph_level = (bidi_first_strong(classes, 0, count) == 1 ? 1 : 0);
+    
+    
+    // X1-X9 - explicit embeddings, overrides & isolates
+    struct Bidi_Status
+    {
+        u8 level;
+        u8 override; // Bidi_L, Bidi_R or Bidi_ON if there is none
+        b32 isolate;
+    };
+    Bidi_Status stack[BIDI_MAX_DEPTH + 2];
+    s32 depth = 0;
+    stack[0] = {paragraph_level, Bidi_ON, false};
+    s32 overflow_isolates = 0;
+    s32 overflow_embeddings = 0;
+    s32 valid_isolates = 0;
+    
+    for (s64 index = 0; index < count; index += 1)
+    {
+        u8 type = classes[index];
+        Bidi_Status status = stack[depth];
+        types[index] = type;
+        levels[index] = status.level;
+        
+        switch (type)
+        {
+            case Bidi_LRE:
+            case Bidi_RLE:
+            case Bidi_LRO:
+            case Bidi_RLO:
+            case Bidi_LRI:
+            case Bidi_RLI:
+            case Bidi_FSI: {
+                b32 is_isolate = (type >= Bidi_LRI);
+                b32 is_rtl = (type == Bidi_RLE || type == Bidi_RLO || type == Bidi_RLI);
+                if (type == Bidi_FSI) {
+                    is_rtl = (bidi_first_strong(classes, index + 1, count) == 1);
+                }
+                
+                if (!is_isolate) {
+                    types[index] = Bidi_BN; // X9
+                } else if (status.override != Bidi_ON) {
+                    types[index] = status.override;
+                }
+                
+                u8 level = (u8)(is_rtl ? (status.level + 1) | 1 : (status.level + 2) & ~1);
+                if (level <= BIDI_MAX_DEPTH && !overflow_isolates && !overflow_embeddings)
+                {
+                    u8 override = (type == Bidi_LRO ? Bidi_L : type == Bidi_RLO ? Bidi_R : Bidi_ON);
+                    stack[++depth] = {level, override, is_isolate};
+                    valid_isolates += (is_isolate ? 1 : 0);
+                }
+                else if (is_isolate)
+                {
+                    overflow_isolates += 1;
+                }
+                else if (!overflow_isolates)
+                {
+                    overflow_embeddings += 1;
+                }
+            } break;
+            
+            case Bidi_PDI: {
+                if (overflow_isolates)
+                {
+                    overflow_isolates -= 1;
+                }
+                else if (valid_isolates)
+                {
+                    overflow_embeddings = 0;
+                    while (!stack[depth].isolate) {
+                        depth -= 1;
+                    }
+                    depth -= 1;
+                    valid_isolates -= 1;
+                }
+                
+                status = stack[depth];
+                levels[index] = status.level;
+                if (status.override != Bidi_ON) {
+                    types[index] = status.override;
+                }
+            } break;
+            
+            case Bidi_PDF: {
+                types[index] = Bidi_BN; // X9
+                if (overflow_isolates) {
+                    // nothing
+                } else if (overflow_embeddings) {
+                    overflow_embeddings -= 1;
+                } else if (!status.isolate && depth > 0) {
+                    depth -= 1;
+                }
+            } break;
+            
+            case Bidi_B: {
+                levels[index] = paragraph_level;
+            } break;
+            
+            case Bidi_BN: break;
+            
+            default: {
+                if (status.override != Bidi_ON) {
+                    types[index] = status.override;
+                }
+            } break;
+        }
+    }
+    
+    // codepoints removed by X9 stay with the level of the previous one (the first ones with the next one)
+    {
+        s64 first_kept = bidi_next_index(types, -1, count);
+        u8 level = (first_kept < count ? levels[first_kept] : paragraph_level);
+        for (s64 index = 0; index < count; index += 1)
+        {
+            if (types[index] == Bidi_BN) {
+                levels[index] = level;
+            }
+            level = levels[index];
+        }
+    }
+    
+    
+    // X10 - level runs with their start & end of sequence types
+    // Implicit levels of a run are written before the next one starts - so the previous level is remembered.
+    u8 level_before = paragraph_level;
+    for (s64 first = 0; first < count;)
+    {
+        s64 end = first + 1;
+        while (end < count && levels[end] == levels[first]) {
+            end += 1;
+        }
+        
+        u8 level = levels[first];
+        u8 level_after = (end < count ? levels[end] : paragraph_level);
+        u8 sos = ((get_max(level, level_before) & 1) ? Bidi_R : Bidi_L);
+        u8 eos = ((get_max(level, level_after) & 1) ? Bidi_R : Bidi_L);
+        
+        bidi_resolve_level_run(types, levels, first, end, sos, eos);
+        level_before = level;
+        first = end;
+    }
+    
+    // levels of removed codepoints again - implicit levels could change around them
+    for (s64 index = 1; index < count; index += 1)
+    {
+        if (types[index] == Bidi_BN) {
+            levels[index] = levels[index - 1];
+        }
+    }
+    
+    // L1 - separators & whitespace at the end of the paragraph go back to the paragraph level
+    b32 reset = true;
+    for (s64 index = count - 1; index >= 0; index -= 1)
+    {
+        u8 type = classes[index];
+        if (type == Bidi_S || type == Bidi_B) {
+            reset = true;
+        } else if (!bidi_is_removed_or_whitespace(type)) {
+            reset = false;
+        }
+        
+        if (reset) {
+            levels[index] = paragraph_level;
+        }
+    }
+    
+    
+    // codepoints -> runs of bytes
+    s64 run_count = 0;
+    s64 pos = 0;
+    for (s64 index = 0; index < count; index += 1)
+    {
+        Unicode_Consume consume = utf8_consume(paragraph.str + pos, size - pos);
+        if (run_count && out[run_count - 1].level == levels[index])
+        {
+            out[run_count - 1].one_past_end += consume.inc;
+        }
+        else
+        {
+            assert(run_count < out_cap);
+            out[run_count++] = {offset + pos, offset + pos + consume.inc, levels[index]};
+        }
+        pos += consume.inc;
+    }
+    
+    return run_count;
+}
+
+static void bidi_reorder_runs(Bidi_Run *runs, s64 count, s64 *out_visual)
+{
+    // L2 - out_visual[i] is the index of the run that is i-th from the left.
+    // From the highest level down to the lowest odd one every sequence at that level or higher gets reversed.
+    u8 max_level = 0;
+    u8 min_level = 0xFF;
+    for (s64 index = 0; index < count; index += 1)
+    {
+        out_visual[index] = index;
+        max_level = get_max(max_level, runs[index].level);
+        min_level = get_min(min_level, runs[index].level);
+    }
+    
+    for (s32 level = max_level; level >= (min_level | 1); level -= 1)
+    {
+        for (s64 first = 0; first < count;)
+        {
+            if (runs[out_visual[first]].level < level)
+            {
+                first += 1;
+                continue;
+            }
+            
+            s64 end = first;
+            while (end < count && runs[out_visual[end]].level >= level) {
+                end += 1;
+            }
+            for (s64 a = first, b = end - 1; a < b; a += 1, b -= 1)
+            {
+                s64 temp = out_visual[a];
+                out_visual[a] = out_visual[b];
+                out_visual[b] = temp;
+            }
+            first = end;
+        }
+    }
+}
@@ -0,0 +1,1002 @@
+//
+// Regular expressions that work directly on utf8 bytes
+//
+// Patterns compile to a Thompson NFA over byte ranges (codepoint ranges are split into utf8 byte sequences).
+// DFA states are built lazily from sets of NFA instructions and cached. When the cache is full it gets
+//   flushed - if that happens too often matching falls back to NFA simulation.
+// No backtracking - matching time is linear in the text size.
+//
+// Syntax: literals, . [abc] [^a-z] \d \w \s \D \W \S, escapes (\. \\ \n \t ...),
+//   groups ( ), alternation |, repetition * + ?, ^ and $ at the start/end of the pattern.
+// Search is leftmost-longest.
+//
+
+#define REGEX_MAX_INSTS 1024
+#define REGEX_MAX_CLASS_RANGES 64
+#define REGEX_DFA_MAX_STATES 64
+#define REGEX_DFA_POOL_SIZE 4096
+#define REGEX_DFA_MAX_FLUSHES 8 // per run - after that NFA simulation takes over
+
+enum Regex_Op : u8
+{
+    RegexOp_Byte, // byte in [lo, hi] -> x
+    RegexOp_Split, // -> x and y
+    RegexOp_Jump, // -> x
+    RegexOp_Match,
+};
+
+struct Regex_Inst
+{
+    Regex_Op op;
+    u8 lo, hi;
+    u16 x, y;
+};
+
+struct Regex_Set
+{
+    // sparse set of instruction indices
+    u16 dense[REGEX_MAX_INSTS];
+    u16 sparse[REGEX_MAX_INSTS];
+    u32 count;
+};
+
+struct Regex_Dfa_State
+{
+    s16 next[256]; // -1 if not computed yet
+    u16 pool_offset, inst_count; // Byte and Match instructions of this state
+    b8 is_match;
+    b8 unanchored; // start state is added after every byte
+};
+
+struct Regex
+{
+    Regex_Inst insts[REGEX_MAX_INSTS];
+    u16 inst_count;
+    u16 start;
+    b32 valid;
+    b32 anchored_start, anchored_end; // ^ and $
+    
+    Regex_Dfa_State dfa_states[REGEX_DFA_MAX_STATES];
+    u16 dfa_pool[REGEX_DFA_POOL_SIZE];
+    s32 dfa_state_count, dfa_pool_used;
+    u64 dfa_flush_count; // statistics
+    
+    // scratch memory for matching
+    Regex_Set sets[2];
+    u16 stack[2*REGEX_MAX_INSTS + 1];
+    s64 thread_starts[2][REGEX_MAX_INSTS];
+};
+
+struct Regex_Match
+{
+    b32 found;
+    s64 start, one_past_end;
+};
+
+
+
+//
+// Compilation
+//
+
+#define REGEX_NO_HOLE 0xFFFF
+
+struct Regex_Fragment
+{
+    u16 start;
+    u16 holes; // linked list of unpatched outputs: (inst_index << 1) | use_y
+};
+
+struct Regex_Range
+{
+    u32 lo, hi;
+};
+
+struct Regex_Parser
+{
+    Regex *regex;
+    String pattern;
+    b32 error;
+};
+
+
+static u16 *regex_hole_field(Regex *regex, u16 hole)
+{
+    Regex_Inst *inst = regex->insts + (hole >> 1);
+    return (hole & 1 ? &inst->y : &inst->x);
+}
+
+static void regex_patch(Regex *regex, u16 holes, u16 target)
+{
+    while (holes != REGEX_NO_HOLE)
+    {
+        u16 *field = regex_hole_field(regex, holes);
+        holes = *field;
+        *field = target;
+    }
+}
+
+static u16 regex_append_holes(Regex *regex, u16 a, u16 b)
+{
+    if (a == REGEX_NO_HOLE) {
+        return b;
+    }
+    
+    u16 last = a;
+    while (*regex_hole_field(regex, last) != REGEX_NO_HOLE) {
+        last = *regex_hole_field(regex, last);
+    }
+    *regex_hole_field(regex, last) = b;
+    return a;
+}
+
+static u16 regex_emit(Regex_Parser *parser, Regex_Op op, u8 lo = 0, u8 hi = 0)
+{
+    Regex *regex = parser->regex;
+    if (regex->inst_count >= REGEX_MAX_INSTS)
+    {
+        parser->error = true;
+        return 0;
+    }
+    
+    u16 index = regex->inst_count++;
+    regex->insts[index] = {op, lo, hi, REGEX_NO_HOLE, REGEX_NO_HOLE};
+    return index;
+}
+
+
+static Regex_Fragment regex_fragment_empty(Regex_Parser *parser)
+{
+    u16 jump = regex_emit(parser, RegexOp_Jump);
+    return {jump, (u16)(jump << 1)};
+}
+
+static Regex_Fragment regex_fragment_concat(Regex_Parser *parser, Regex_Fragment a, Regex_Fragment b)
+{
+    if (parser->error) {
+        return a;
+    }
+    regex_patch(parser->regex, a.holes, b.start);
+    return {a.start, b.holes};
+}
+
+static Regex_Fragment regex_fragment_alternate(Regex_Parser *parser, Regex_Fragment a, Regex_Fragment b)
+{
+    u16 split = regex_emit(parser, RegexOp_Split);
+    if (parser->error) {
+        return a;
+    }
+    parser->regex->insts[split].x = a.start;
+    parser->regex->insts[split].y = b.start;
+    return {split, regex_append_holes(parser->regex, a.holes, b.holes)};
+}
+
+static Regex_Fragment regex_fragment_repeat(Regex_Parser *parser, Regex_Fragment a, u8 op)
+{
+    // op is one of: * + ?
+    u16 split = regex_emit(parser, RegexOp_Split);
+    if (parser->error) {
+        return a;
+    }
+    
+    Regex *regex = parser->regex;
+    regex->insts[split].x = a.start;
+    u16 split_hole = (u16)((split << 1) | 1);
+    
+    Regex_Fragment result = {};
+    if (op == '?')
+    {
+        result = {split, regex_append_holes(regex, a.holes, split_hole)};
+    }
+    else
+    {
+        regex_patch(regex, a.holes, split);
+        result = {(op == '*' ? split : a.start), split_hole};
+    }
+    return result;
+}
+
+
+static Regex_Fragment regex_fragment_bytes(Regex_Parser *parser, u8 *lo, u8 *hi, u32 count)
+{
+    // sequence of byte ranges
+    Regex_Fragment result = {};
+    for (u32 index = 0; index < count; index += 1)
+    {
+        u16 byte = regex_emit(parser, RegexOp_Byte, lo[index], hi[index]);
+        Regex_Fragment fragment = {byte, (u16)(byte << 1)};
+        result = (index ? regex_fragment_concat(parser, result, fragment) : fragment);
+    }
+    return result;
+}
+
+static void regex_utf8_sequences(Regex_Parser *parser, u32 lo, u32 hi,
+                                 Regex_Fragment *result, b32 *has_result)
+{
+    // Splits a codepoint range into ranges that can be matched byte by byte
+    //   and adds them as alternatives to result.
+    if (lo > hi || parser->error) {
+        return;
+    }
+    
+    u32 length_limits[] = {0x7F, 0x7FF, 0xFFFF};
+    for (u32 limit_index = 0; limit_index < array_count(length_limits); limit_index += 1)
+    {
+        u32 limit = length_limits[limit_index];
+        if (lo <= limit && hi > limit)
+        {
+            regex_utf8_sequences(parser, lo, limit, result, has_result);
+            regex_utf8_sequences(parser, limit + 1, hi, result, has_result);
+            return;
+        }
+    }
+    
+    for (u32 continuation_count = 1; continuation_count < 4; continuation_count += 1)
+    {
+        u32 mask = (1u << (6*continuation_count)) - 1;
+        if ((lo & ~mask) != (hi & ~mask))
+        {
+            if (lo & mask)
+            {
+                regex_utf8_sequences(parser, lo, lo | mask, result, has_result);
+                regex_utf8_sequences(parser, (lo | mask) + 1, hi, result, has_result);
+                return;
+            }
+            if ((hi & mask) != mask)
+            {
+                regex_utf8_sequences(parser, lo, (hi & ~mask) - 1, result, has_result);
+                regex_utf8_sequences(parser, hi & ~mask, hi, result, has_result);
+                return;
+            }
+        }
+    }
+    
+    u8 lo_bytes[4], hi_bytes[4];
+    u32 count = utf8_write(lo_bytes, lo);
+    utf8_write(hi_bytes, hi);
+    
+    Regex_Fragment sequence = regex_fragment_bytes(parser, lo_bytes, hi_bytes, count);
+    *result = (*has_result ? regex_fragment_alternate(parser, *result, sequence) : sequence);
+    *has_result = true;
+}
+
+static Regex_Fragment regex_fragment_ranges(Regex_Parser *parser, Regex_Range *ranges, u32 range_count, b32 negate)
+{
+    // sort & merge
+    for (u32 i = 1; i < range_count; i += 1)
+    {
+        for (u32 j = i; j > 0 && ranges[j - 1].lo > ranges[j].lo; j -= 1)
+        {
+            Regex_Range temp = ranges[j];
+            ranges[j] = ranges[j - 1];
+            ranges[j - 1] = temp;
+        }
+    }
+    
+    Regex_Range merged[REGEX_MAX_CLASS_RANGES + 1];
+    u32 merged_count = 0;
+    for (u32 range_index = 0; range_index < range_count; range_index += 1)
+    {
+        Regex_Range range = ranges[range_index];
+        if (merged_count && range.lo <= merged[merged_count - 1].hi + 1) {
+            merged[merged_count - 1].hi = get_max(merged[merged_count - 1].hi, range.hi);
+        } else {
+            merged[merged_count++] = range;
+        }
+    }
+    
+    if (negate)
+    {
+        Regex_Range inverted[REGEX_MAX_CLASS_RANGES + 1];
+        u32 inverted_count = 0;
+        u32 next_lo = 0;
+        for (u32 range_index = 0; range_index < merged_count; range_index += 1)
+        {
+            if (merged[range_index].lo > next_lo) {
+                inverted[inverted_count++] = {next_lo, merged[range_index].lo - 1};
+            }
+            next_lo = merged[range_index].hi + 1;
+        }
+        if (next_lo <= 0x10FFFF) {
+            inverted[inverted_count++] = {next_lo, 0x10FFFF};
+        }
+        
+        memcpy(merged, inverted, inverted_count*sizeof(Regex_Range));
+        merged_count = inverted_count;
+    }
+    
+    Regex_Fragment result = {};
+    b32 has_result = false;
+    for (u32 range_index = 0; range_index < merged_count; range_index += 1)
+    {
+        // surrogates aren't valid utf8
+        Regex_Range range = merged[range_index];
+        if (range.lo < 0xD800 || range.hi > 0xDFFF)
+        {
+            if (range.lo >= 0xD800 && range.lo <= 0xDFFF) {
+                range.lo = 0xE000;
+            }
+            if (range.hi >= 0xD800 && range.hi <= 0xDFFF) {
+                range.hi = 0xD7FF;
+            }
+            
+            if (range.lo < 0xD800 && range.hi > 0xDFFF)
+            {
+                regex_utf8_sequences(parser, range.lo, 0xD7FF, &result, &has_result);
+                regex_utf8_sequences(parser, 0xE000, range.hi, &result, &has_result);
+            }
+            else
+            {
+                regex_utf8_sequences(parser, range.lo, range.hi, &result, &has_result);
+            }
+        }
+    }
+    
+    if (!has_result)
+    {
+        // empty class - can never match
+        u16 never = regex_emit(parser, RegexOp_Byte, 1, 0);
+        result = {never, (u16)(never << 1)};
+    }
+    return result;
+}
+
+
+static u32 regex_parse_class_escape(u8 c, Regex_Range *ranges, b32 *negate)
+{
+    // returns count of ranges for \d \w \s (and their negations) - 0 if it's not a class escape
+    u32 count = 0;
+    *negate = (c == 'D' || c == 'W' || c == 'S');
+    
+    switch (c | 0x20)
+    {
+        case 'd': {
+            ranges[count++] = {'0', '9'};
+        } break;
+        
+        case 'w': {
+            ranges[count++] = {'0', '9'};
+            ranges[count++] = {'A', 'Z'};
+            ranges[count++] = {'a', 'z'};
+            ranges[count++] = {'_', '_'};
+        } break;
+        
+        case 's': {
+            ranges[count++] = {'\t', '\r'};
+            ranges[count++] = {' ', ' '};
+        } break;
+    }
+    return count;
+}
+
+static u32 regex_parse_escaped_codepoint(u8 c)
+{
+    switch (c)
+    {
+        case 'n': return '\n';
+        case 't': return '\t';
+        case 'r': return '\r';
+        case 'f': return '\f';
+        case 'v': return '\v';
+        case '0': return 0;
+    }
+    return c;
+}
+
+static u32 regex_parser_next_codepoint(Regex_Parser *parser)
+{
+    Unicode_Consume consume = utf8_consume(parser->pattern);
+    parser->pattern = str_skip(parser->pattern, consume.inc);
+    if (consume.codepoint > 0x10FFFF) {
+        parser->error = true;
+    }
+    return consume.codepoint;
+}
+
+static Regex_Fragment regex_parse_class(Regex_Parser *parser)
+{
+    // '[' was already consumed
+    Regex_Range ranges[REGEX_MAX_CLASS_RANGES];
+    u32 range_count = 0;
+    b32 negate = false;
+    
+    if (parser->pattern.size && parser->pattern.str[0] == '^')
+    {
+        negate = true;
+        parser->pattern = str_skip(parser->pattern, 1);
+    }
+    
+    b32 first = true;
+    while (!parser->error)
+    {
+        if (!parser->pattern.size)
+        {
+            parser->error = true; // missing ]
+            break;
+        }
+        
+        u8 c = parser->pattern.str[0];
+        if (c == ']' && !first)
+        {
+            parser->pattern = str_skip(parser->pattern, 1);
+            break;
+        }
+        first = false;
+        
+        if (range_count + 4 > REGEX_MAX_CLASS_RANGES)
+        {
+            parser->error = true;
+            break;
+        }
+        
+        u32 lo = 0;
+        if (c == '\\' && parser->pattern.size >= 2)
+        {
+            u8 escaped = parser->pattern.str[1];
+            parser->pattern = str_skip(parser->pattern, 2);
+            
+            b32 escape_negate = false;
+            u32 escape_count = regex_parse_class_escape(escaped, ranges + range_count, &escape_negate);
+            if (escape_count)
+            {
+                if (escape_negate) {
+                    parser->error = true; // \D \W \S inside of [] aren't supported
+                }
+                range_count += escape_count;
+                continue;
+            }
+            lo = regex_parse_escaped_codepoint(escaped);
+        }
+        else
+        {
+            lo = regex_parser_next_codepoint(parser);
+        }
+        
+        u32 hi = lo;
+        if (parser->pattern.size >= 2 && parser->pattern.str[0] == '-' && parser->pattern.str[1] != ']')
+        {
+            parser->pattern = str_skip(parser->pattern, 1);
+            if (parser->pattern.str[0] == '\\' && parser->pattern.size >= 2)
+            {
+                hi = regex_parse_escaped_codepoint(parser->pattern.str[1]);
+                parser->pattern = str_skip(parser->pattern, 2);
+            }
+            else
+            {
+                hi = regex_parser_next_codepoint(parser);
+            }
+            
+            if (hi < lo) {
+                parser->error = true;
+            }
+        }
+        
+        ranges[range_count++] = {lo, hi};
+    }
+    
+    return regex_fragment_ranges(parser, ranges, range_count, negate);
+}
+
+
+static Regex_Fragment regex_parse_alternation(Regex_Parser *parser, s32 depth);
+
+static Regex_Fragment regex_parse_atom(Regex_Parser *parser, s32 depth)
+{
+    u8 c = parser->pattern.str[0];
+    
+    if (c == '(')
+    {
+        parser->pattern = str_skip(parser->pattern, 1);
+        Regex_Fragment result = regex_parse_alternation(parser, depth + 1);
+        if (!parser->pattern.size || parser->pattern.str[0] != ')') {
+            parser->error = true;
+        } else {
+            parser->pattern = str_skip(parser->pattern, 1);
+        }
+        return result;
+    }
+    
+    if (c == '.')
+    {
+        parser->pattern = str_skip(parser->pattern, 1);
+        Regex_Range new_line = {'\n', '\n'};
+        return regex_fragment_ranges(parser, &new_line, 1, true);
+    }
+    
+    if (c == '[')
+    {
+        parser->pattern = str_skip(parser->pattern, 1);
+        return regex_parse_class(parser);
+    }
+    
+    if (c == '*' || c == '+' || c == '?' || c == ')' || c == '|')
+    {
+        parser->error = true;
+        return {};
+    }
+    
+    u32 codepoint = 0;
+    if (c == '\\')
+    {
+        if (parser->pattern.size < 2)
+        {
+            parser->error = true;
+            return {};
+        }
+        
+        u8 escaped = parser->pattern.str[1];
+        parser->pattern = str_skip(parser->pattern, 2);
+        
+        Regex_Range ranges[4];
+        b32 negate = false;
+        u32 range_count = regex_parse_class_escape(escaped, ranges, &negate);
+        if (range_count) {
+            return regex_fragment_ranges(parser, ranges, range_count, negate);
+        }
+        codepoint = regex_parse_escaped_codepoint(escaped);
+    }
+    else
+    {
+        codepoint = regex_parser_next_codepoint(parser);
+    }
+    
+    u8 bytes[4];
+    u32 count = utf8_write(bytes, codepoint);
+    return regex_fragment_bytes(parser, bytes, bytes, count);
+}
+
+static Regex_Fragment regex_parse_concatenation(Regex_Parser *parser, s32 depth)
+{
+    Regex_Fragment result = {};
+    b32 has_result = false;
+    
+    while (!parser->error && parser->pattern.size)
+    {
+        u8 c = parser->pattern.str[0];
+        if (c == '|' || c == ')') {
+            break;
+        }
+        if (c == '$' && parser->pattern.size == 1 && depth == 0) {
+            break; // end anchor
+        }
+        
+        Regex_Fragment atom = regex_parse_atom(parser, depth);
+        while (!parser->error && parser->pattern.size)
+        {
+            u8 op = parser->pattern.str[0];
+            if (op != '*' && op != '+' && op != '?') {
+                break;
+            }
+            atom = regex_fragment_repeat(parser, atom, op);
+            parser->pattern = str_skip(parser->pattern, 1);
+        }
+        
+        result = (has_result ? regex_fragment_concat(parser, result, atom) : atom);
+        has_result = true;
+    }
+    
+    if (!has_result) {
+        result = regex_fragment_empty(parser);
+    }
+    return result;
+}
+
+static Regex_Fragment regex_parse_alternation(Regex_Parser *parser, s32 depth)
+{
+    if (depth > 100)
+    {
+        parser->error = true;
+        return {};
+    }
+    
+    Regex_Fragment result = regex_parse_concatenation(parser, depth);
+    while (!parser->error && parser->pattern.size && parser->pattern.str[0] == '|')
+    {
+        parser->pattern = str_skip(parser->pattern, 1);
+        Regex_Fragment other = regex_parse_concatenation(parser, depth);
+        result = regex_fragment_alternate(parser, result, other);
+    }
+    return result;
+}
+
+
+static void regex_dfa_flush(Regex *regex)
+{
+    regex->dfa_state_count = 0;
+    regex->dfa_pool_used = 0;
+    regex->dfa_flush_count += 1;
+}
+
+static b32 regex_compile(Regex *regex, String pattern)
+{
+    regex->inst_count = 0;
+    regex->dfa_state_count = 0;
+    regex->dfa_pool_used = 0;
+    regex->dfa_flush_count = 0;
+    
+    Regex_Parser parser = {};
+    parser.regex = regex;
+    parser.pattern = pattern;
+    
+    regex->anchored_start = (pattern.size && pattern.str[0] == '^');
+    if (regex->anchored_start) {
+        parser.pattern = str_skip(parser.pattern, 1);
+    }
+    
+    Regex_Fragment fragment = regex_parse_alternation(&parser, 0);
+    
+    regex->anchored_end = false;
+    if (parser.pattern.size == 1 && parser.pattern.str[0] == '$')
+    {
+        regex->anchored_end = true;
+        parser.pattern = str_skip(parser.pattern, 1);
+    }
+    if (parser.pattern.size) {
+        parser.error = true; // unmatched ')'
+    }
+    
+    u16 match = regex_emit(&parser, RegexOp_Match);
+    if (!parser.error)
+    {
+        regex_patch(regex, fragment.holes, match);
+        regex->start = fragment.start;
+    }
+    
+    regex->valid = !parser.error;
+    return regex->valid;
+}
+
+
+
+//
+// Matching
+//
+
+static void regex_set_clear(Regex_Set *set)
+{
+    set->count = 0;
+}
+
+static b32 regex_set_contains(Regex_Set *set, u16 inst)
+{
+    u16 dense_index = set->sparse[inst];
+    return (dense_index < set->count && set->dense[dense_index] == inst);
+}
+
+static b32 regex_set_add(Regex_Set *set, u16 inst)
+{
+    if (regex_set_contains(set, inst)) {
+        return false;
+    }
+    set->sparse[inst] = (u16)set->count;
+    set->dense[set->count++] = inst;
+    return true;
+}
+
+static void regex_add_closure(Regex *regex, Regex_Set *set, u16 inst, s64 *starts, s64 start)
+{
+    // Follows Split/Jump instructions. starts is optional (per thread match start for NFA search).
+    u32 stack_count = 0;
+    regex->stack[stack_count++] = inst;
+    
+    while (stack_count)
+    {
+        u16 index = regex->stack[--stack_count];
+        if (!regex_set_add(set, index)) {
+            continue;
+        }
+        if (starts) {
+            starts[index] = start;
+        }
+        
+        Regex_Inst *current = regex->insts + index;
+        if (current->op == RegexOp_Split)
+        {
+            regex->stack[stack_count++] = current->y;
+            regex->stack[stack_count++] = current->x;
+        }
+        else if (current->op == RegexOp_Jump)
+        {
+            regex->stack[stack_count++] = current->x;
+        }
+    }
+}
+
+static void regex_step(Regex *regex, Regex_Set *from, Regex_Set *to, u8 byte)
+{
+    regex_set_clear(to);
+    for (u32 dense_index = 0; dense_index < from->count; dense_index += 1)
+    {
+        Regex_Inst *inst = regex->insts + from->dense[dense_index];
+        if (inst->op == RegexOp_Byte && byte >= inst->lo && byte <= inst->hi) {
+            regex_add_closure(regex, to, inst->x, nullptr, 0);
+        }
+    }
+}
+
+static b32 regex_set_has_match(Regex *regex, Regex_Set *set)
+{
+    for (u32 dense_index = 0; dense_index < set->count; dense_index += 1)
+    {
+        if (regex->insts[set->dense[dense_index]].op == RegexOp_Match) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+static s32 regex_dfa_find_or_add_state(Regex *regex, Regex_Set *set, b32 unanchored)
+{
+    // Returns -1 if the cache is full.
+    // States only keep Byte and Match instructions - others don't change the future of the state.
+    u16 kernel[REGEX_MAX_INSTS];
+    u16 kernel_count = 0;
+    b32 is_match = false;
+    
+    for (u32 dense_index = 0; dense_index < set->count; dense_index += 1)
+    {
+        u16 inst = set->dense[dense_index];
+        Regex_Op op = regex->insts[inst].op;
+        if (op == RegexOp_Byte || op == RegexOp_Match)
+        {
+            is_match |= (op == RegexOp_Match);
+            
+            u16 insert_at = kernel_count++; // sorted so equal sets look the same
+            while (insert_at > 0 && kernel[insert_at - 1] > inst)
+            {
+                kernel[insert_at] = kernel[insert_at - 1];
+                insert_at -= 1;
+            }
+            kernel[insert_at] = inst;
+        }
+    }
+    
+    for (s32 state_index = 0; state_index < regex->dfa_state_count; state_index += 1)
+    {
+        Regex_Dfa_State *state = regex->dfa_states + state_index;
+        if (state->inst_count == kernel_count && state->unanchored == unanchored &&
+            memcmp(regex->dfa_pool + state->pool_offset, kernel, kernel_count*sizeof(u16)) == 0)
+        {
+            return state_index;
+        }
+    }
+    
+    if (regex->dfa_state_count >= REGEX_DFA_MAX_STATES ||
+        regex->dfa_pool_used + kernel_count > REGEX_DFA_POOL_SIZE)
+    {
+        return -1;
+    }
+    
+    s32 state_index = regex->dfa_state_count++;
+    Regex_Dfa_State *state = regex->dfa_states + state_index;
+    memset(state->next, 0xFF, sizeof(state->next));
+    state->pool_offset = (u16)regex->dfa_pool_used;
+    state->inst_count = kernel_count;
+    state->is_match = (b8)is_match;
+    state->unanchored = (b8)unanchored;
+    
+    memcpy(regex->dfa_pool + state->pool_offset, kernel, kernel_count*sizeof(u16));
+    regex->dfa_pool_used += kernel_count;
+    return state_index;
+}
+
+static void regex_dfa_load_state(Regex *regex, s32 state_index, Regex_Set *out)
+{
+    Regex_Dfa_State *state = regex->dfa_states + state_index;
+    regex_set_clear(out);
+    for (u16 index = 0; index < state->inst_count; index += 1) {
+        regex_set_add(out, regex->dfa_pool[state->pool_offset + index]);
+    }
+}
+
+
+struct Regex_Scan
+{
+    s64 first_match_end; // -1 if there was no match
+    b32 match_at_end;
+    b32 dead; // anchored scan can't match anymore
+};
+
+static Regex_Scan regex_scan(Regex *regex, String text, s64 from, b32 unanchored, b32 stop_at_first_match)
+{
+    // Runs the lazy DFA over text starting at from.
+    // Unanchored scans start a new match attempt at every byte.
+    Regex_Scan result = {-1, false, false};
+    Regex_Set *current = regex->sets + 0;
+    Regex_Set *next = regex->sets + 1;
+    
+    regex_set_clear(current);
+    regex_add_closure(regex, current, regex->start, nullptr, 0);
+    
+    s32 state = regex_dfa_find_or_add_state(regex, current, unanchored);
+    if (state < 0)
+    {
+        regex_dfa_flush(regex);
+        state = regex_dfa_find_or_add_state(regex, current, unanchored);
+    }
+    
+    u64 flushes_at_start = regex->dfa_flush_count;
+    b32 use_nfa = false;
+    
+    for (s64 pos = from; ; pos += 1)
+    {
+        b32 is_match = (use_nfa ? regex_set_has_match(regex, current) : regex->dfa_states[state].is_match);
+        b32 at_end = (pos >= (s64)text.size);
+        
+        if (is_match && (!regex->anchored_end || at_end))
+        {
+            if (result.first_match_end < 0) {
+                result.first_match_end = pos;
+            }
+            if (stop_at_first_match) {
+                break;
+            }
+        }
+        if (at_end)
+        {
+            result.match_at_end = (is_match != 0);
+            break;
+        }
+        
+        u8 byte = text.str[pos];
+        if (use_nfa)
+        {
+            regex_step(regex, current, next, byte);
+            if (unanchored) {
+                regex_add_closure(regex, next, regex->start, nullptr, 0);
+            }
+            
+            Regex_Set *temp = current;
+            current = next;
+            next = temp;
+        }
+        else
+        {
+            s32 next_state = regex->dfa_states[state].next[byte];
+            if (next_state < 0)
+            {
+                regex_dfa_load_state(regex, state, current);
+                regex_step(regex, current, next, byte);
+                if (unanchored) {
+                    regex_add_closure(regex, next, regex->start, nullptr, 0);
+                }
+                
+                next_state = regex_dfa_find_or_add_state(regex, next, unanchored);
+                if (next_state < 0)
+                {
+                    // Cache is full - flush it. Fall back to NFA simulation if it keeps happening.
+                    regex_dfa_flush(regex);
+                    if (regex->dfa_flush_count - flushes_at_start > REGEX_DFA_MAX_FLUSHES)
+                    {
+                        use_nfa = true;
+                        Regex_Set *temp = current;
+                        current = next;
+                        next = temp;
+                        continue;
+                    }
+                    next_state = regex_dfa_find_or_add_state(regex, next, unanchored);
+                }
+                else
+                {
+                    regex->dfa_states[state].next[byte] = (s16)next_state;
+                }
+            }
+            state = next_state;
+        }
+        
+        u32 live_count = (use_nfa ? current->count : regex->dfa_states[state].inst_count);
+        if (!live_count)
+        {
+            result.dead = true;
+            break;
+        }
+    }
+    
+    return result;
+}
+
+
+static b32 regex_matches(Regex *regex, String text)
+{
+    // whole text has to match
+    if (!regex->valid) {
+        return false;
+    }
+    Regex_Scan scan = regex_scan(regex, text, 0, false, false);
+    return scan.match_at_end;
+}
+
+static b32 regex_matches_prefix(Regex *regex, String text)
+{
+    // true if text can still be extended into a match - useful for input masks
+    if (!regex->valid) {
+        return false;
+    }
+    Regex_Scan scan = regex_scan(regex, text, 0, false, false);
+    return !scan.dead;
+}
+
+static Regex_Match regex_find(Regex *regex, String text, s64 from)
+{
+    // Leftmost-longest match that starts at or after from.
+    // The DFA finds out if (and where at the earliest) a match ends, then NFA simulation that tracks
+    //   match starts per thread finds the exact range. Both are linear in the text size.
+    Regex_Match result = {};
+    if (!regex->valid || from < 0 || from > (s64)text.size) {
+        return result;
+    }
+    if (regex->anchored_start && from > 0) {
+        return result;
+    }
+    
+    b32 unanchored = !regex->anchored_start;
+    Regex_Scan scan = regex_scan(regex, text, from, unanchored, true);
+    if (scan.first_match_end < 0) {
+        return result;
+    }
+    
+    // leftmost match has to start at or before the earliest match end
+    s64 last_start = scan.first_match_end;
+    Regex_Set *current = regex->sets + 0;
+    Regex_Set *next = regex->sets + 1;
+    s64 *current_starts = regex->thread_starts[0];
+    s64 *next_starts = regex->thread_starts[1];
+    
+    regex_set_clear(current);
+    for (s64 pos = from; ; pos += 1)
+    {
+        // threads are kept sorted by their start - the earliest start claims an instruction first
+        if (!result.found && pos <= last_start && (unanchored || pos == from)) {
+            regex_add_closure(regex, current, regex->start, current_starts, pos);
+        }
+        if (!current->count) {
+            break;
+        }
+        
+        b32 at_end = (pos >= (s64)text.size);
+        for (u32 dense_index = 0; dense_index < current->count; dense_index += 1)
+        {
+            u16 inst = current->dense[dense_index];
+            if (regex->insts[inst].op == RegexOp_Match && (!regex->anchored_end || at_end))
+            {
+                s64 start = current_starts[inst];
+                if (!result.found || start < result.start ||
+                    (start == result.start && pos > result.one_past_end))
+                {
+                    result.found = true;
+                    result.start = start;
+                    result.one_past_end = pos;
+                }
+            }
+        }
+        if (at_end) {
+            break;
+        }
+        
+        u8 byte = text.str[pos];
+        regex_set_clear(next);
+        for (u32 dense_index = 0; dense_index < current->count; dense_index += 1)
+        {
+            u16 inst_index = current->dense[dense_index];
+            Regex_Inst *inst = regex->insts + inst_index;
+            s64 start = current_starts[inst_index];
+            
+            if (result.found && start > result.start) {
+                continue; // can't beat the match that was already found
+            }
+            if (inst->op == RegexOp_Byte && byte >= inst->lo && byte <= inst->hi) {
+                regex_add_closure(regex, next, inst->x, next_starts, start);
+            }
+        }
+        
+        Regex_Set *temp_set = current;
+        current = next;
+        next = temp_set;
+        s64 *temp_starts = current_starts;
+        current_starts = next_starts;
+        next_starts = temp_starts;
+    }
+    
+    return result;
+}
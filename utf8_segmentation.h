@@ -0,0 +1,620 @@
+//
+// Text segmentation (UAX #29) based on tables from utf8_unicode_tables.h
+//
+
+static u32 unicode_table_lookup(u32 *table, u32 table_count, u32 codepoint)
+{
+    // Tables store sorted run starts: (first_codepoint << 5) | property.
+    // Finds the last run that starts at or before the codepoint.
+    u32 key = (codepoint << 5) | Bitmask_5;
+    u32 low = 0;
+    u32 high = table_count;
+    
+    while (low < high)
+    {
+        u32 mid = low + (high - low) / 2;
+        if (table[mid] <= key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    
+    u32 result = (low ? table[low - 1] & Bitmask_5 : 0);
+    return result;
+}
+
+
+
+//
+// Grapheme clusters
+//
+
+static Grapheme_Break grapheme_break_property(u32 codepoint)
+{
+    if (codepoint > 0x10FFFF) {
+        return GraphemeBreak_Control; // invalid utf8 - keep it as a separate cluster
+    }
+    
+    // fast path for the most common text - nothing below U+0300 is a combining mark
+    if (codepoint >= ' ' && codepoint < 0x7F) {
+        return GraphemeBreak_Other;
+    }
+    if (codepoint >= 0x4E00 && codepoint <= 0x9FFF) { // CJK Unified Ideographs
+        return GraphemeBreak_Other;
+    }
+    
+    Grapheme_Break result = (Grapheme_Break)unicode_table_lookup(unicode_grapheme_break_table,
+                                                                 array_count(unicode_grapheme_break_table),
+                                                                 codepoint);
+    if (result == GraphemeBreak_LV_LVT)
+    {
+        // Hangul syllables alternate between LV and LVT - one LV every 28 codepoints
+        result = ((codepoint - 0xAC00) % 28 == 0 ? GraphemeBreak_LV : GraphemeBreak_LVT);
+    }
+    
+    return result;
+}
+
+
+struct Grapheme_Break_State
+{
+    // Context needed by rules that look further back than one codepoint
+    Grapheme_Break prev;
+    b32 emoji_zwj; // previous codepoints were: ExtendedPictographic Extend* ZWJ
+    b32 emoji_base; // previous codepoints were: ExtendedPictographic Extend*
+    s32 regional_indicator_run; // count of regional indicators directly before
+};
+
+static b32 grapheme_is_boundary(Grapheme_Break_State *state, Grapheme_Break next)
+{
+    Grapheme_Break prev = state->prev;
+    b32 result = true;
+    
+    if (prev == GraphemeBreak_CR && next == GraphemeBreak_LF) { // GB3
+        result = false;
+    } else if (prev == GraphemeBreak_Control || prev == GraphemeBreak_CR || prev == GraphemeBreak_LF) { // GB4
+        result = true;
+    } else if (next == GraphemeBreak_Control || next == GraphemeBreak_CR || next == GraphemeBreak_LF) { // GB5
+        result = true;
+    } else if (prev == GraphemeBreak_L &&
+               (next == GraphemeBreak_L || next == GraphemeBreak_V ||
+                next == GraphemeBreak_LV || next == GraphemeBreak_LVT)) { // GB6
+        result = false;
+    } else if ((prev == GraphemeBreak_LV || prev == GraphemeBreak_V) &&
+               (next == GraphemeBreak_V || next == GraphemeBreak_T)) { // GB7
+        result = false;
+    } else if ((prev == GraphemeBreak_LVT || prev == GraphemeBreak_T) && next == GraphemeBreak_T) { // GB8
+        result = false;
+    } else if (next == GraphemeBreak_Extend || next == GraphemeBreak_ZWJ ||
+               next == GraphemeBreak_SpacingMark || prev == GraphemeBreak_Prepend) { // GB9, GB9a, GB9b
+        result = false;
+    } else if (state->emoji_zwj && next == GraphemeBreak_ExtendedPictographic) { // GB11
+        result = false;
+    } else if (prev == GraphemeBreak_RegionalIndicator && next == GraphemeBreak_RegionalIndicator) { // GB12, GB13
+        result = (state->regional_indicator_run % 2 == 0);
+    }
+    
+    // advance state
+    state->emoji_zwj = (state->emoji_base && next == GraphemeBreak_ZWJ);
+    state->emoji_base = (next == GraphemeBreak_ExtendedPictographic ||
+                         (state->emoji_base && next == GraphemeBreak_Extend));
+    state->regional_indicator_run = (next == GraphemeBreak_RegionalIndicator ?
+                                     state->regional_indicator_run + 1 : 0);
+    state->prev = next;
+    
+    return result;
+}
+
+static Grapheme_Break_State grapheme_break_state_start(Grapheme_Break first)
+{
+    Grapheme_Break_State state = {};
+    state.prev = GraphemeBreak_Control; // anything that is followed by a boundary
+    grapheme_is_boundary(&state, first);
+    return state;
+}
+
+
+
+static s64 str_next_grapheme_boundary(String text, s64 pos)
+{
+    // Expects pos to be at a grapheme boundary.
+    if (pos >= (s64)text.size) {
+        return text.size;
+    }
+    
+    Unicode_Consume first = utf8_consume(text.str + pos, text.size - pos);
+    pos += first.inc;
+    
+    // fast path - ASCII followed by ASCII is always a boundary (except for CR LF)
+    if (first.codepoint < 0x80 && first.codepoint != '\r' &&
+        (pos >= (s64)text.size || text.str[pos] < 0x80))
+    {
+        return pos;
+    }
+    
+    Grapheme_Break_State state = grapheme_break_state_start(grapheme_break_property(first.codepoint));
+    
+    while (pos < (s64)text.size)
+    {
+        Unicode_Consume consume = utf8_consume(text.str + pos, text.size - pos);
+        
+        // no combining marks below U+0300 - only CR LF and Prepend can continue the cluster
+        if (consume.codepoint < 0x300 &&
+            state.prev != GraphemeBreak_CR && state.prev != GraphemeBreak_Prepend) {
+            break;
+        }
+        
+        if (grapheme_is_boundary(&state, grapheme_break_property(consume.codepoint))) {
+            break;
+        }
+        
+        pos += consume.inc;
+    }
+    
+    return pos;
+}
+
+
+static b32 str_is_grapheme_boundary(String text, s64 pos)
+{
+    if (pos <= 0 || pos >= (s64)text.size) {
+        return true;
+    }
+    if (utf8_top5b_class[text.str[pos] >> 3] == 0) {
+        return false; // middle of utf8 sequence
+    }
+    
+    Unicode_Consume next = utf8_consume(text.str + pos, text.size - pos);
+    Unicode_Consume_Reverse prev = utf8_consume_reverse(text.str, pos);
+    
+    if (next.codepoint < 0x300 && prev.codepoint < 0x300) {
+        return !(prev.codepoint == '\r' && next.codepoint == '\n');
+    }
+    
+    Grapheme_Break next_property = grapheme_break_property(next.codepoint);
+    Grapheme_Break prev_property = grapheme_break_property(prev.codepoint);
+    
+    Grapheme_Break_State state = {};
+    state.prev = prev_property;
+    
+    if (prev_property == GraphemeBreak_ZWJ && next_property == GraphemeBreak_ExtendedPictographic)
+    {
+        // GB11 - look for: ExtendedPictographic Extend* before ZWJ
+        s64 scan = pos - prev.dec;
+        while (scan > 0)
+        {
+            Unicode_Consume_Reverse back = utf8_consume_reverse(text.str, scan);
+            Grapheme_Break back_property = grapheme_break_property(back.codepoint);
+            
+            if (back_property == GraphemeBreak_ExtendedPictographic) {
+                state.emoji_zwj = true;
+            }
+            if (back_property != GraphemeBreak_Extend) {
+                break;
+            }
+            scan -= back.dec;
+        }
+    }
+    else if (prev_property == GraphemeBreak_RegionalIndicator)
+    {
+        s64 scan = pos;
+        while (scan > 0)
+        {
+            Unicode_Consume_Reverse back = utf8_consume_reverse(text.str, scan);
+            if (grapheme_break_property(back.codepoint) != GraphemeBreak_RegionalIndicator) {
+                break;
+            }
+            state.regional_indicator_run += 1;
+            scan -= back.dec;
+        }
+    }
+    
+    return grapheme_is_boundary(&state, next_property);
+}
+
+
+static s64 str_prev_grapheme_boundary(String text, s64 pos)
+{
+    if (pos > (s64)text.size) {
+        return text.size;
+    }
+    
+    while (pos > 0)
+    {
+        // fast path - ASCII preceded by ASCII
+        if (pos >= 2 && text.str[pos - 1] < 0x80 && text.str[pos - 2] < 0x80 &&
+            !(text.str[pos - 2] == '\r' && text.str[pos - 1] == '\n'))
+        {
+            return pos - 1;
+        }
+        
+        Unicode_Consume_Reverse consume = utf8_consume_reverse(text.str, pos);
+        pos -= consume.dec;
+        
+        if (str_is_grapheme_boundary(text, pos)) {
+            break;
+        }
+    }
+    
+    return get_max(0, pos);
+}
+
+
+
+//
+// Words
+//
+
+static Word_Break word_break_property(u32 codepoint)
+{
+    // fast path for ASCII letters, digits and spaces
+    if ((codepoint|0x20) >= 'a' && (codepoint|0x20) <= 'z') {
+        return WordBreak_ALetter;
+    }
+    if (codepoint >= '0' && codepoint <= '9') {
+        return WordBreak_Numeric;
+    }
+    if (codepoint == ' ') {
+        return WordBreak_WSegSpace;
+    }
+    if (codepoint >= 0x4E00 && codepoint <= 0x9FFF) { // CJK Unified Ideographs
+        return WordBreak_OtherLetter;
+    }
+    if (codepoint > 0x10FFFF) {
+        return WordBreak_Other;
+    }
+    
+    Word_Break result = (Word_Break)unicode_table_lookup(unicode_word_break_table,
+                                                         array_count(unicode_word_break_table),
+                                                         codepoint);
+    return result;
+}
+
+static b32 word_break_is_ignored(Word_Break property) { // WB4
+    return (property == WordBreak_Extend || property == WordBreak_Format || property == WordBreak_ZWJ);
+}
+static b32 word_break_is_newline(Word_Break property) {
+    return (property == WordBreak_CR || property == WordBreak_LF || property == WordBreak_Newline);
+}
+static b32 word_break_is_ah_letter(Word_Break property) {
+    return (property == WordBreak_ALetter || property == WordBreak_HebrewLetter);
+}
+static b32 word_break_is_mid_letter(Word_Break property) { // MidLetter | MidNumLetQ
+    return (property == WordBreak_MidLetter || property == WordBreak_MidNumLet ||
+            property == WordBreak_SingleQuote);
+}
+static b32 word_break_is_mid_num(Word_Break property) { // MidNum | MidNumLetQ
+    return (property == WordBreak_MidNum || property == WordBreak_MidNumLet ||
+            property == WordBreak_SingleQuote);
+}
+static b32 word_break_is_plain(Word_Break property) { // no rule joins two of these - WB999 always breaks
+    return (property == WordBreak_Other || property == WordBreak_OtherLetter ||
+            property == WordBreak_ExtendedPictographic);
+}
+
+static b32 word_break_is_word(Word_Break property)
+{
+    // Segments that start with these are words for cursor movement. Others are spaces/punctuation.
+    return (property == WordBreak_ALetter || property == WordBreak_HebrewLetter ||
+            property == WordBreak_Numeric || property == WordBreak_Katakana ||
+            property == WordBreak_ExtendNumLet || property == WordBreak_OtherLetter ||
+            property == WordBreak_ExtendedPictographic);
+}
+
+
+static Word_Break str_peek_word_break(String text, s64 pos)
+{
+    // Returns the property of the next codepoint that isn't skipped by WB4
+    Word_Break result = WordBreak_Other;
+    while (pos < (s64)text.size)
+    {
+        Unicode_Consume consume = utf8_consume(text.str + pos, text.size - pos);
+        result = word_break_property(consume.codepoint);
+        if (!word_break_is_ignored(result)) {
+            break;
+        }
+        result = WordBreak_Other;
+        pos += consume.inc;
+    }
+    return result;
+}
+
+
+static b32 str_is_word_segment(String text, s64 segment_start)
+{
+    b32 result = false;
+    if (segment_start < (s64)text.size)
+    {
+        Unicode_Consume consume = utf8_consume(text.str + segment_start, text.size - segment_start);
+        result = word_break_is_word(word_break_property(consume.codepoint));
+    }
+    return result;
+}
+
+
+
+static u64 ascii_word_boundary_mask(u8 *str)
+{
+    // Classifies 64 ASCII bytes at once.
+    // Bit i is set if there is a word boundary between str[i - 1] and str[i].
+    // Results are only correct for bits 2..62 - other bits miss their neighbours.
+    u64 letter = 0, digit = 0, underscore = 0, space = 0, cr = 0, lf = 0, mid_letter = 0, mid_num = 0;
+    
+    for (u32 block_index = 0; block_index < 4; block_index += 1)
+    {
+        __m128i bytes = _mm_loadu_si128((__m128i *)(str + block_index*16));
+        __m128i lower = _mm_or_si128(bytes, _mm_set1_epi8(0x20));
+        
+        __m128i is_letter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                          _mm_cmplt_epi8(lower, _mm_set1_epi8('z' + 1)));
+        __m128i is_digit = _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8('0' - 1)),
+                                         _mm_cmplt_epi8(bytes, _mm_set1_epi8('9' + 1)));
+        __m128i is_dot_or_quote = _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('.')),
+                                               _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\'')));
+        __m128i is_mid_letter = _mm_or_si128(is_dot_or_quote, _mm_cmpeq_epi8(bytes, _mm_set1_epi8(':')));
+        __m128i is_mid_num = _mm_or_si128(is_dot_or_quote,
+                                          _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(',')),
+                                                       _mm_cmpeq_epi8(bytes, _mm_set1_epi8(';'))));
+        
+        u32 shift = block_index*16;
+        letter |= (u64)(u16)_mm_movemask_epi8(is_letter) << shift;
+        digit |= (u64)(u16)_mm_movemask_epi8(is_digit) << shift;
+        underscore |= (u64)(u16)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('_'))) << shift;
+        space |= (u64)(u16)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(' '))) << shift;
+        cr |= (u64)(u16)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\r'))) << shift;
+        lf |= (u64)(u16)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n'))) << shift;
+        mid_letter |= (u64)(u16)_mm_movemask_epi8(is_mid_letter) << shift;
+        mid_num |= (u64)(u16)_mm_movemask_epi8(is_mid_num) << shift;
+    }
+    
+    // for each bit: x << 1 is the previous byte, x >> 1 is the next byte
+    u64 word = letter | digit | underscore; // WB5, WB8-WB10, WB13a, WB13b
+    u64 no_break = ((word & (word << 1)) |
+                    (space & (space << 1)) | // WB3d
+                    (lf & (cr << 1)) | // WB3
+                    (mid_letter & (letter << 1) & (letter >> 1)) | // WB6
+                    (letter & (mid_letter << 1) & (letter << 2)) | // WB7
+                    (digit & (mid_num << 1) & (digit << 2)) | // WB11
+                    (mid_num & (digit << 1) & (digit >> 1))); // WB12
+    return ~no_break;
+}
+
+
+static s64 str_next_word_boundary(String text, s64 pos)
+{
+    // Expects pos to be at a word boundary.
+    if (pos >= (s64)text.size) {
+        return text.size;
+    }
+    if (pos < 0) {
+        return 0;
+    }
+    
+    // fast path - 64 bytes of ASCII at a time
+    // Windows overlap by 4 bytes so every checked bit has 2 bytes of context before and 1 after.
+    b32 inside_segment = false;
+    for (;;)
+    {
+        s64 base = get_max(0, pos - 2);
+        if (base + 64 > (s64)text.size) {
+            break;
+        }
+        
+        __m128i high_bits = _mm_or_si128(_mm_or_si128(_mm_loadu_si128((__m128i *)(text.str + base)),
+                                                       _mm_loadu_si128((__m128i *)(text.str + base + 16))),
+                                          _mm_or_si128(_mm_loadu_si128((__m128i *)(text.str + base + 32)),
+                                                       _mm_loadu_si128((__m128i *)(text.str + base + 48))));
+        if (_mm_movemask_epi8(high_bits)) {
+            break;
+        }
+        
+        u64 valid_bits = (~0ull << (pos - base + 1)) & (~0ull >> 1); // boundaries after pos, up to bit 62
+        Bit_Scan_Result scan = find_least_significant_bit(ascii_word_boundary_mask(text.str + base) & valid_bits);
+        if (scan.found) {
+            return base + scan.index;
+        }
+        pos = base + 62; // all of that was a single segment
+        inside_segment = true;
+    }
+    
+    
+    // WB7 and WB11 look 2 codepoints back - when continuing after the fast path that context is ASCII
+    Word_Break prev_prev = (inside_segment ? word_break_property(text.str[pos - 1]) : WordBreak_Other);
+    
+    Unicode_Consume first = utf8_consume(text.str + pos, text.size - pos);
+    Word_Break prev = word_break_property(first.codepoint);
+    pos += first.inc;
+    
+    if (prev == WordBreak_CR && pos < (s64)text.size && text.str[pos] == '\n') { // WB3
+        return pos + 1;
+    }
+    if (word_break_is_newline(prev)) { // WB3a
+        return pos;
+    }
+    
+    Word_Break prev_raw = prev; // prev and prev_prev skip WB4 codepoints, prev_raw doesn't
+    s64 regional_indicator_run = (prev == WordBreak_RegionalIndicator ? 1 : 0);
+    
+    while (pos < (s64)text.size)
+    {
+        Unicode_Consume consume = utf8_consume(text.str + pos, text.size - pos);
+        Word_Break next = word_break_property(consume.codepoint);
+        
+        if (word_break_is_newline(next)) { // WB3b
+            break;
+        }
+        
+        b32 join_raw = ((prev_raw == WordBreak_ZWJ && next == WordBreak_ExtendedPictographic) || // WB3c
+                        (prev_raw == WordBreak_WSegSpace && next == WordBreak_WSegSpace)); // WB3d
+        
+        if (!join_raw && word_break_is_ignored(next)) // WB4
+        {
+            prev_raw = next;
+            pos += consume.inc;
+            continue;
+        }
+        
+        if (!join_raw)
+        {
+            b32 join = false;
+            if (word_break_is_ah_letter(prev) && word_break_is_ah_letter(next)) { // WB5
+                join = true;
+            } else if (word_break_is_ah_letter(prev) && word_break_is_mid_letter(next)) { // WB6
+                join = word_break_is_ah_letter(str_peek_word_break(text, pos + consume.inc));
+            } else if (word_break_is_ah_letter(prev_prev) && word_break_is_mid_letter(prev) &&
+                       word_break_is_ah_letter(next)) { // WB7
+                join = true;
+            }
+            
+            if (prev == WordBreak_HebrewLetter && next == WordBreak_SingleQuote) { // WB7a
+                join = true;
+            } else if (prev == WordBreak_HebrewLetter && next == WordBreak_DoubleQuote) { // WB7b
+                join = (str_peek_word_break(text, pos + consume.inc) == WordBreak_HebrewLetter);
+            } else if (prev_prev == WordBreak_HebrewLetter && prev == WordBreak_DoubleQuote &&
+                       next == WordBreak_HebrewLetter) { // WB7c
+                join = true;
+            }
+            
+            b32 prev_alnum = (word_break_is_ah_letter(prev) || prev == WordBreak_Numeric);
+            b32 next_alnum = (word_break_is_ah_letter(next) || next == WordBreak_Numeric);
+            if (prev_alnum && next_alnum) { // WB8, WB9, WB10
+                join = true;
+            } else if (prev_prev == WordBreak_Numeric && word_break_is_mid_num(prev) &&
+                       next == WordBreak_Numeric) { // WB11
+                join = true;
+            } else if (prev == WordBreak_Numeric && word_break_is_mid_num(next)) { // WB12
+                join = (str_peek_word_break(text, pos + consume.inc) == WordBreak_Numeric);
+            }
+            
+            if (prev == WordBreak_Katakana && next == WordBreak_Katakana) { // WB13
+                join = true;
+            } else if ((prev_alnum || prev == WordBreak_Katakana || prev == WordBreak_ExtendNumLet) &&
+                       next == WordBreak_ExtendNumLet) { // WB13a
+                join = true;
+            } else if (prev == WordBreak_ExtendNumLet &&
+                       (next_alnum || next == WordBreak_Katakana)) { // WB13b
+                join = true;
+            } else if (prev == WordBreak_RegionalIndicator && next == WordBreak_RegionalIndicator) { // WB15, WB16
+                join = (regional_indicator_run % 2 == 1);
+            }
+            
+            if (!join) { // WB999
+                break;
+            }
+        }
+        
+        regional_indicator_run = (next == WordBreak_RegionalIndicator ? regional_indicator_run + 1 : 0);
+        prev_prev = prev;
+        prev = next;
+        prev_raw = next;
+        pos += consume.inc;
+    }
+    
+    return pos;
+}
+
+
+#define Word_MaxRestartScan 1024 // bytes
+
+static s64 str_word_boundary_restart_pos(String text, s64 pos)
+{
+    // Finds a position at or before pos that is always a word boundary:
+    // after a newline, after a space that isn't followed by another space or by WB4 codepoints
+    //   or between two codepoints that are never joined (ideographs, symbols - text without spaces stops early).
+    // Scan stops after Word_MaxRestartScan bytes - words longer than that get split there.
+    while (pos > 0 && pos < (s64)text.size && utf8_top5b_class[text.str[pos] >> 3] == 0) {
+        pos -= 1; // move out of the middle of utf8 sequence
+    }
+    
+    Word_Break after = WordBreak_Other;
+    u32 after_codepoint = ~0u; // invalid utf8 can decode differently once bytes next to it get edited
+    if (pos < (s64)text.size)
+    {
+        after_codepoint = utf8_consume(text.str + pos, text.size - pos).codepoint;
+        after = word_break_property(after_codepoint);
+    }
+    
+    s64 scan_end = pos - Word_MaxRestartScan;
+    while (pos > 0 && pos > scan_end)
+    {
+        Unicode_Consume_Reverse consume = utf8_consume_reverse(text.str, pos);
+        Word_Break property = word_break_property(consume.codepoint);
+        
+        if (property == WordBreak_LF || property == WordBreak_Newline ||
+            (property == WordBreak_CR && after != WordBreak_LF)) {
+            break;
+        }
+        if (property == WordBreak_WSegSpace && after != WordBreak_WSegSpace && !word_break_is_ignored(after)) {
+            break;
+        }
+        if (word_break_is_plain(property) && word_break_is_plain(after) &&
+            consume.codepoint != ~0u && after_codepoint != ~0u) {
+            break;
+        }
+        
+        after = property;
+        after_codepoint = consume.codepoint;
+        pos -= consume.dec;
+    }
+    
+    return get_max(0, pos);
+}
+
+
+static s64 str_word_boundary_safe_pos_after(String text, s64 pos)
+{
+    // Finds a position after pos that is always a word boundary - the rules are the same as above
+    //   but the newline/space (or the first of the two codepoints) has to start at or after pos.
+    // Scan stops after Word_MaxRestartScan bytes too.
+    while (pos > 0 && pos < (s64)text.size && utf8_top5b_class[text.str[pos] >> 3] == 0) {
+        pos += 1;
+    }
+    
+    s64 scan_end = pos + Word_MaxRestartScan;
+    while (pos < (s64)text.size && pos < scan_end)
+    {
+        Unicode_Consume consume = utf8_consume(text.str + pos, text.size - pos);
+        Word_Break property = word_break_property(consume.codepoint);
+        pos += consume.inc;
+        
+        if (property == WordBreak_LF || property == WordBreak_Newline) {
+            break;
+        }
+        if (pos < (s64)text.size)
+        {
+            u32 after_codepoint = utf8_consume(text.str + pos, text.size - pos).codepoint;
+            Word_Break after = word_break_property(after_codepoint);
+            if (property == WordBreak_CR && after != WordBreak_LF) {
+                break;
+            }
+            if (property == WordBreak_WSegSpace && after != WordBreak_WSegSpace && !word_break_is_ignored(after)) {
+                break;
+            }
+            if (word_break_is_plain(property) && word_break_is_plain(after) &&
+                consume.codepoint != ~0u && after_codepoint != ~0u) {
+                break;
+            }
+        }
+    }
+    
+    return get_min(pos, (s64)text.size);
+}
+
+
+static s64 str_word_boundary_at_or_before(String text, s64 pos)
+{
+    pos = get_min(pos, (s64)text.size);
+    s64 boundary = str_word_boundary_restart_pos(text, pos);
+    
+    while (boundary < pos)
+    {
+        s64 next = str_next_word_boundary(text, boundary);
+        if (next > pos) {
+            break;
+        }
+        boundary = next;
+    }
+    
+    return get_max(0, boundary);
+}
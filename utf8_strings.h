@@ -234,8 +234,11 @@ static Unicode_Consume_Reverse utf8_consume_reverse(u8 *str, u64 max)
     }
     
     Unicode_Consume consume = utf8_consume(str + (max - length), length);
-    result.dec = consume.inc;
-    result.codepoint = consume.codepoint;
+    if (consume.inc == length) // otherwise the last byte is a stray continuation byte
+    {
+        result.dec = consume.inc;
+        result.codepoint = consume.codepoint;
+    }
     return result;
 }
 
@@ -11,16 +11,178 @@ struct Mutable_String
 };
 
 
+struct Text_Cursor
+{
+    s64 cursor_pos, mark_pos;
+};
+
+struct Text_Range
+{
+    s64 start, one_past_end;
+};
+
+struct Text_Selection_Set
+{
+    // Disjoint ranges sorted by position - touching and overlapping ranges are merged, empty ones ignored.
+    // Lookups are binary searches. Memory is provided by the user.
+    Text_Range *ranges;
+    s64 count, cap;
+};
+
+struct Text_Layout_Boundary
+{
+    s64 byte_index;
+    f32 x; // sum of advances of all glyphs before byte_index
+};
+
+struct Text_Layout
+{
+    // Codepoint boundaries of the buffer with their x positions (prefix sums of glyph advances).
+    // The layer that owns fonts fills it (see text_layout_update in app.cpp) - edits only cut it
+    //   after the edit start, so only the suffix gets recomputed.
+    // Memory is provided by the user - in the worst case it needs (buffer capacity + 1) entries.
+    Text_Layout_Boundary *boundaries;
+    s64 count, cap; // entries [0, count) are up to date
+    
+    // key - everything gets recomputed if any of these don't match
+    void *font;
+    u64 version; // Text_Input::version
+};
+
+struct Text_Wrap
+{
+    // Visual rows of a multi-line text input - lines (see Text_Line_Index) wrapped at max_width.
+    // Row starts are sorted byte offsets, every line start is also a row start.
+    // Edits only splice & shift row starts (text_wrap_on_edit) and mark their lines as dirty -
+    //   text_wrap_update rewraps just these lines once the layout is up to date.
+    // Rows have the same height so the vertical index is implicit: top of a row is row*row_height.
+    // Memory is provided by the user - in the worst case it needs (buffer capacity + 1) entries.
+    s64 *row_starts;
+    s64 row_count, row_cap;
+    
+    // key - everything gets rewrapped if any of these don't match
+    f32 max_width;
+    u64 version; // Text_Input::version
+    
+    b32 has_dirty_range;
+    s64 dirty_start, dirty_end; // in current buffer
+};
+
+struct Text_Bidi
+{
+    // Bidi runs (see utf8_bidi.h) of every paragraph in logical order & their visual order.
+    // Paragraphs end after '\n' - edits throw away the edited paragraph and everything after it,
+    //   text_bidi_update resolves them again. Paragraphs without right to left codepoints skip
+    //   the bidi algorithm - they become a single level 0 run.
+    // Visual order is laid out on a single line - paragraphs keep their own range of slots
+    //   (slots are the positions of runs from left to right).
+    // Memory is provided by the user - runs, visual, slot_of_run & slot_x need (buffer capacity) entries,
+    //   scratch (3*buffer capacity) bytes.
+    Bidi_Run *runs;
+    s64 *visual; // slot -> run
+    s64 *slot_of_run; // run -> slot
+    f32 *slot_x; // left edge of every slot - from Text_Layout
+    s64 count, cap;
+    u8 *scratch;
+    
+    s64 resolved_end; // paragraphs before this byte are up to date
+    b32 has_rtl; // false if no run has an odd level - visual order is the same as logical order
+    
+    // key - slot_x & has_rtl get recomputed if any of these don't match
+    b32 has_slot_x;
+    void *font;
+    u64 version; // Text_Input::version
+};
+
+struct Text_Line_Index
+{
+    // Byte offsets of line starts - the first entry is always 0.
+    // Memory is provided by the user - in the worst case (every byte is a new line)
+    //   it needs (buffer capacity + 1) entries.
+    s64 *line_starts;
+    s64 line_count, line_cap;
+};
+
+struct Text_Word_Cache
+{
+    // Lazily built word boundaries - one bit per buffer position (including buffer.size).
+    // known: bit is up to date, boundaries: word boundary at that position,
+    // word_starts: a word segment (see str_is_word_segment) starts at that position.
+    // Edits shift the bits and forget only the neighbourhood of the edited range.
+    // Memory is provided by the user - every array needs (buffer capacity + 64)/64 entries.
+    u64 *known;
+    u64 *boundaries;
+    u64 *word_starts;
+    s64 word_count; // count of u64 entries in each array
+};
+
+struct Text_Match
+{
+    s64 start, one_past_end;
+};
+
+struct Text_Search
+{
+    // Matches of a query - sorted, can overlap ("aa" in "aaa" matches twice).
+    // Memory for the query copy and the matches is provided by the user.
+    // If there are more matches than match_cap only the first ones are stored (truncated is set).
+    Mutable_String query;
+    b32 ignore_case; // compares codepoints through unicode_codepoint_to_lower
+    
+    Text_Match *matches;
+    s64 match_count, match_cap;
+    b32 truncated;
+};
+
+struct Text_Fuzzy_Matcher
+{
+    // Fuzzy matching of a query against a list of candidates (autocomplete).
+    // Query codepoints have to appear in the candidate in order (case insensitive).
+    // Every candidate has a presence bitmask (see text_fuzzy_presence_mask) - candidates that miss
+    //   something from the query mask are rejected 4 at a time before the scalar scoring runs.
+    // Memory is provided by the user:
+    //   candidate_masks - candidate_count rounded up to a multiple of 4
+    //   matches, scores - candidate_count entries each
+    String *candidates;
+    u32 *candidate_masks;
+    s64 candidate_count;
+    
+    Mutable_String query;
+    u32 query_mask;
+    
+    u32 *matches; // candidate indices - ascending
+    s32 *scores; // score of every match
+    s64 match_count;
+};
+
 struct Text_Input
 {
     Mutable_String buffer;
     s64 cursor_pos, mark_pos;
     
+    // Optional multi-cursor support - memory is provided by the user (cursor_cap).
+    // If cursor_count > 0 the array holds all cursors including the main one (at primary_cursor_index)
+    //   sorted by position with non-overlapping selections.
+    // The main cursor is always stored in cursor_pos & mark_pos - its copy in the array
+    //   gets refreshed before every multi-cursor operation.
+    Text_Cursor *cursors;
+    u32 cursor_count, cursor_cap;
+    u32 primary_cursor_index;
+    
+    Text_Line_Index *line_index; // optional - updated on every edit
+    Text_Word_Cache *word_cache; // optional - speeds up word movement
+    Text_Search *search; // optional - matches are kept up to date on every edit
+    Text_Fuzzy_Matcher *autocomplete; // optional - buffer is the query, matches are refined on every edit
+    Text_Selection_Set *selections; // optional - extra selected ranges, remapped on every edit
+    Text_Layout *layout; // optional - advances after the edit start get invalidated on every edit
+    Text_Wrap *wrap; // optional - multi-line text areas, rows are shifted on every edit
+    Text_Bidi *bidi; // optional - right to left text, paragraphs after the edit start get resolved again
+    u64 version; // incremented on every edit
+    
     f32 target_scroll_x;
     f32 scroll_anim_start, scroll_anim_t; // for animation
     f32 current_scroll_x;
-    
-    // @todo store how much bytes one should skip for draw only calls when text input isn't dirty
+    f32 target_scroll_y, current_scroll_y; // text areas only
     
     b32 is_dirty; // @todo store last width of text input so it automatically becoes dirty if width changes
     // could be set to -1.f to force dirty state
@@ -32,34 +194,2146 @@ struct Text_Input
 
 
 
-static String truncate_invalid_utf8_ending(String input)
+static String truncate_invalid_utf8_ending(String input)
+{
+    // This function assumes that our input was a valid utf8 string at some point
+    //   but it got truncated without much care - possibly in the middle of a codepoint.
+    // It removes up to 3 bytes if string's ending is an incorrect utf8 sequence.
+    
+    String result = input;
+    
+    s32 follower_byte_count = 0; // counter for bytes with 10xxxxxx bits
+    s64 end_at = get_max(0, (s64)input.size - 4);
+    
+    for (s64 index = input.size-1; index >= end_at; index -= 1)
+    {
+        u8 byte = input.str[index];
+        u8 byte_class = utf8_top5b_class[byte >> 3];
+        
+        if (byte_class == 0)
+        {
+            follower_byte_count += 1;
+        }
+        else
+        {
+            if (byte_class != follower_byte_count + 1)
+            {
+                result.size = index;
+            }
+            
+            break;
+        }
+    }
+    
+    return result;
+}
+
+
+
+struct Text_Ingest_Result
+{
+    u64 written; // bytes written to the destination
+    u64 consumed; // bytes of the source that were processed - less than source size if it got clipped
+};
+
+static Text_Ingest_Result text_ingest(u8 *dst, u64 dst_cap, String src, b32 allow_new_lines)
+{
+    // Cleans up external text (clipboard etc.) while copying it to dst:
+    // - invalid utf8 (also overlong forms, surrogates) is dropped
+    // - CRLF and lone CR become LF (or a space if new lines aren't allowed)
+    // - other control characters (except tab) are dropped
+    // - output is clipped to dst_cap at a codepoint boundary
+    // Runs of printable ascii are checked & copied 16 bytes at a time.
+    // Output is never longer than the input.
+    Text_Ingest_Result result = {};
+    u64 read = 0;
+    u64 written = 0;
+    
+    __m128i below_space = _mm_set1_epi8(' ');
+    __m128i delete_char = _mm_set1_epi8(0x7F);
+    
+    while (read < src.size)
+    {
+        if (src.size - read >= 16 && dst_cap - written >= 16)
+        {
+            // signed compare - bytes >= 0x80 are negative so they count as special too
+            __m128i chunk = _mm_loadu_si128((__m128i *)(src.str + read));
+            __m128i special = _mm_or_si128(_mm_cmplt_epi8(chunk, below_space), _mm_cmpeq_epi8(chunk, delete_char));
+            u32 special_bits = (u32)_mm_movemask_epi8(special);
+            
+            _mm_storeu_si128((__m128i *)(dst + written), chunk);
+            u32 plain_count = (special_bits ? find_least_significant_bit(special_bits).index : 16);
+            read += plain_count;
+            written += plain_count;
+            if (plain_count == 16) {
+                continue;
+            }
+        }
+        
+        u8 byte = src.str[read];
+        u8 out[4];
+        u32 out_size = 0;
+        u32 inc = 1;
+        
+        if (byte == '\r' || byte == '\n')
+        {
+            if (byte == '\r' && read + 1 < src.size && src.str[read + 1] == '\n') {
+                inc = 2;
+            }
+            out[out_size++] = (allow_new_lines ? '\n' : ' ');
+        }
+        else if (byte == '\t' || (byte >= ' ' && byte < 0x7F))
+        {
+            out[out_size++] = byte;
+        }
+        else if (byte >= 0x80)
+        {
+            Unicode_Consume consume = utf8_consume(src.str + read, src.size - read);
+            inc = consume.inc;
+            
+            u32 cp = consume.codepoint;
+            u32 min_codepoint = (inc == 2 ? 0x80 : inc == 3 ? 0x800 : 0x10000);
+            b32 valid = (inc > 1 && cp >= min_codepoint && cp <= 0x10FFFF &&
+                         !(cp >= 0xD800 && cp <= 0xDFFF) &&
+                         !(cp >= 0x80 && cp <= 0x9F)); // C1 controls
+            if (valid)
+            {
+                memcpy(out, src.str + read, inc);
+                out_size = inc;
+            }
+        }
+        
+        if (written + out_size > dst_cap) {
+            break;
+        }
+        
+        memcpy(dst + written, out, out_size);
+        written += out_size;
+        read += inc;
+    }
+    
+    result.written = written;
+    result.consumed = read;
+    return result;
+}
+
+
+
+
+
+
+static s64 line_index_first_line_start_after(Text_Line_Index *index, s64 pos)
+{
+    // returns index of the first line start that is > pos (binary search)
+    s64 low = 0;
+    s64 high = index->line_count;
+    
+    while (low < high)
+    {
+        s64 mid = low + (high - low) / 2;
+        if (index->line_starts[mid] <= pos) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    
+    return low;
+}
+
+static s64 line_index_count_new_lines(String text)
+{
+    s64 count = 0;
+    for (;;)
+    {
+        u8 *new_line = (u8 *)memchr(text.str, '\n', text.size);
+        if (!new_line) {
+            break;
+        }
+        
+        count += 1;
+        text = str_skip(text, new_line - text.str + 1);
+    }
+    return count;
+}
+
+static s64 *line_index_write_line_starts(s64 *out, String text, s64 text_offset)
+{
+    u8 *text_start = text.str;
+    for (;;)
+    {
+        u8 *new_line = (u8 *)memchr(text.str, '\n', text.size);
+        if (!new_line) {
+            break;
+        }
+        
+        *out++ = text_offset + (new_line - text_start) + 1;
+        text = str_skip(text, new_line - text.str + 1);
+    }
+    return out;
+}
+
+
+static void line_index_rebuild(Text_Line_Index *index, String text)
+{
+    assert(index->line_cap >= 1);
+    assert(line_index_count_new_lines(text) < index->line_cap);
+    
+    index->line_starts[0] = 0;
+    s64 *end = line_index_write_line_starts(index->line_starts + 1, text, 0);
+    index->line_count = end - index->line_starts;
+}
+
+static void line_index_update(Text_Line_Index *index, String text,
+                              s64 edit_start, s64 edit_old_end, s64 edit_new_end)
+{
+    // Text in range [edit_start, edit_old_end) was replaced with [edit_start, edit_new_end).
+    // 'text' is the buffer after the edit.
+    // Only line starts from the edited range are spliced, the ones after it get shifted.
+    s64 delta = edit_new_end - edit_old_end;
+    
+    s64 first_removed = line_index_first_line_start_after(index, edit_start);
+    s64 first_kept = line_index_first_line_start_after(index, edit_old_end);
+    
+    String inserted = str_substr(text, edit_start, edit_new_end - edit_start);
+    s64 insert_count = line_index_count_new_lines(inserted);
+    s64 remove_count = first_kept - first_removed;
+    
+    s64 new_line_count = index->line_count - remove_count + insert_count;
+    assert(new_line_count <= index->line_cap);
+    
+    s64 *starts = index->line_starts;
+    s64 tail_count = index->line_count - first_kept;
+    memmove(starts + first_removed + insert_count, starts + first_kept, tail_count*sizeof(s64));
+    
+    line_index_write_line_starts(starts + first_removed, inserted, edit_start);
+    
+    if (delta)
+    {
+        s64 *tail = starts + first_removed + insert_count;
+        for (s64 tail_index = 0; tail_index < tail_count; tail_index += 1)
+        {
+            tail[tail_index] += delta;
+        }
+    }
+    
+    index->line_count = new_line_count;
+}
+
+
+static s64 line_index_line_from_pos(Text_Line_Index *index, s64 pos)
+{
+    // line number (starting from 0) that contains byte offset pos
+    s64 line = line_index_first_line_start_after(index, pos) - 1;
+    return get_max(0, line);
+}
+
+static s64 line_index_line_start(Text_Line_Index *index, s64 line)
+{
+    line = get_min(get_max(0, line), index->line_count - 1);
+    return index->line_starts[line];
+}
+
+static s64 line_index_line_end(Text_Line_Index *index, String text, s64 line)
+{
+    // one past the last byte of the line - new line character isn't included
+    if (line + 1 >= index->line_count) {
+        return text.size;
+    }
+    
+    line = get_max(0, line);
+    return index->line_starts[line + 1] - 1;
+}
+
+
+
+
+
+static b32 bit_array_get(u64 *bits, s64 index)
+{
+    return (bits[index >> 6] >> (index & 63)) & 1;
+}
+
+static u64 bit_array_read64(u64 *bits, s64 word_count, s64 index)
+{
+    // returns bits [index, index + 64) - bits past the end of array are zeros
+    s64 word = index >> 6;
+    u32 shift = (u32)(index & 63);
+    
+    u64 result = (word < word_count ? bits[word] >> shift : 0);
+    if (shift && word + 1 < word_count) {
+        result |= bits[word + 1] << (64 - shift);
+    }
+    return result;
+}
+
+static void bit_array_write(u64 *bits, s64 index, u64 value, u32 count)
+{
+    // writes lowest 'count' (1-64) bits of value at index
+    s64 word = index >> 6;
+    u32 shift = (u32)(index & 63);
+    u64 mask = (count == 64 ? ~0ull : ((1ull << count) - 1));
+    value &= mask;
+    
+    bits[word] = (bits[word] & ~(mask << shift)) | (value << shift);
+    if (shift + count > 64)
+    {
+        u32 low_count = 64 - shift;
+        bits[word + 1] = (bits[word + 1] & ~(mask >> low_count)) | (value >> low_count);
+    }
+}
+
+static void bit_array_fill(u64 *bits, s64 first, s64 one_past_last, b32 value)
+{
+    u64 pattern = (value ? ~0ull : 0);
+    while (first < one_past_last)
+    {
+        u32 count = (u32)get_min(64 - (first & 63), one_past_last - first);
+        bit_array_write(bits, first, pattern, count);
+        first += count;
+    }
+}
+
+static void bit_array_move(u64 *bits, s64 word_count, s64 from, s64 to, s64 count)
+{
+    // memmove for bits - 64 bits at a time
+    if (to > from)
+    {
+        while (count > 0)
+        {
+            u32 chunk = (u32)get_min(count, 64);
+            count -= chunk;
+            bit_array_write(bits, to + count, bit_array_read64(bits, word_count, from + count), chunk);
+        }
+    }
+    else if (to < from)
+    {
+        for (s64 offset = 0; offset < count; offset += 64)
+        {
+            u32 chunk = (u32)get_min(count - offset, 64);
+            bit_array_write(bits, to + offset, bit_array_read64(bits, word_count, from + offset), chunk);
+        }
+    }
+}
+
+
+
+
+
+static void word_cache_clear(Text_Word_Cache *cache)
+{
+    memset(cache->known, 0, cache->word_count*sizeof(u64));
+}
+
+static void word_cache_fill(Text_Word_Cache *cache, String text, s64 pos)
+{
+    // Segments the 64 bit block that contains pos.
+    s64 block_start = pos & ~63ll;
+    s64 block_end = get_min(block_start + 64, (s64)text.size + 1);
+    
+    // Start from a known boundary in the previous block (common when moving through the text)
+    //   or from a position that is always a boundary.
+    s64 block = block_start >> 6;
+    u64 known_boundaries = cache->known[block] & cache->boundaries[block] & 1;
+    s64 start = block_start;
+    
+    if (!known_boundaries && block > 0)
+    {
+        known_boundaries = cache->known[block - 1] & cache->boundaries[block - 1];
+        start = block_start - 64;
+    }
+    
+    Bit_Scan_Result scan = find_most_significant_bit(known_boundaries);
+    if (scan.found) {
+        start += scan.index;
+    } else {
+        start = str_word_boundary_restart_pos(text, block_start);
+    }
+    
+    while (start < block_end && start < (s64)text.size)
+    {
+        s64 next = str_next_word_boundary(text, start);
+        
+        bit_array_fill(cache->boundaries, start, next, false);
+        bit_array_fill(cache->word_starts, start, next, false);
+        bit_array_fill(cache->known, start, next, true);
+        bit_array_write(cache->boundaries, start, 1, 1);
+        bit_array_write(cache->word_starts, start, str_is_word_segment(text, start), 1);
+        
+        start = next;
+    }
+    
+    if (start == (s64)text.size)
+    {
+        bit_array_write(cache->boundaries, start, 1, 1);
+        bit_array_write(cache->word_starts, start, 0, 1);
+        bit_array_write(cache->known, start, 1, 1);
+    }
+}
+
+static void word_cache_update(Text_Word_Cache *cache, String text,
+                              s64 edit_start, s64 edit_old_end, s64 edit_new_end)
+{
+    // Text in range [edit_start, edit_old_end) was replaced with [edit_start, edit_new_end).
+    // 'text' is the buffer after the edit.
+    // Bits after the edit get shifted, the edit's neighbourhood is forgotten
+    //   up to positions that are always word boundaries on both sides.
+    // Both scans stop between ideographs and after Word_MaxRestartScan bytes, so text without spaces
+    //   doesn't make every edit cost the whole line.
+    s64 delta = edit_new_end - edit_old_end;
+    if (delta)
+    {
+        s64 old_size = (s64)text.size - delta;
+        s64 tail_count = old_size + 1 - edit_old_end;
+        bit_array_move(cache->known, cache->word_count, edit_old_end, edit_new_end, tail_count);
+        bit_array_move(cache->boundaries, cache->word_count, edit_old_end, edit_new_end, tail_count);
+        bit_array_move(cache->word_starts, cache->word_count, edit_old_end, edit_new_end, tail_count);
+    }
+    
+    s64 forget_start = str_word_boundary_restart_pos(text, edit_start);
+    s64 forget_end = str_word_boundary_safe_pos_after(text, edit_new_end);
+    bit_array_fill(cache->known, forget_start, forget_end + 1, false);
+}
+
+
+static s64 word_cache_next_boundary(Text_Word_Cache *cache, String text, s64 pos)
+{
+    // first word boundary > pos
+    pos += 1;
+    while (pos < (s64)text.size)
+    {
+        if (!bit_array_get(cache->known, pos)) {
+            word_cache_fill(cache, text, pos);
+        }
+        
+        s64 word = pos >> 6;
+        u64 mask = ~0ull << (pos & 63);
+        Bit_Scan_Result boundary = find_least_significant_bit(cache->boundaries[word] & cache->known[word] & mask);
+        Bit_Scan_Result unknown = find_least_significant_bit(~cache->known[word] & mask);
+        
+        if (boundary.found && (!unknown.found || boundary.index < unknown.index)) {
+            return word*64 + boundary.index;
+        }
+        
+        pos = (unknown.found ? word*64 + unknown.index : (word + 1)*64);
+    }
+    
+    return text.size;
+}
+
+static s64 word_cache_boundary_at_or_before(Text_Word_Cache *cache, String text, s64 pos)
+{
+    pos = get_min(pos, (s64)text.size);
+    while (pos > 0)
+    {
+        if (!bit_array_get(cache->known, pos)) {
+            word_cache_fill(cache, text, pos);
+        }
+        
+        s64 word = pos >> 6;
+        u64 mask = ~0ull >> (63 - (pos & 63));
+        Bit_Scan_Result boundary = find_most_significant_bit(cache->boundaries[word] & cache->known[word] & mask);
+        Bit_Scan_Result unknown = find_most_significant_bit(~cache->known[word] & mask);
+        
+        if (boundary.found && (!unknown.found || boundary.index > unknown.index)) {
+            return word*64 + boundary.index;
+        }
+        
+        pos = (unknown.found ? word*64 + unknown.index : word*64 - 1);
+    }
+    
+    return 0;
+}
+
+static b32 word_cache_is_word_start(Text_Word_Cache *cache, String text, s64 pos)
+{
+    if (pos >= (s64)text.size) {
+        return false;
+    }
+    if (!bit_array_get(cache->known, pos)) {
+        word_cache_fill(cache, text, pos);
+    }
+    return bit_array_get(cache->word_starts, pos);
+}
+
+
+
+
+
+static s64 text_search_match_at(Text_Search *search, String text, s64 start)
+{
+    // returns one past the end of the match at start or -1
+    String query = search->query;
+    s64 pos = start;
+    if (!search->ignore_case)
+    {
+        if (start + (s64)query.size <= (s64)text.size &&
+            memcmp(text.str + start, query.str, query.size) == 0) {
+            return start + query.size;
+        }
+        return -1;
+    }
+    
+    while (query.size)
+    {
+        if (pos >= (s64)text.size) {
+            return -1;
+        }
+        
+        Unicode_Consume text_consume = utf8_consume(text.str + pos, text.size - pos);
+        Unicode_Consume query_consume = utf8_consume(query);
+        if (unicode_codepoint_to_lower(text_consume.codepoint) !=
+            unicode_codepoint_to_lower(query_consume.codepoint)) {
+            return -1;
+        }
+        
+        pos += text_consume.inc;
+        query = str_skip(query, query_consume.inc);
+    }
+    
+    // unicode_codepoint_to_lower keeps the utf8 length - this only filters out invalid utf8
+    if (pos - start != (s64)search->query.size) {
+        return -1;
+    }
+    return pos;
+}
+
+static void text_search_scan(Text_Search *search, String text, s64 first, s64 one_past_last,
+                             Text_Match *out, s64 out_cap, s64 *out_count)
+{
+    // Finds matches that start in [first, one_past_last). Every match is query.size bytes long.
+    *out_count = 0;
+    if (!search->query.size) {
+        return;
+    }
+    
+    first = get_max(0, first);
+    one_past_last = get_min(one_past_last, (s64)text.size - (s64)search->query.size + 1);
+    u8 first_byte = search->query.str[0];
+    b32 first_byte_is_exact = (!search->ignore_case ||
+                               (first_byte < 0x80 && unicode_codepoint_to_lower(first_byte) == first_byte &&
+                                !(first_byte >= 'a' && first_byte <= 'z')));
+    
+    for (s64 pos = first; pos < one_past_last; pos += 1)
+    {
+        if (first_byte_is_exact)
+        {
+            // skip to the next candidate with memchr
+            u8 *candidate = (u8 *)memchr(text.str + pos, first_byte, one_past_last - pos);
+            if (!candidate) {
+                break;
+            }
+            pos = candidate - text.str;
+        }
+        else if (utf8_top5b_class[text.str[pos] >> 3] == 0)
+        {
+            continue; // middle of utf8 sequence
+        }
+        
+        s64 end = text_search_match_at(search, text, pos);
+        if (end >= 0)
+        {
+            if (*out_count >= out_cap) {
+                search->truncated = true;
+                break;
+            }
+            out[(*out_count)++] = {pos, end};
+        }
+    }
+}
+
+static void text_search_run(Text_Search *search, String text)
+{
+    // full search
+    search->truncated = false;
+    text_search_scan(search, text, 0, text.size, search->matches, search->match_cap, &search->match_count);
+}
+
+static void text_search_set_query(Text_Search *search, String text, String query, b32 ignore_case)
+{
+    // Extending the previous query only filters previous matches - a match of the longer query
+    //   is always a match of the shorter one.
+    query = truncate_invalid_utf8_ending(str_prefix(query, search->query.cap));
+    
+    b32 extends_query = (ignore_case == search->ignore_case && !search->truncated &&
+                         search->query.size && query.size >= search->query.size &&
+                         str_equals(str_prefix(query, search->query.size), search->query));
+    
+    memmove(search->query.str, query.str, query.size);
+    search->query.size = query.size;
+    search->ignore_case = ignore_case;
+    
+    if (!extends_query)
+    {
+        text_search_run(search, text);
+        return;
+    }
+    
+    s64 kept_count = 0;
+    for (s64 match_index = 0; match_index < search->match_count; match_index += 1)
+    {
+        s64 start = search->matches[match_index].start;
+        s64 end = text_search_match_at(search, text, start);
+        if (end >= 0) {
+            search->matches[kept_count++] = {start, end};
+        }
+    }
+    search->match_count = kept_count;
+}
+
+static s64 text_search_first_match_ending_after(Text_Search *search, s64 pos)
+{
+    // binary search - matches have the same length so their ends are sorted too
+    s64 low = 0;
+    s64 high = search->match_count;
+    
+    while (low < high)
+    {
+        s64 mid = low + (high - low) / 2;
+        if (search->matches[mid].one_past_end <= pos) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    
+    return low;
+}
+
+static void text_search_update(Text_Search *search, String text,
+                               s64 edit_start, s64 edit_old_end, s64 edit_new_end)
+{
+    // Text in range [edit_start, edit_old_end) was replaced with [edit_start, edit_new_end).
+    // 'text' is the buffer after the edit.
+    // Matches that touched the edited range are dropped, matches after it are shifted
+    //   and only the window around the edit is scanned again.
+    if (search->truncated) {
+        text_search_run(search, text);
+        return;
+    }
+    if (!search->query.size) {
+        return;
+    }
+    
+    // decoding of a codepoint (or invalid utf8) at the end of a match can depend on up to 3 bytes after it
+    s64 context = (search->ignore_case ? 3 : 0);
+    
+    s64 delta = edit_new_end - edit_old_end;
+    s64 first_removed = text_search_first_match_ending_after(search, edit_start - context);
+    s64 first_kept = first_removed;
+    while (first_kept < search->match_count && search->matches[first_kept].start < edit_old_end) {
+        first_kept += 1;
+    }
+    
+    // new matches have to start in this window
+    s64 window_start = edit_start - context - (s64)search->query.size + 1;
+    s64 window_end = edit_new_end;
+    if (edit_new_end == edit_start) {
+        window_end = edit_start; // deletion - only matches that cross the edit point are new
+    }
+    
+    Text_Match window_matches[64];
+    s64 window_count = 0;
+    text_search_scan(search, text, window_start, window_end,
+                     window_matches, array_count(window_matches), &window_count);
+    if (search->truncated)
+    {
+        text_search_run(search, text); // huge paste with a lot of matches
+        return;
+    }
+    
+    s64 removed_count = first_kept - first_removed;
+    s64 tail_count = search->match_count - first_kept;
+    s64 new_count = search->match_count - removed_count + window_count;
+    if (new_count > search->match_cap)
+    {
+        text_search_run(search, text);
+        return;
+    }
+    
+    Text_Match *matches = search->matches;
+    memmove(matches + first_removed + window_count, matches + first_kept, tail_count*sizeof(Text_Match));
+    memcpy(matches + first_removed, window_matches, window_count*sizeof(Text_Match));
+    
+    if (delta)
+    {
+        Text_Match *tail = matches + first_removed + window_count;
+        for (s64 tail_index = 0; tail_index < tail_count; tail_index += 1)
+        {
+            tail[tail_index].start += delta;
+            tail[tail_index].one_past_end += delta;
+        }
+    }
+    
+    search->match_count = new_count;
+}
+
+
+
+static u32 text_fuzzy_presence_bit(u32 lower_codepoint)
+{
+    // 26 bits for ascii letters, one for digits, one for other ascii,
+    //   the rest of codepoints is spread over the last 4 bits
+    if (lower_codepoint >= 'a' && lower_codepoint <= 'z') {
+        return 1u << (lower_codepoint - 'a');
+    }
+    if (lower_codepoint >= '0' && lower_codepoint <= '9') {
+        return 1u << 26;
+    }
+    if (lower_codepoint < 0x80) {
+        return 1u << 27;
+    }
+    return 1u << (28 + (lower_codepoint & 3));
+}
+
+static u32 text_fuzzy_presence_mask(String text)
+{
+    u32 result = 0;
+    u64 pos = 0;
+    while (pos < text.size)
+    {
+        u8 byte = text.str[pos];
+        if (byte < 0x80)
+        {
+            u32 lower = ((byte >= 'A' && byte <= 'Z') ? (u32)byte + 32 : byte);
+            result |= text_fuzzy_presence_bit(lower);
+            pos += 1;
+        }
+        else
+        {
+            Unicode_Consume consume = utf8_consume(text.str + pos, text.size - pos);
+            result |= text_fuzzy_presence_bit(unicode_codepoint_to_lower(consume.codepoint));
+            pos += consume.inc;
+        }
+    }
+    return result;
+}
+
+static b32 text_fuzzy_is_separator(u32 codepoint)
+{
+    if (codepoint >= 0x80) {
+        return false;
+    }
+    b32 is_alnum = ((codepoint >= 'a' && codepoint <= 'z') || (codepoint >= 'A' && codepoint <= 'Z') ||
+                    (codepoint >= '0' && codepoint <= '9'));
+    return !is_alnum;
+}
+
+static b32 text_fuzzy_score(String candidate, String query, s32 *out_score)
+{
+    // Returns false if the query isn't a subsequence of the candidate.
+    // Going forward finds where the first match ends, going backward from there finds
+    //   the shortest match - only that range gets scored.
+    // Matches at the start of the candidate, after separators and on camelCase humps get a bonus,
+    //   so do consecutive matches. Gaps cost a little.
+    String query_left = query;
+    u64 match_end = 0;
+    while (query_left.size)
+    {
+        if (match_end >= candidate.size) {
+            return false;
+        }
+        
+        Unicode_Consume query_cp = utf8_consume(query_left);
+        u32 query_lower = unicode_codepoint_to_lower(query_cp.codepoint);
+        Unicode_Consume consume = utf8_consume(candidate.str + match_end, candidate.size - match_end);
+        match_end += consume.inc;
+        
+        if (unicode_codepoint_to_lower(consume.codepoint) == query_lower) {
+            query_left = str_skip(query_left, query_cp.inc);
+        }
+    }
+    
+    u64 match_start = match_end;
+    u64 query_end = query.size;
+    while (query_end && match_start)
+    {
+        Unicode_Consume_Reverse query_cp = utf8_consume_reverse(query.str, query_end);
+        Unicode_Consume_Reverse consume = utf8_consume_reverse(candidate.str, match_start);
+        match_start -= consume.dec;
+        
+        if (unicode_codepoint_to_lower(consume.codepoint) == unicode_codepoint_to_lower(query_cp.codepoint)) {
+            query_end -= query_cp.dec;
+        }
+    }
+    
+    s32 score = 0;
+    u32 prev_codepoint = 0;
+    b32 prev_matched = false;
+    if (match_start) {
+        prev_codepoint = utf8_consume_reverse(candidate.str, match_start).codepoint;
+    }
+    
+    query_left = query;
+    u64 pos = match_start;
+    while (pos < match_end)
+    {
+        Unicode_Consume consume = utf8_consume(candidate.str + pos, candidate.size - pos);
+        u32 lower = unicode_codepoint_to_lower(consume.codepoint);
+        Unicode_Consume query_cp = utf8_consume(query_left);
+        
+        b32 matched = (query_left.size && lower == unicode_codepoint_to_lower(query_cp.codepoint));
+        if (matched)
+        {
+            query_left = str_skip(query_left, query_cp.inc);
+            score += 16;
+            
+            if (pos == 0) {
+                score += 10;
+            } else if (text_fuzzy_is_separator(prev_codepoint)) {
+                score += 8;
+            } else if (lower != consume.codepoint && prev_codepoint == unicode_codepoint_to_lower(prev_codepoint)) {
+                score += 6; // camelCase hump
+            }
+            
+            if (prev_matched) {
+                score += 4;
+            }
+        }
+        else
+        {
+            score -= (prev_matched ? 3 : 1);
+        }
+        
+        prev_codepoint = consume.codepoint;
+        prev_matched = matched;
+        pos += consume.inc;
+    }
+    
+    *out_score = score;
+    return true;
+}
+
+static void text_fuzzy_try_add(Text_Fuzzy_Matcher *matcher, u32 candidate_index)
+{
+    s32 score = 0;
+    if (text_fuzzy_score(matcher->candidates[candidate_index], matcher->query, &score))
+    {
+        matcher->matches[matcher->match_count] = candidate_index;
+        matcher->scores[matcher->match_count] = score;
+        matcher->match_count += 1;
+    }
+}
+
+static void text_fuzzy_run(Text_Fuzzy_Matcher *matcher)
+{
+    // Scores all candidates that pass the presence mask test.
+    matcher->match_count = 0;
+    __m128i query_mask = _mm_set1_epi32((s32)matcher->query_mask);
+    
+    for (s64 group = 0; group < matcher->candidate_count; group += 4)
+    {
+        __m128i masks = _mm_loadu_si128((__m128i *)(matcher->candidate_masks + group));
+        __m128i has_all = _mm_cmpeq_epi32(_mm_and_si128(masks, query_mask), query_mask);
+        u32 pass_bits = (u32)_mm_movemask_ps(_mm_castsi128_ps(has_all));
+        
+        while (pass_bits)
+        {
+            s64 candidate_index = group + find_least_significant_bit(pass_bits).index;
+            pass_bits &= pass_bits - 1;
+            
+            if (candidate_index < matcher->candidate_count) { // padding at the end
+                text_fuzzy_try_add(matcher, (u32)candidate_index);
+            }
+        }
+    }
+}
+
+static void text_fuzzy_set_candidates(Text_Fuzzy_Matcher *matcher, String *candidates, s64 candidate_count)
+{
+    matcher->candidates = candidates;
+    matcher->candidate_count = candidate_count;
+    
+    s64 padded_count = (candidate_count + 3) & ~3ll;
+    for (s64 candidate_index = 0; candidate_index < padded_count; candidate_index += 1)
+    {
+        matcher->candidate_masks[candidate_index] =
+            (candidate_index < candidate_count ? text_fuzzy_presence_mask(candidates[candidate_index]) : 0);
+    }
+    
+    text_fuzzy_run(matcher);
+}
+
+static b32 text_fuzzy_is_subsequence(String shorter, String longer)
+{
+    // case insensitive, by codepoints
+    while (shorter.size)
+    {
+        if (!longer.size) {
+            return false;
+        }
+        
+        Unicode_Consume a = utf8_consume(shorter);
+        Unicode_Consume b = utf8_consume(longer);
+        longer = str_skip(longer, b.inc);
+        
+        if (unicode_codepoint_to_lower(a.codepoint) == unicode_codepoint_to_lower(b.codepoint)) {
+            shorter = str_skip(shorter, a.inc);
+        }
+    }
+    return true;
+}
+
+static void text_fuzzy_set_query(Text_Fuzzy_Matcher *matcher, String query)
+{
+    // If the previous query is a subsequence of the new one (typical when the user appends characters)
+    //   only the previous matches can still match - they get filtered in place.
+    query = truncate_invalid_utf8_ending(str_prefix(query, matcher->query.cap));
+    b32 refine = text_fuzzy_is_subsequence(matcher->query, query);
+    
+    memmove(matcher->query.str, query.str, query.size);
+    matcher->query.size = query.size;
+    matcher->query_mask = text_fuzzy_presence_mask(query);
+    
+    if (!refine)
+    {
+        text_fuzzy_run(matcher);
+        return;
+    }
+    
+    s64 previous_count = matcher->match_count;
+    matcher->match_count = 0;
+    for (s64 match_index = 0; match_index < previous_count; match_index += 1)
+    {
+        u32 candidate_index = matcher->matches[match_index];
+        u32 mask = matcher->candidate_masks[candidate_index];
+        if ((mask & matcher->query_mask) == matcher->query_mask) {
+            text_fuzzy_try_add(matcher, candidate_index);
+        }
+    }
+}
+
+static s64 text_fuzzy_top(Text_Fuzzy_Matcher *matcher, u32 *out_candidates, s64 out_cap)
+{
+    // Best matches sorted by score (ties: shorter candidate, then lower index) - up to 64 of them.
+    // Returns count of written candidate indices.
+    s64 count = 0;
+    s32 out_scores[64];
+    out_cap = get_min(out_cap, (s64)array_count(out_scores));
+    
+    for (s64 match_index = 0; match_index < matcher->match_count; match_index += 1)
+    {
+        u32 candidate_index = matcher->matches[match_index];
+        s32 score = matcher->scores[match_index];
+        u64 size = matcher->candidates[candidate_index].size;
+        
+        s64 insert_at = count;
+        while (insert_at > 0)
+        {
+            s32 other_score = out_scores[insert_at - 1];
+            u64 other_size = matcher->candidates[out_candidates[insert_at - 1]].size;
+            if (other_score > score || (other_score == score && other_size <= size)) {
+                break;
+            }
+            insert_at -= 1;
+        }
+        
+        if (insert_at >= out_cap) {
+            continue;
+        }
+        
+        s64 move_count = get_min(count, out_cap - 1) - insert_at;
+        memmove(out_candidates + insert_at + 1, out_candidates + insert_at, move_count*sizeof(u32));
+        memmove(out_scores + insert_at + 1, out_scores + insert_at, move_count*sizeof(s32));
+        out_candidates[insert_at] = candidate_index;
+        out_scores[insert_at] = score;
+        count = get_min(count + 1, out_cap);
+    }
+    
+    return count;
+}
+
+
+
+
+
+struct Text_Replace_Range_Result
+{
+    b32 did_anything;
+    s64 cursor_pos;
+};
+
+static Text_Replace_Range_Result text_replace_range(Mutable_String *buffer,
+                                                    s64 selection_start, s64 one_past_selection_end,
+                                                    String insert_text)
+{
+    selection_start = get_min(get_max(0, selection_start), (s64)buffer->size);
+    one_past_selection_end = get_min(get_max(0, one_past_selection_end), (s64)buffer->size);
+    
+    if (selection_start > one_past_selection_end)
+    {
+        s64 temp = selection_start;
+        selection_start = one_past_selection_end;
+        one_past_selection_end = temp;
+    }
+    
+    Text_Replace_Range_Result result = {};
+    
+    s64 to_delete = one_past_selection_end - selection_start;
+    s64 initial_buffer_size_delta = insert_text.size - to_delete;
+    
+    { // truncate insert_text to fit in the buffer;
+        s64 max_positive_buffer_delta = buffer->cap - buffer->size;
+        
+        if (max_positive_buffer_delta < initial_buffer_size_delta)
+        {
+            s64 reduce_size = initial_buffer_size_delta - max_positive_buffer_delta;
+            assert((s64)insert_text.size >= reduce_size);
+            
+            insert_text.size -= reduce_size;
+            insert_text = truncate_invalid_utf8_ending(insert_text);
+        }
+    }
+    
+    s64 buffer_size_delta = insert_text.size - to_delete;
+    
+    if ((!buffer_size_delta && !to_delete) ||
+        (initial_buffer_size_delta > 0 && buffer_size_delta < 0))
+    {
+        return result;
+    }
+    
+    
+    if (buffer_size_delta > 0)
+    {
+        for (s64 index = buffer->size - 1;
+             index >= one_past_selection_end;
+             index -= 1)
+        {
+            buffer->str[index + buffer_size_delta] = buffer->str[index];
+        }
+    }
+    else if (buffer_size_delta < 0)
+    {
+        for (s64 index = one_past_selection_end;
+             index < (s64)buffer->size;
+             index += 1)
+        {
+            buffer->str[index + buffer_size_delta] = buffer->str[index];
+        }
+    }
+    
+    
+    for (u64 index = 0; index < insert_text.size; index += 1)
+    {
+        buffer->str[selection_start + index] = insert_text.str[index];
+    }
+    
+    buffer->size += buffer_size_delta;
+    
+    result.did_anything = true;
+    result.cursor_pos = selection_start + insert_text.size;
+    return result;
+}
+
+
+
+
+static s64 text_cursor_min(Text_Cursor cursor) {
+    return get_min(cursor.cursor_pos, cursor.mark_pos);
+}
+static s64 text_cursor_max(Text_Cursor cursor) {
+    return get_max(cursor.cursor_pos, cursor.mark_pos);
+}
+
+
+
+struct Text_Edit
+{
+    s64 start, one_past_end; // range that gets replaced
+    String replacement;
+};
+
+template <typename Get_Edit>
+static void text_shift_segments_between_edits(Mutable_String *buffer, u64 edit_count,
+                                              s64 buffer_size_delta, Get_Edit get_edit)
+{
+    // Moves text between sorted, non-overlapping edits to its final position (edit ranges are left as gaps).
+    // Text that follows an edit gets shifted by the sum of size deltas of all edits up to it.
+    // Segments that move left are moved front to back, segments that move right - back to front.
+    // Destination of a segment never overlaps source of a segment that wasn't moved yet,
+    //   so every byte of the tail is moved at most once.
+    s64 shift = 0;
+    for (u64 edit_index = 0; edit_index < edit_count; edit_index += 1)
+    {
+        Text_Edit edit = get_edit(edit_index);
+        shift += (s64)edit.replacement.size - (edit.one_past_end - edit.start);
+        
+        s64 segment_start = edit.one_past_end;
+        s64 segment_end = (edit_index + 1 < edit_count ?
+                           get_edit(edit_index + 1).start : (s64)buffer->size);
+        
+        if (shift < 0) {
+            memmove(buffer->str + segment_start + shift, buffer->str + segment_start, segment_end - segment_start);
+        }
+    }
+    
+    shift = buffer_size_delta;
+    for (s64 edit_index = (s64)edit_count - 1; edit_index >= 0; edit_index -= 1)
+    {
+        Text_Edit edit = get_edit(edit_index);
+        
+        s64 segment_start = edit.one_past_end;
+        s64 segment_end = (edit_index + 1 < (s64)edit_count ?
+                           get_edit(edit_index + 1).start : (s64)buffer->size);
+        
+        if (shift > 0) {
+            memmove(buffer->str + segment_start + shift, buffer->str + segment_start, segment_end - segment_start);
+        }
+        
+        shift -= (s64)edit.replacement.size - (edit.one_past_end - edit.start);
+    }
+}
+
+
+static b32 text_replace_ranges(Mutable_String *buffer,
+                               Text_Cursor *cursors, u32 cursor_count,
+                               String insert_text)
+{
+    // Replaces selection of every cursor with insert_text in a single pass over the buffer.
+    // Cursors need to be sorted with non-overlapping selections (see text_input_normalize_cursors).
+    // Every cursor ends up after its copy of insert_text with an empty selection.
+    
+    if (!cursor_count) {
+        return false;
+    }
+    
+    s64 total_delete = 0;
+    for (u32 cursor_index = 0; cursor_index < cursor_count; cursor_index += 1)
+    {
+        Text_Cursor *cursor = cursors + cursor_index;
+        cursor->cursor_pos = get_min(get_max(0, cursor->cursor_pos), (s64)buffer->size);
+        cursor->mark_pos = get_min(get_max(0, cursor->mark_pos), (s64)buffer->size);
+        total_delete += text_cursor_max(*cursor) - text_cursor_min(*cursor);
+    }
+    
+    s64 count = cursor_count;
+    s64 initial_buffer_size_delta = count*insert_text.size - total_delete;
+    
+    { // truncate insert_text so every copy fits in the buffer
+        s64 max_positive_buffer_delta = buffer->cap - buffer->size;
+        
+        if (max_positive_buffer_delta < initial_buffer_size_delta)
+        {
+            s64 max_insert_size = (max_positive_buffer_delta + total_delete) / count;
+            assert((s64)insert_text.size >= max_insert_size);
+            
+            insert_text.size = max_insert_size;
+            insert_text = truncate_invalid_utf8_ending(insert_text);
+        }
+    }
+    
+    s64 insert_size = insert_text.size;
+    s64 buffer_size_delta = count*insert_size - total_delete;
+    
+    if ((!insert_size && !total_delete) ||
+        (initial_buffer_size_delta > 0 && buffer_size_delta < 0))
+    {
+        return false;
+    }
+    
+    
+    text_shift_segments_between_edits(buffer, cursor_count, buffer_size_delta, [&](u64 index) {
+        Text_Edit edit = {text_cursor_min(cursors[index]), text_cursor_max(cursors[index]), insert_text};
+        return edit;
+    });
+    
+    
+    // fill the gaps & remap cursors
+    s64 shift = 0;
+    for (u32 cursor_index = 0; cursor_index < cursor_count; cursor_index += 1)
+    {
+        Text_Cursor *cursor = cursors + cursor_index;
+        s64 selection_start = text_cursor_min(*cursor);
+        s64 to_delete = text_cursor_max(*cursor) - selection_start;
+        s64 new_start = selection_start + shift;
+        
+        memcpy(buffer->str + new_start, insert_text.str, insert_size);
+        cursor->cursor_pos = cursor->mark_pos = new_start + insert_size;
+        
+        shift += insert_size - to_delete;
+    }
+    
+    buffer->size += buffer_size_delta;
+    return true;
+}
+
+
+
+static b32 text_apply_edits(Mutable_String *buffer, Text_Edit *sorted_edits, u64 edit_count)
+{
+    // Applies a sorted list of non-overlapping edits in a single pass over the buffer.
+    // Capacity is checked once for the whole batch - if the result doesn't fit,
+    //   replacements get truncated starting from the last edit (the same way text_replace_range does it).
+    // Edits are updated in place: ranges get clamped to the buffer and
+    //   replacement sizes reflect what was actually inserted.
+    
+    s64 total_delete = 0;
+    s64 total_insert = 0;
+    s64 prev_end = 0;
+    
+    for (u64 edit_index = 0; edit_index < edit_count; edit_index += 1)
+    {
+        Text_Edit *edit = sorted_edits + edit_index;
+        edit->start = get_min(get_max(0, edit->start), (s64)buffer->size);
+        edit->one_past_end = get_min(get_max(0, edit->one_past_end), (s64)buffer->size);
+        assert(edit->start <= edit->one_past_end && edit->start >= prev_end);
+        prev_end = edit->one_past_end;
+        
+        total_delete += edit->one_past_end - edit->start;
+        total_insert += edit->replacement.size;
+    }
+    
+    s64 initial_buffer_size_delta = total_insert - total_delete;
+    
+    { // truncate replacements (from the back) to fit in the buffer
+        s64 max_positive_buffer_delta = buffer->cap - buffer->size;
+        s64 reduce_size = initial_buffer_size_delta - max_positive_buffer_delta;
+        
+        for (s64 edit_index = (s64)edit_count - 1;
+             edit_index >= 0 && reduce_size > 0;
+             edit_index -= 1)
+        {
+            String *replacement = &sorted_edits[edit_index].replacement;
+            u64 initial_size = replacement->size;
+            
+            replacement->size -= get_min((u64)reduce_size, replacement->size);
+            *replacement = truncate_invalid_utf8_ending(*replacement);
+            
+            reduce_size -= initial_size - replacement->size;
+            total_insert -= initial_size - replacement->size;
+        }
+    }
+    
+    s64 buffer_size_delta = total_insert - total_delete;
+    
+    if ((!total_insert && !total_delete) ||
+        (initial_buffer_size_delta > 0 && buffer_size_delta < 0))
+    {
+        return false;
+    }
+    
+    
+    text_shift_segments_between_edits(buffer, edit_count, buffer_size_delta, [&](u64 index) {
+        return sorted_edits[index];
+    });
+    
+    
+    s64 shift = 0;
+    for (u64 edit_index = 0; edit_index < edit_count; edit_index += 1)
+    {
+        Text_Edit edit = sorted_edits[edit_index];
+        memcpy(buffer->str + edit.start + shift, edit.replacement.str, edit.replacement.size);
+        shift += (s64)edit.replacement.size - (edit.one_past_end - edit.start);
+    }
+    
+    buffer->size += buffer_size_delta;
+    return true;
+}
+
+
+struct Text_Edit_Remap
+{
+    // Maps positions from before text_apply_edits to positions after it.
+    // Positions have to be queried in ascending order.
+    Text_Edit *edits;
+    u64 edit_count;
+    u64 edit_index;
+    s64 shift;
+};
+
+static s64 text_remap_pos(Text_Edit_Remap *remap, s64 pos)
+{
+    while (remap->edit_index < remap->edit_count)
+    {
+        Text_Edit edit = remap->edits[remap->edit_index];
+        if (pos < edit.one_past_end ||
+            (pos == edit.start && edit.start == edit.one_past_end)) {
+            // positions inside of a replaced range land after the replacement
+            if (pos >= edit.start) {
+                pos = edit.start + (s64)edit.replacement.size;
+                return pos + remap->shift;
+            }
+            break;
+        }
+        
+        remap->shift += (s64)edit.replacement.size - (edit.one_past_end - edit.start);
+        remap->edit_index += 1;
+    }
+    
+    return pos + remap->shift;
+}
+
+
+
+static s64 selection_set_first_ending_after(Text_Selection_Set *set, s64 pos)
+{
+    // index of the first range with one_past_end > pos (binary search)
+    s64 low = 0;
+    s64 high = set->count;
+    
+    while (low < high)
+    {
+        s64 mid = low + (high - low) / 2;
+        if (set->ranges[mid].one_past_end <= pos) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    
+    return low;
+}
+
+static s64 selection_set_first_starting_after(Text_Selection_Set *set, s64 pos)
+{
+    // index of the first range with start > pos (binary search)
+    s64 low = 0;
+    s64 high = set->count;
+    
+    while (low < high)
+    {
+        s64 mid = low + (high - low) / 2;
+        if (set->ranges[mid].start <= pos) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    
+    return low;
+}
+
+static s64 selection_set_find(Text_Selection_Set *set, s64 pos)
+{
+    // Returns index of the range that contains pos or -1.
+    s64 index = selection_set_first_ending_after(set, pos);
+    if (index < set->count && set->ranges[index].start <= pos) {
+        return index;
+    }
+    return -1;
+}
+
+static b32 selection_set_insert(Text_Selection_Set *set, Text_Range range)
+{
+    // Ranges that overlap or touch the new one get merged with it.
+    // Returns false if there was no space left (the set doesn't change).
+    if (range.start >= range.one_past_end) {
+        return true;
+    }
+    
+    s64 first = selection_set_first_ending_after(set, range.start - 1);
+    s64 one_past_last = selection_set_first_starting_after(set, range.one_past_end);
+    
+    if (first == one_past_last)
+    {
+        if (set->count >= set->cap) {
+            return false;
+        }
+        memmove(set->ranges + first + 1, set->ranges + first, (set->count - first)*sizeof(Text_Range));
+        set->ranges[first] = range;
+        set->count += 1;
+        return true;
+    }
+    
+    Text_Range merged = {
+        get_min(range.start, set->ranges[first].start),
+        get_max(range.one_past_end, set->ranges[one_past_last - 1].one_past_end)
+    };
+    set->ranges[first] = merged;
+    
+    s64 removed_count = one_past_last - first - 1;
+    memmove(set->ranges + first + 1, set->ranges + one_past_last, (set->count - one_past_last)*sizeof(Text_Range));
+    set->count -= removed_count;
+    return true;
+}
+
+static b32 selection_set_remove(Text_Selection_Set *set, Text_Range range)
+{
+    // Removes positions of range from the set - a range that contains it gets split in two.
+    // Returns false if there was no space left for the split (the set doesn't change).
+    if (range.start >= range.one_past_end) {
+        return true;
+    }
+    
+    s64 first = selection_set_first_ending_after(set, range.start);
+    s64 one_past_last = selection_set_first_starting_after(set, range.one_past_end - 1);
+    if (first >= one_past_last) {
+        return true;
+    }
+    
+    Text_Range head = {set->ranges[first].start, range.start};
+    Text_Range tail = {range.one_past_end, set->ranges[one_past_last - 1].one_past_end};
+    s64 kept_count = (head.start < head.one_past_end) + (tail.start < tail.one_past_end);
+    s64 new_count = set->count - (one_past_last - first) + kept_count;
+    if (new_count > set->cap) {
+        return false;
+    }
+    
+    memmove(set->ranges + first + kept_count, set->ranges + one_past_last, (set->count - one_past_last)*sizeof(Text_Range));
+    s64 write_index = first;
+    if (head.start < head.one_past_end) {
+        set->ranges[write_index++] = head;
+    }
+    if (tail.start < tail.one_past_end) {
+        set->ranges[write_index++] = tail;
+    }
+    set->count = new_count;
+    return true;
+}
+
+static void selection_set_remap(Text_Selection_Set *set, Text_Edit *sorted_edits, u64 edit_count)
+{
+    // Moves all ranges after text_apply_edits (see text_remap_pos) in one pass.
+    // Ranges that were completely replaced disappear, ranges that end up touching get merged.
+    Text_Edit_Remap remap = {sorted_edits, edit_count};
+    s64 kept_count = 0;
+    
+    for (s64 range_index = 0; range_index < set->count; range_index += 1)
+    {
+        Text_Range range = set->ranges[range_index];
+        range.start = text_remap_pos(&remap, range.start);
+        range.one_past_end = text_remap_pos(&remap, range.one_past_end);
+        
+        if (range.start >= range.one_past_end) {
+            continue;
+        }
+        
+        if (kept_count && set->ranges[kept_count - 1].one_past_end >= range.start) {
+            set->ranges[kept_count - 1].one_past_end = get_max(set->ranges[kept_count - 1].one_past_end, range.one_past_end);
+        } else {
+            set->ranges[kept_count++] = range;
+        }
+    }
+    
+    set->count = kept_count;
+}
+
+
+
+static b32 text_cursors_overlap(Text_Cursor a, Text_Cursor b)
+{
+    // expects: text_cursor_min(a) <= text_cursor_min(b)
+    // Touching selections stay separate, empty cursors merge with anything they touch.
+    s64 a_min = text_cursor_min(a), a_max = text_cursor_max(a);
+    s64 b_min = text_cursor_min(b), b_max = text_cursor_max(b);
+    return (b_min < a_max || b_min == a_min ||
+            (b_min == a_max && (a_min == a_max || b_min == b_max)));
+}
+
+static void text_input_normalize_cursors(Text_Input *text_input)
+{
+    // Restores sorted order of the cursors array & merges overlapping cursors.
+    // Main cursor is copied back to cursor_pos & mark_pos.
+    if (!text_input->cursor_count) {
+        return;
+    }
+    
+    Text_Cursor *cursors = text_input->cursors;
+    u32 count = text_input->cursor_count;
+    u32 primary = text_input->primary_cursor_index;
+    
+    // Cursors move monotonically so only the main cursor can get out of order
+    //   (it can be moved directly - by mouse for example).
+    while (primary > 0 &&
+           text_cursor_min(cursors[primary]) < text_cursor_min(cursors[primary - 1]))
+    {
+        Text_Cursor temp = cursors[primary];
+        cursors[primary] = cursors[primary - 1];
+        cursors[primary - 1] = temp;
+        primary -= 1;
+    }
+    while (primary + 1 < count &&
+           text_cursor_min(cursors[primary + 1]) < text_cursor_min(cursors[primary]))
+    {
+        Text_Cursor temp = cursors[primary];
+        cursors[primary] = cursors[primary + 1];
+        cursors[primary + 1] = temp;
+        primary += 1;
+    }
+    
+    u32 write_index = 0;
+    for (u32 read_index = 1; read_index < count; read_index += 1)
+    {
+        Text_Cursor *last = cursors + write_index;
+        Text_Cursor next = cursors[read_index];
+        
+        if (text_cursors_overlap(*last, next))
+        {
+            s64 merged_min = text_cursor_min(*last);
+            s64 merged_max = get_max(text_cursor_max(*last), text_cursor_max(next));
+            
+            if (last->cursor_pos >= last->mark_pos) {
+                last->mark_pos = merged_min;
+                last->cursor_pos = merged_max;
+            } else {
+                last->cursor_pos = merged_min;
+                last->mark_pos = merged_max;
+            }
+        }
+        else
+        {
+            write_index += 1;
+            cursors[write_index] = next;
+        }
+        
+        if (read_index == primary) {
+            primary = write_index;
+        }
+    }
+    
+    text_input->cursor_count = write_index + 1;
+    text_input->primary_cursor_index = primary;
+    text_input->cursor_pos = cursors[primary].cursor_pos;
+    text_input->mark_pos = cursors[primary].mark_pos;
+}
+
+static void text_input_load_main_cursor(Text_Input *text_input)
+{
+    if (text_input->cursor_count)
+    {
+        Text_Cursor *primary = text_input->cursors + text_input->primary_cursor_index;
+        primary->cursor_pos = text_input->cursor_pos;
+        primary->mark_pos = text_input->mark_pos;
+        text_input_normalize_cursors(text_input);
+    }
+}
+
+static b32 text_input_add_cursor(Text_Input *text_input, s64 cursor_pos, s64 mark_pos)
+{
+    // Adds a new cursor which becomes the main one - old main cursor stays as an additional cursor.
+    // Returns false if there is no space left for more cursors.
+    if (text_input->cursor_count + (text_input->cursor_count ? 1 : 2) > text_input->cursor_cap) {
+        return false;
+    }
+    
+    if (!text_input->cursor_count)
+    {
+        text_input->cursor_count = 1;
+        text_input->primary_cursor_index = 0;
+    }
+    text_input_load_main_cursor(text_input);
+    
+    s64 max_pos = (s64)text_input->buffer.size;
+    Text_Cursor *cursor = text_input->cursors + text_input->cursor_count;
+    cursor->cursor_pos = get_min(get_max(0, cursor_pos), max_pos);
+    cursor->mark_pos = get_min(get_max(0, mark_pos), max_pos);
+    
+    text_input->primary_cursor_index = text_input->cursor_count;
+    text_input->cursor_count += 1;
+    text_input_normalize_cursors(text_input);
+    
+    text_input->is_dirty = true;
+    return true;
+}
+
+static void text_input_clear_additional_cursors(Text_Input *text_input)
+{
+    text_input->cursor_count = 0;
+    text_input->primary_cursor_index = 0;
+}
+
+
+
+static s64 text_layout_first_after_byte(Text_Layout *layout, s64 byte_index)
+{
+    // index of the first boundary with byte_index > byte_index (binary search)
+    s64 low = 0;
+    s64 high = layout->count;
+    
+    while (low < high)
+    {
+        s64 mid = low + (high - low) / 2;
+        if (layout->boundaries[mid].byte_index <= byte_index) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    
+    return low;
+}
+
+static f32 text_layout_x_of(Text_Layout *layout, s64 byte_index)
+{
+    // Positions outside of the layout get clamped to its ends.
+    if (!layout->count) {
+        return 0.f;
+    }
+    s64 index = text_layout_first_after_byte(layout, byte_index);
+    return layout->boundaries[get_max(index - 1, 0)].x;
+}
+
+static s64 text_layout_last_at_or_before_x(Text_Layout *layout, s64 first, s64 one_past_last, f32 x)
+{
+    // index of the last boundary in [first, one_past_last) with x <= x (first if there is none)
+    s64 low = first;
+    s64 high = one_past_last;
+    
+    while (low < high)
+    {
+        s64 mid = low + (high - low) / 2;
+        if (layout->boundaries[mid].x <= x) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    
+    return get_max(low - 1, first);
+}
+
+static s64 text_layout_last_at_or_before_x(Text_Layout *layout, f32 x)
+{
+    return text_layout_last_at_or_before_x(layout, 0, layout->count, x);
+}
+
+static s64 text_layout_nearest(Text_Layout *layout, s64 first, s64 one_past_last, f32 x)
+{
+    // index of the boundary in [first, one_past_last) that is the closest to x
+    // Boundaries with the same x (zero width glyphs like combining marks) resolve to the last one -
+    //   cursor doesn't land inside of a grapheme.
+    Text_Layout_Boundary *boundaries = layout->boundaries;
+    s64 index = text_layout_last_at_or_before_x(layout, first, one_past_last, x);
+    
+    if (index + 1 < one_past_last &&
+        boundaries[index + 1].x - x < x - boundaries[index].x) {
+        index += 1;
+    }
+    while (index + 1 < one_past_last && boundaries[index + 1].x == boundaries[index].x) {
+        index += 1;
+    }
+    return index;
+}
+
+static s64 text_layout_hit_test(Text_Layout *layout, f32 x)
+{
+    // Mouse placement - byte offset of the boundary closest to x (relative to the start of the text).
+    // Layout has to be up to date.
+    if (!layout->count) {
+        return 0;
+    }
+    s64 index = text_layout_nearest(layout, 0, layout->count, x);
+    return layout->boundaries[index].byte_index;
+}
+
+static s64 text_layout_hit_test_lines(Text_Layout *layout, Text_Line_Index *lines, String text,
+                                      f32 x, f32 y, f32 line_height)
+{
+    // Multi-line version - x is relative to the start of a line, y to the top of the first line.
+    // Positions above/below the text land on the first/last line.
+    if (!layout->count) {
+        return 0;
+    }
+    
+    s64 line = (y > 0.f ? (s64)(y / line_height) : 0);
+    line = get_min(line, lines->line_count - 1);
+    s64 line_start = line_index_line_start(lines, line);
+    s64 line_end = line_index_line_end(lines, text, line);
+    
+    s64 first = text_layout_first_after_byte(layout, line_start) - 1;
+    s64 one_past_last = text_layout_first_after_byte(layout, line_end);
+    f32 line_x = layout->boundaries[first].x;
+    
+    s64 index = text_layout_nearest(layout, first, one_past_last, line_x + x);
+    return layout->boundaries[index].byte_index;
+}
+
+static void text_layout_invalidate(Text_Layout *layout, s64 edit_start)
+{
+    // Boundaries before edit_start keep their positions.
+    // The one at edit_start can move - kerning with the glyph that follows it might change.
+    layout->count = text_layout_first_after_byte(layout, edit_start - 1);
+}
+
+
+
+static s64 text_wrap_first_row_after(Text_Wrap *wrap, s64 pos)
+{
+    // returns index of the first row start that is > pos (binary search)
+    s64 low = 0;
+    s64 high = wrap->row_count;
+    
+    while (low < high)
+    {
+        s64 mid = low + (high - low) / 2;
+        if (wrap->row_starts[mid] <= pos) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    
+    return low;
+}
+
+static s64 text_wrap_row_from_pos(Text_Wrap *wrap, s64 pos)
+{
+    // Position at a soft break belongs to the row that starts there.
+    s64 row = text_wrap_first_row_after(wrap, pos) - 1;
+    return get_max(0, row);
+}
+
+static s64 text_wrap_row_end(Text_Wrap *wrap, String text, s64 row)
+{
+    // one past the last byte of the row - new line character isn't included
+    if (row + 1 >= wrap->row_count) {
+        return text.size;
+    }
+    
+    s64 next_start = wrap->row_starts[get_max(0, row) + 1];
+    if (next_start > 0 && text.str[next_start - 1] == '\n') {
+        return next_start - 1;
+    }
+    return next_start;
+}
+
+static b32 text_wrap_is_space(u8 byte)
+{
+    return (byte == ' ' || byte == '\t');
+}
+
+static s64 *text_wrap_line(s64 *out, s64 *out_end, Text_Layout *layout, String text,
+                           s64 line_start, s64 line_end, f32 max_width)
+{
+    // Greedy word wrap of one line - writes its row starts to out.
+    // Rows break after spaces (spaces at the end of a row hang past max_width),
+    //   words that don't fit on their own get broken between codepoints.
+    // Every row takes O(log n) thanks to the layout, lines that fit take a single lookup.
+    Text_Layout_Boundary *boundaries = layout->boundaries;
+    s64 end_index = text_layout_first_after_byte(layout, line_end) - 1;
+    f32 end_x = boundaries[end_index].x;
+    
+    s64 row_start = line_start;
+    s64 row_index = text_layout_first_after_byte(layout, row_start) - 1;
+    
+    for (;;)
+    {
+        assert(out < out_end);
+        *out++ = row_start;
+        
+        f32 limit_x = boundaries[row_index].x + max_width;
+        if (end_x <= limit_x) {
+            break;
+        }
+        
+        s64 fit_index = text_layout_last_at_or_before_x(layout, row_index, end_index + 1, limit_x);
+        s64 pos = boundaries[fit_index].byte_index;
+        
+        if (text_wrap_is_space(text.str[pos]))
+        {
+            while (pos < line_end && text_wrap_is_space(text.str[pos])) {
+                pos += 1;
+            }
+            if (pos == line_end) {
+                break;
+            }
+        }
+        else
+        {
+            s64 word_start = pos;
+            while (word_start > row_start && !text_wrap_is_space(text.str[word_start - 1])) {
+                word_start -= 1;
+            }
+            
+            if (word_start > row_start) {
+                pos = word_start;
+            } else if (fit_index == row_index) {
+                pos = boundaries[row_index + 1].byte_index; // at least one glyph in every row
+            }
+        }
+        
+        row_start = pos;
+        row_index = text_layout_first_after_byte(layout, row_start) - 1;
+    }
+    
+    return out;
+}
+
+static void text_wrap_on_edit(Text_Wrap *wrap, s64 edit_start, s64 edit_old_end, s64 edit_new_end)
+{
+    // Row starts inside of the edited range are removed, the ones after it get shifted.
+    // Lines that were touched get rewrapped by text_wrap_update.
+    s64 delta = edit_new_end - edit_old_end;
+    s64 first_removed = text_wrap_first_row_after(wrap, edit_start);
+    s64 first_kept = text_wrap_first_row_after(wrap, edit_old_end);
+    
+    s64 tail_count = wrap->row_count - first_kept;
+    memmove(wrap->row_starts + first_removed, wrap->row_starts + first_kept, tail_count*sizeof(s64));
+    wrap->row_count -= first_kept - first_removed;
+    
+    for (s64 row = first_removed; row < wrap->row_count; row += 1) {
+        wrap->row_starts[row] += delta;
+    }
+    
+    if (wrap->has_dirty_range)
+    {
+        s64 end = wrap->dirty_end;
+        if (end >= edit_old_end) {
+            end += delta;
+        } else if (end > edit_start) {
+            end = edit_new_end;
+        }
+        wrap->dirty_start = get_min(wrap->dirty_start, edit_start);
+        wrap->dirty_end = get_max(end, edit_new_end);
+    }
+    else
+    {
+        wrap->has_dirty_range = true;
+        wrap->dirty_start = edit_start;
+        wrap->dirty_end = edit_new_end;
+    }
+}
+
+static void text_wrap_update(Text_Input *text_input, f32 max_width)
+{
+    // Rewraps lines that were edited since the last update - everything if max_width changed.
+    // Text input needs a wrap, a line index and an up to date layout.
+    Text_Wrap *wrap = text_input->wrap;
+    Text_Layout *layout = text_input->layout;
+    Text_Line_Index *lines = text_input->line_index;
+    String text = text_input->buffer;
+    
+    assert(max_width > 0.f);
+    if (wrap->version != text_input->version || wrap->max_width != max_width || !wrap->row_count)
+    {
+        wrap->version = text_input->version;
+        wrap->max_width = max_width;
+        wrap->row_count = 0;
+        wrap->has_dirty_range = true;
+        wrap->dirty_start = 0;
+        wrap->dirty_end = text.size;
+    }
+    
+    if (!wrap->has_dirty_range) {
+        return;
+    }
+    wrap->has_dirty_range = false;
+    
+    s64 first_line = line_index_line_from_pos(lines, wrap->dirty_start);
+    s64 last_line = line_index_line_from_pos(lines, wrap->dirty_end);
+    s64 start = line_index_line_start(lines, first_line);
+    s64 end = line_index_line_end(lines, text, last_line);
+    
+    // rows of the dirty lines get replaced - tail waits at the end of the memory in the meantime
+    s64 first_removed = text_wrap_first_row_after(wrap, start - 1);
+    s64 first_kept = text_wrap_first_row_after(wrap, end);
+    s64 tail_count = wrap->row_count - first_kept;
+    s64 *tail = wrap->row_starts + wrap->row_cap - tail_count;
+    memmove(tail, wrap->row_starts + first_kept, tail_count*sizeof(s64));
+    
+    s64 *out = wrap->row_starts + first_removed;
+    for (s64 line = first_line; line <= last_line; line += 1)
+    {
+        out = text_wrap_line(out, tail, layout, text,
+                             line_index_line_start(lines, line),
+                             line_index_line_end(lines, text, line), max_width);
+    }
+    
+    memmove(out, tail, tail_count*sizeof(s64));
+    wrap->row_count = (out - wrap->row_starts) + tail_count;
+}
+
+static s64 text_wrap_pos_in_row(Text_Wrap *wrap, Text_Layout *layout, String text, s64 row, f32 x)
+{
+    // Byte offset closest to x (relative to the start of the row).
+    // End of a soft wrapped row is the start of the next one - so it's never returned.
+    row = get_min(get_max(0, row), wrap->row_count - 1);
+    s64 row_start = wrap->row_starts[row];
+    s64 row_end = text_wrap_row_end(wrap, text, row);
+    b32 is_soft_break = (row + 1 < wrap->row_count && row_end == wrap->row_starts[row + 1]);
+    
+    s64 first = text_layout_first_after_byte(layout, row_start) - 1;
+    s64 one_past_last = text_layout_first_after_byte(layout, row_end - (is_soft_break ? 1 : 0));
+    f32 row_x = layout->boundaries[first].x;
+    
+    s64 index = text_layout_nearest(layout, first, get_max(one_past_last, first + 1), row_x + x);
+    return layout->boundaries[index].byte_index;
+}
+
+static s64 text_wrap_hit_test(Text_Wrap *wrap, Text_Layout *layout, String text,
+                              f32 x, f32 y, f32 row_height)
+{
+    // x is relative to the left edge of the rows, y to the top of the first row
+    if (!wrap->row_count || !layout->count) {
+        return 0;
+    }
+    s64 row = (y > 0.f ? (s64)(y / row_height) : 0);
+    return text_wrap_pos_in_row(wrap, layout, text, row, x);
+}
+
+
+
+static s64 text_bidi_first_run_ending_after(Text_Bidi *bidi, s64 pos)
+{
+    // index of the first run with one_past_end > pos (binary search)
+    s64 low = 0;
+    s64 high = bidi->count;
+    
+    while (low < high)
+    {
+        s64 mid = low + (high - low) / 2;
+        if (bidi->runs[mid].one_past_end <= pos) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    
+    return low;
+}
+
+static void text_bidi_invalidate(Text_Bidi *bidi, String text, s64 edit_start)
+{
+    // Runs of paragraphs that end at or before edit_start stay - everything after them gets resolved again.
+    // text is the buffer after the edit (bytes before edit_start didn't change).
+    s64 index = text_bidi_first_run_ending_after(bidi, edit_start - 1);
+    if (index < bidi->count)
+    {
+        if (edit_start > 0 && text.str[edit_start - 1] == '\n')
+        {
+            index += 1; // edit starts right after the end of the paragraph
+        }
+        else
+        {
+            while (index > 0 && text.str[bidi->runs[index].start - 1] != '\n') {
+                index -= 1;
+            }
+        }
+        
+        bidi->count = index;
+        bidi->resolved_end = (index ? bidi->runs[index - 1].one_past_end : 0);
+    }
+    bidi->has_slot_x = false;
+    bidi->has_rtl = false;
+}
+
+static void text_bidi_update(Text_Input *text_input)
+{
+    // Resolves paragraphs that were edited since the last update.
+    // Slot positions come from the layout - it has to be up to date.
+    Text_Bidi *bidi = text_input->bidi;
+    Text_Layout *layout = text_input->layout;
+    String text = text_input->buffer;
+    
+    if (bidi->version != text_input->version)
+    {
+        bidi->version = text_input->version;
+        bidi->count = 0;
+        bidi->resolved_end = 0;
+        bidi->has_slot_x = false;
+    }
+    
+    while (bidi->resolved_end < (s64)text.size)
+    {
+        s64 start = bidi->resolved_end;
+        s64 end = start;
+        while (end < (s64)text.size && text.str[end++] != '\n') {}
+        String paragraph = {text.str + start, (u64)(end - start)};
+        
+        s64 first = bidi->count;
+        if (str_has_rtl(paragraph))
+        {
+            bidi->count += bidi_resolve_runs(paragraph, start, bidi->scratch, bidi->runs + first, bidi->cap - first);
+            bidi_reorder_runs(bidi->runs + first, bidi->count - first, bidi->visual + first);
+        }
+        else
+        {
+            assert(first < bidi->cap);
+            bidi->runs[bidi->count++] = {start, end, 0};
+            bidi->visual[first] = 0;
+        }
+        
+        for (s64 slot = first; slot < bidi->count; slot += 1)
+        {
+            bidi->visual[slot] += first;
+            bidi->slot_of_run[bidi->visual[slot]] = slot;
+        }
+        bidi->resolved_end = end;
+        bidi->has_slot_x = false;
+    }
+    
+    if (!bidi->has_slot_x || bidi->font != layout->font)
+    {
+        bidi->has_slot_x = true;
+        bidi->font = layout->font;
+        bidi->has_rtl = false;
+        
+        f32 x = 0.f;
+        for (s64 slot = 0; slot < bidi->count; slot += 1)
+        {
+            Bidi_Run run = bidi->runs[bidi->visual[slot]];
+            bidi->slot_x[slot] = x;
+            x += text_layout_x_of(layout, run.one_past_end) - text_layout_x_of(layout, run.start);
+            bidi->has_rtl |= (run.level & 1);
+        }
+    }
+}
+
+static s64 text_bidi_run_at(Text_Bidi *bidi, s64 pos)
+{
+    // run that contains the codepoint at pos - end of the text belongs to the last run
+    return get_min(text_bidi_first_run_ending_after(bidi, pos), bidi->count - 1);
+}
+
+static f32 text_bidi_x_in_run(Text_Bidi *bidi, Text_Layout *layout, s64 run_index, s64 pos)
+{
+    // Visual x of a byte offset from [start, one_past_end] of the run.
+    // Right to left runs start at their right edge.
+    Bidi_Run run = bidi->runs[run_index];
+    f32 slot_x = bidi->slot_x[bidi->slot_of_run[run_index]];
+    if (run.level & 1) {
+        return slot_x + text_layout_x_of(layout, run.one_past_end) - text_layout_x_of(layout, pos);
+    }
+    return slot_x + text_layout_x_of(layout, pos) - text_layout_x_of(layout, run.start);
+}
+
+static f32 text_bidi_x_of(Text_Bidi *bidi, Text_Layout *layout, s64 pos)
+{
+    // Caret position - text_layout_x_of in visual order.
+    if (!bidi->has_rtl) {
+        return text_layout_x_of(layout, pos);
+    }
+    return text_bidi_x_in_run(bidi, layout, text_bidi_run_at(bidi, pos), pos);
+}
+
+static s64 text_bidi_slot_at_x(Text_Bidi *bidi, f32 x)
+{
+    // last slot with slot_x <= x (the first one if there is none)
+    s64 low = 0;
+    s64 high = bidi->count;
+    
+    while (low < high)
+    {
+        s64 mid = low + (high - low) / 2;
+        if (bidi->slot_x[mid] <= x) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    
+    return get_max(low - 1, 0);
+}
+
+static s64 text_bidi_nearest_in_slot(Text_Bidi *bidi, Text_Layout *layout, s64 slot, f32 x)
+{
+    // Byte offset of the run closest to x. End of a run is a caret position of the next run
+    //   so it's used only at the end of the text.
+    s64 run_index = bidi->visual[slot];
+    Bidi_Run run = bidi->runs[run_index];
+    f32 local_x = x - bidi->slot_x[slot];
+    
+    s64 first = text_layout_first_after_byte(layout, run.start) - 1;
+    s64 one_past_last = text_layout_first_after_byte(layout, run.one_past_end - (run_index == bidi->count - 1 ? 0 : 1));
+    
+    f32 logical_x = ((run.level & 1) ?
+                     text_layout_x_of(layout, run.one_past_end) - local_x :
+                     text_layout_x_of(layout, run.start) + local_x);
+    s64 index = text_layout_nearest(layout, first, one_past_last, logical_x);
+    return layout->boundaries[index].byte_index;
+}
+
+static s64 text_bidi_hit_test(Text_Bidi *bidi, Text_Layout *layout, String text, f32 x)
+{
+    // Mouse placement - text_layout_hit_test in visual order.
+    // Slot under x is checked together with its neighbours - they can have a closer caret position at the shared edge.
+    // Combining marks of right to left runs come before their zero width boundary - so the result gets
+    //   moved to the start of its grapheme.
+    if (!bidi->has_rtl) {
+        return text_layout_hit_test(layout, x);
+    }
+    
+    s64 slot = text_bidi_slot_at_x(bidi, x);
+    s64 result = 0;
+    f32 best_distance = -1.f;
+    for (s64 near_slot = get_max(slot - 1, 0); near_slot <= get_min(slot + 1, bidi->count - 1); near_slot += 1)
+    {
+        s64 pos = text_bidi_nearest_in_slot(bidi, layout, near_slot, x);
+        if (!str_is_grapheme_boundary(text, pos)) {
+            pos = str_prev_grapheme_boundary(text, pos);
+        }
+        f32 distance = text_bidi_x_of(bidi, layout, pos) - x;
+        distance = (distance < 0.f ? -distance : distance);
+        if (best_distance < 0.f || distance < best_distance)
+        {
+            best_distance = distance;
+            result = pos;
+        }
+    }
+    return result;
+}
+
+static s64 text_bidi_move_visually(Text_Bidi *bidi, Text_Layout *layout, String text, s64 pos, s64 dir)
 {
-    // This function assumes that our input was a valid utf8 string at some point
-    //   but it got truncated without much care - possibly in the middle of a codepoint.
-    // It removes up to 3 bytes if string's ending is an incorrect utf8 sequence.
-    
-    String result = input;
-    
-    s32 follower_byte_count = 0; // counter for bytes with 10xxxxxx bits
-    s64 end_at = get_max(0, input.size - 4);
+    // Left/right arrow - closest grapheme boundary on the left (dir < 0) or right (dir > 0) of the caret.
+    // Every run gets a binary search in its own direction. Returns pos if there is nothing on that side.
+    f32 epsilon = 0.01f; // carets at the shared edge of two runs are at the same place
+    f32 target_x = text_bidi_x_of(bidi, layout, pos) + (dir > 0 ? epsilon : -epsilon);
+    s64 result = pos;
+    f32 result_x = 0.f;
+    b32 found = false;
     
-    for (s64 index = input.size-1; index >= end_at; index -= 1)
+    for (s64 slot = 0; slot < bidi->count; slot += 1)
     {
-        u8 byte = input.str[index];
-        u8 byte_class = utf8_top5b_class[byte >> 3];
+        s64 run_index = bidi->visual[slot];
+        Bidi_Run run = bidi->runs[run_index];
+        b32 is_rtl = (run.level & 1);
+        b32 is_last = (run_index == bidi->count - 1);
         
-        if (byte_class == 0)
+        // end of a run is a caret position of the next run - except at the end of the text
+        s64 first = text_layout_first_after_byte(layout, run.start) - 1;
+        s64 one_past_last = text_layout_first_after_byte(layout, run.one_past_end - (is_last ? 0 : 1));
+        f32 local_x = target_x - bidi->slot_x[slot];
+        f32 logical_x = (is_rtl ?
+                         text_layout_x_of(layout, run.one_past_end) - local_x :
+                         text_layout_x_of(layout, run.start) + local_x);
+        
+        s64 candidate = -1;
+        if ((dir > 0) != is_rtl)
         {
-            follower_byte_count += 1;
+            // first boundary after logical_x, rounded up to a grapheme boundary
+            s64 index = text_layout_last_at_or_before_x(layout, first, one_past_last, logical_x);
+            index += (layout->boundaries[index].x <= logical_x ? 1 : 0);
+            if (index < one_past_last)
+            {
+                candidate = layout->boundaries[index].byte_index;
+                if (!str_is_grapheme_boundary(text, candidate)) {
+                    candidate = str_next_grapheme_boundary(text, candidate);
+                }
+                if (candidate > run.one_past_end || (candidate == run.one_past_end && !is_last)) {
+                    candidate = -1;
+                }
+            }
         }
         else
         {
-            if (byte_class != follower_byte_count + 1)
+            // last boundary before logical_x, rounded down to a grapheme boundary
+            s64 index = text_layout_last_at_or_before_x(layout, first, one_past_last, logical_x);
+            while (index >= first && layout->boundaries[index].x >= logical_x) {
+                index -= 1;
+            }
+            if (index >= first)
             {
-                result.size = index;
+                candidate = layout->boundaries[index].byte_index;
+                if (!str_is_grapheme_boundary(text, candidate)) {
+                    candidate = str_prev_grapheme_boundary(text, candidate);
+                }
+                if (candidate < run.start) {
+                    candidate = -1;
+                }
+            }
+        }
+        
+        if (candidate >= 0)
+        {
+            f32 x = text_bidi_x_in_run(bidi, layout, run_index, candidate);
+            if (!found || (dir > 0 ? x < result_x : x > result_x))
+            {
+                found = true;
+                result = candidate;
+                result_x = x;
             }
-            
-            break;
         }
     }
     
@@ -67,100 +2341,181 @@ static String truncate_invalid_utf8_ending(String input)
 }
 
 
-
-
-
-
-struct Text_Replace_Range_Result
-{
-    b32 did_anything;
-    s64 cursor_pos;
-};
-
-static Text_Replace_Range_Result text_replace_range(Mutable_String *buffer,
-                                                    s64 selection_start, s64 one_past_selection_end,
-                                                    String insert_text)
+static void text_input_on_edit(Text_Input *text_input, s64 edit_start, s64 edit_old_end, s64 edit_new_end)
 {
-    selection_start = get_min(get_max(0, selection_start), (s64)buffer->size);
-    one_past_selection_end = get_min(get_max(0, one_past_selection_end), (s64)buffer->size);
+    // Every change to the buffer goes through here.
+    // Range [edit_start, edit_old_end) of the old buffer was replaced with [edit_start, edit_new_end).
+    // Batched edits report one range that covers all of them.
+    text_input->is_dirty = true;
+    text_input->version += 1;
     
-    if (selection_start > one_past_selection_end)
+    Text_Layout *layout = text_input->layout;
+    if (layout)
     {
-        s64 temp = selection_start;
-        selection_start = one_past_selection_end;
-        one_past_selection_end = temp;
-    }
-    
-    Text_Replace_Range_Result result = {};
-    
-    s64 to_delete = one_past_selection_end - selection_start;
-    s64 initial_buffer_size_delta = insert_text.size - to_delete;
-    
-    { // truncate insert_text to fit in the buffer;
-        s64 max_positive_buffer_delta = buffer->cap - buffer->size;
-        
-        if (max_positive_buffer_delta < initial_buffer_size_delta)
-        {
-            s64 reduce_size = initial_buffer_size_delta - max_positive_buffer_delta;
-            assert((s64)insert_text.size >= reduce_size);
-            
-            insert_text.size -= reduce_size;
-            insert_text = truncate_invalid_utf8_ending(insert_text);
+        if (layout->version + 1 == text_input->version) {
+            text_layout_invalidate(layout, edit_start);
+        } else {
+            layout->count = 0; // it missed some edits
         }
+        layout->version = text_input->version;
     }
-    
-    s64 buffer_size_delta = insert_text.size - to_delete;
-    
-    if ((!buffer_size_delta && !to_delete) ||
-        (initial_buffer_size_delta > 0 && buffer_size_delta < 0))
-    {
-        return result;
+    if (text_input->line_index) {
+        line_index_update(text_input->line_index, text_input->buffer, edit_start, edit_old_end, edit_new_end);
     }
-    
-    
-    if (buffer_size_delta > 0)
+    Text_Bidi *bidi = text_input->bidi;
+    if (bidi)
     {
-        for (s64 index = buffer->size - 1;
-             index >= one_past_selection_end;
-             index -= 1)
-        {
-            buffer->str[index + buffer_size_delta] = buffer->str[index];
+        if (bidi->version + 1 == text_input->version) {
+            text_bidi_invalidate(bidi, text_input->buffer, edit_start);
+        } else {
+            bidi->count = 0; // it missed some edits
+            bidi->resolved_end = 0;
+            bidi->has_slot_x = false;
+            bidi->has_rtl = false;
         }
+        bidi->version = text_input->version;
     }
-    else if (buffer_size_delta < 0)
+    Text_Wrap *wrap = text_input->wrap;
+    if (wrap)
     {
-        for (s64 index = one_past_selection_end;
-             index < (s64)buffer->size;
-             index += 1)
-        {
-            buffer->str[index + buffer_size_delta] = buffer->str[index];
+        if (wrap->version + 1 == text_input->version) {
+            text_wrap_on_edit(wrap, edit_start, edit_old_end, edit_new_end);
+        } else {
+            wrap->row_count = 0; // it missed some edits
         }
+        wrap->version = text_input->version;
     }
-    
-    
-    for (u64 index = 0; index < insert_text.size; index += 1)
+    if (text_input->word_cache) {
+        word_cache_update(text_input->word_cache, text_input->buffer, edit_start, edit_old_end, edit_new_end);
+    }
+    if (text_input->search) {
+        text_search_update(text_input->search, text_input->buffer, edit_start, edit_old_end, edit_new_end);
+    }
+    if (text_input->autocomplete) {
+        text_fuzzy_set_query(text_input->autocomplete, text_input->buffer);
+    }
+    if (text_input->selections)
     {
-        buffer->str[selection_start + index] = insert_text.str[index];
+        Text_Edit edit = {edit_start, edit_old_end, {nullptr, (u64)(edit_new_end - edit_start)}};
+        selection_set_remap(text_input->selections, &edit, 1);
+    }
+}
+
+
+static void text_input_attach_line_index(Text_Input *text_input, Text_Line_Index *line_index)
+{
+    text_input->line_index = line_index;
+    if (line_index) {
+        line_index_rebuild(line_index, text_input->buffer);
+    }
+}
+
+
+static void text_input_attach_word_cache(Text_Input *text_input, Text_Word_Cache *word_cache)
+{
+    text_input->word_cache = word_cache;
+    if (word_cache) {
+        assert(word_cache->word_count*64 > (s64)text_input->buffer.cap);
+        word_cache_clear(word_cache);
+    }
+}
+
+
+static void text_input_attach_search(Text_Input *text_input, Text_Search *search)
+{
+    text_input->search = search;
+    if (search) {
+        text_search_run(search, text_input->buffer);
     }
-    
-    buffer->size += buffer_size_delta;
-    
-    result.did_anything = true;
-    result.cursor_pos = selection_start + insert_text.size;
-    return result;
 }
 
 
+static void text_input_attach_autocomplete(Text_Input *text_input, Text_Fuzzy_Matcher *autocomplete)
+{
+    text_input->autocomplete = autocomplete;
+    if (autocomplete) {
+        text_fuzzy_set_query(autocomplete, text_input->buffer);
+    }
+}
+
 
 static void text_input_write(Text_Input *text_input, String new_text)
 {
+    if (text_input->cursor_count > 1)
+    {
+        text_input_load_main_cursor(text_input);
+        
+        s64 edit_start = text_cursor_min(text_input->cursors[0]);
+        s64 edit_old_end = text_cursor_max(text_input->cursors[text_input->cursor_count - 1]);
+        s64 old_size = text_input->buffer.size;
+        
+        if (text_replace_ranges(&text_input->buffer, text_input->cursors, text_input->cursor_count, new_text))
+        {
+            s64 edit_new_end = edit_old_end + ((s64)text_input->buffer.size - old_size);
+            text_input_normalize_cursors(text_input);
+            text_input_on_edit(text_input, edit_start, edit_old_end, edit_new_end);
+        }
+        return;
+    }
+    
+    s64 edit_start = get_min(get_max(0, get_min(text_input->cursor_pos, text_input->mark_pos)),
+                             (s64)text_input->buffer.size);
+    s64 edit_old_end = get_min(get_max(0, get_max(text_input->cursor_pos, text_input->mark_pos)),
+                               (s64)text_input->buffer.size);
+    
     Text_Replace_Range_Result res = text_replace_range(&text_input->buffer, text_input->cursor_pos,
                                                        text_input->mark_pos, new_text);
     
     if (res.did_anything)
     {
         text_input->cursor_pos = text_input->mark_pos = res.cursor_pos;
-        text_input->is_dirty = true;
+        text_input_on_edit(text_input, edit_start, edit_old_end, res.cursor_pos);
+    }
+}
+
+static void text_input_paste(Text_Input *text_input, String text, b32 allow_new_lines)
+{
+    // Like text_input_write but text goes through text_ingest first.
+    // With a single cursor the tail of the buffer is moved to make room for the whole text
+    //   (text_ingest never writes more than its input) and the text gets cleaned up straight into the gap.
+    // The tail is moved a second time only when cleanup made the text shorter.
+    Mutable_String *buffer = &text_input->buffer;
+    
+    if (text_input->cursor_count > 1)
+    {
+        // Cleaned text is kept at the end of the free space while text_replace_ranges runs.
+        // Scratch size is limited so all copies fit in the buffer without reaching the scratch.
+        u64 scratch_cap = (buffer->cap - buffer->size) / (text_input->cursor_count + 1);
+        u8 *scratch = buffer->str + buffer->cap - scratch_cap;
+        Text_Ingest_Result ingest = text_ingest(scratch, scratch_cap, text, allow_new_lines);
+        text_input_write(text_input, {scratch, ingest.written});
+        return;
+    }
+    
+    s64 edit_start = get_min(get_max(0, get_min(text_input->cursor_pos, text_input->mark_pos)),
+                             (s64)buffer->size);
+    s64 edit_old_end = get_min(get_max(0, get_max(text_input->cursor_pos, text_input->mark_pos)),
+                               (s64)buffer->size);
+    
+    u64 tail_size = buffer->size - edit_old_end;
+    u64 gap = buffer->cap - tail_size - edit_start;
+    u64 gap_end = edit_start + get_min(text.size, gap);
+    if (gap_end != (u64)edit_old_end) {
+        memmove(buffer->str + gap_end, buffer->str + edit_old_end, tail_size);
+    }
+    
+    Text_Ingest_Result ingest = text_ingest(buffer->str + edit_start, gap_end - edit_start, text, allow_new_lines);
+    s64 edit_new_end = edit_start + ingest.written;
+    
+    if ((u64)edit_new_end != gap_end) {
+        memmove(buffer->str + edit_new_end, buffer->str + gap_end, tail_size);
+    }
+    buffer->size = edit_new_end + tail_size;
+    
+    if (edit_new_end != edit_old_end || edit_start != edit_old_end)
+    {
+        text_input->cursor_pos = text_input->mark_pos = edit_new_end;
+        text_input_on_edit(text_input, edit_start, edit_old_end, edit_new_end);
     }
 }
 
@@ -169,6 +2524,53 @@ static b32 text_input_has_selection(Text_Input *text_input)
     return (text_input->cursor_pos != text_input->mark_pos);
 }
 
+static b32 text_input_apply_edits(Text_Input *text_input, Text_Edit *sorted_edits, u64 edit_count)
+{
+    // Bulk rewrite (replace all etc.) - see text_apply_edits.
+    // Cursors get moved together with the text they were pointing at.
+    text_input_load_main_cursor(text_input);
+    s64 old_size = text_input->buffer.size;
+    
+    if (!text_apply_edits(&text_input->buffer, sorted_edits, edit_count)) {
+        return false;
+    }
+    
+    if (edit_count)
+    {
+        s64 edit_start = sorted_edits[0].start;
+        s64 edit_old_end = sorted_edits[edit_count - 1].one_past_end;
+        s64 edit_new_end = edit_old_end + ((s64)text_input->buffer.size - old_size);
+        text_input_on_edit(text_input, edit_start, edit_old_end, edit_new_end);
+    }
+    
+    if (text_input->cursor_count)
+    {
+        // cursors are sorted and don't overlap - so both their min & max positions are ascending
+        Text_Edit_Remap remap_min = {sorted_edits, edit_count};
+        Text_Edit_Remap remap_max = {sorted_edits, edit_count};
+        
+        for (u32 cursor_index = 0; cursor_index < text_input->cursor_count; cursor_index += 1)
+        {
+            Text_Cursor *cursor = text_input->cursors + cursor_index;
+            s64 *min_pos = (cursor->cursor_pos < cursor->mark_pos ? &cursor->cursor_pos : &cursor->mark_pos);
+            s64 *max_pos = (min_pos == &cursor->cursor_pos ? &cursor->mark_pos : &cursor->cursor_pos);
+            *min_pos = text_remap_pos(&remap_min, *min_pos);
+            *max_pos = text_remap_pos(&remap_max, *max_pos);
+        }
+        
+        text_input_normalize_cursors(text_input);
+    }
+    else
+    {
+        Text_Edit_Remap remap_cursor = {sorted_edits, edit_count};
+        Text_Edit_Remap remap_mark = {sorted_edits, edit_count};
+        text_input->cursor_pos = text_remap_pos(&remap_cursor, text_input->cursor_pos);
+        text_input->mark_pos = text_remap_pos(&remap_mark, text_input->mark_pos);
+    }
+    
+    return true;
+}
+
 
 
 
@@ -220,90 +2622,108 @@ static s64 str_move_pos_by_codepoints(String text, s64 pos, s64 move_by_codepoin
 
 
 
-static b32 is_word_separator(u32 c)
+static s64 str_move_pos_by_graphemes(String text, s64 pos, s64 move_by_grapheme_count)
 {
-    return (is_whitespace(c) ||
-            (c >= '!' && c <= '/') ||
-            (c >= ':' && c <= '@') ||
-            (c >= '[' && c <= '^') ||
-            (c >= '{' && c <= '~'));
+    // Moves by user perceived characters (emoji sequences, letters with combining marks etc.)
+    if (pos > (s64)text.size) {
+        pos = text.size;
+    } else if (pos < 0) {
+        pos = 0;
+    }
+    else
+    {
+        while (move_by_grapheme_count > 0 && pos < (s64)text.size)
+        {
+            pos = str_next_grapheme_boundary(text, pos);
+            move_by_grapheme_count -= 1;
+        }
+        
+        while (move_by_grapheme_count < 0 && pos > 0)
+        {
+            pos = str_prev_grapheme_boundary(text, pos);
+            move_by_grapheme_count += 1;
+        }
+    }
+    
+    return pos;
+}
+
+
+
+static s64 word_segment_next(String text, Text_Word_Cache *cache, s64 pos) {
+    return (cache ? word_cache_next_boundary(cache, text, pos) : str_next_word_boundary(text, pos));
+}
+static s64 word_segment_start_at_or_before(String text, Text_Word_Cache *cache, s64 pos) {
+    return (cache ? word_cache_boundary_at_or_before(cache, text, pos) : str_word_boundary_at_or_before(text, pos));
+}
+static b32 word_segment_is_word(String text, Text_Word_Cache *cache, s64 pos) {
+    return (cache ? word_cache_is_word_start(cache, text, pos) : str_is_word_segment(text, pos));
 }
 
 
-static s64 str_move_pos_by_words(String text, s64 pos, s64 move_by_word_count)
+static s64 text_move_pos_by_words(String text, Text_Word_Cache *cache, s64 pos, s64 move_by_word_count)
 {
+    // Word segments come from UAX #29 word boundaries - cache is optional.
+    // Moving right stops at the start of the next word after passing move_by_word_count word ends.
+    // Moving left stops at the start of the word.
     if (pos > (s64)text.size) {
         pos = text.size;
     } else if (pos < 0) {
         pos = 0;
     }
-    else
+    else if (move_by_word_count > 0)
     {
-        s64 change = 0;
-        b32 skipping_over_separators = true;
+        s64 segment_start = word_segment_start_at_or_before(text, cache, pos);
+        b32 inside_word = false;
+        if (segment_start < pos) // started in the middle of a segment
+        {
+            inside_word = word_segment_is_word(text, cache, segment_start);
+            pos = word_segment_next(text, cache, segment_start);
+        }
         
-        if (move_by_word_count > 0)
+        while (pos < (s64)text.size)
         {
-            text = str_skip(text, pos);
-            while (text.size)
+            if (word_segment_is_word(text, cache, pos))
             {
-                Unicode_Consume consume = utf8_consume(text);
-                text = str_skip(text, consume.inc);
-                
-                if (is_word_separator(consume.codepoint))
-                {
-                    if (!skipping_over_separators)
-                    {
-                        move_by_word_count -= 1;
-                        skipping_over_separators = true;
-                    }
+                if (inside_word) { // two words next to each other (ideographs for example)
+                    move_by_word_count -= 1;
                 }
-                else
-                {
-                    if (!move_by_word_count) { 
-                        break;
-                    }
-                    skipping_over_separators = false;
+                if (!move_by_word_count) {
+                    break;
                 }
-                
-                
-                change += consume.inc;
+                inside_word = true;
+            }
+            else if (inside_word)
+            {
+                move_by_word_count -= 1;
+                inside_word = false;
             }
+            
+            pos = word_segment_next(text, cache, pos);
         }
-        else if (move_by_word_count < 0)
+    }
+    else if (move_by_word_count < 0)
+    {
+        while (pos > 0)
         {
-            text = str_prefix(text, pos);
-            while (text.size)
+            pos = word_segment_start_at_or_before(text, cache, pos - 1);
+            if (word_segment_is_word(text, cache, pos))
             {
-                Unicode_Consume_Reverse consume = utf8_consume_reverse(text);
-                text = str_chop(text, consume.dec);
-                
-                if (is_word_separator(consume.codepoint))
-                {
-                    if (!skipping_over_separators)
-                    {
-                        move_by_word_count += 1;
-                        if (!move_by_word_count) { 
-                            break;
-                        }
-                        skipping_over_separators = true;
-                    }
-                }
-                else
-                {
-                    skipping_over_separators = false;
+                move_by_word_count += 1;
+                if (!move_by_word_count) {
+                    break;
                 }
-                
-                change -= consume.dec;
             }
         }
-        
-        pos += change;
     }
     
     return pos;
 }
 
+static s64 str_move_pos_by_words(String text, s64 pos, s64 move_by_word_count) {
+    return text_move_pos_by_words(text, nullptr, pos, move_by_word_count);
+}
+
 
 
 
@@ -315,18 +2735,15 @@ enum Text_Input_Move_Flags
     TextInputMove_ByMax = (1 << 2),
 };
 
-static void text_input_move_cursor(Text_Input *text_input, s64 move_by, u32 flags)
+static void text_cursor_move(String text, Text_Word_Cache *word_cache,
+                             Text_Cursor *cursor, s64 move_by, u32 flags)
 {
-    text_input->is_dirty = true;
-    
-    if (!flags && text_input_has_selection(text_input))
+    if (!flags && cursor->cursor_pos != cursor->mark_pos)
     {
         if (move_by > 0) {
-            s64 max_pos = get_max(text_input->cursor_pos, text_input->mark_pos);
-            text_input->cursor_pos = text_input->mark_pos = max_pos;
+            cursor->cursor_pos = cursor->mark_pos = text_cursor_max(*cursor);
         } else {
-            s64 min_pos = get_min(text_input->cursor_pos, text_input->mark_pos);
-            text_input->cursor_pos = text_input->mark_pos = min_pos;
+            cursor->cursor_pos = cursor->mark_pos = text_cursor_min(*cursor);
         }
         
         return;
@@ -334,18 +2751,104 @@ static void text_input_move_cursor(Text_Input *text_input, s64 move_by, u32 flag
     
     
     if (flags & TextInputMove_ByMax) {
-        text_input->cursor_pos = (move_by >= 0 ? text_input->buffer.size : 0);
+        cursor->cursor_pos = (move_by >= 0 ? text.size : 0);
     } else if (flags & TextInputMove_ByWords) {
-        text_input->cursor_pos = str_move_pos_by_words(text_input->buffer, text_input->cursor_pos, move_by);
+        cursor->cursor_pos = text_move_pos_by_words(text, word_cache, cursor->cursor_pos, move_by);
     } else {
-        text_input->cursor_pos = str_move_pos_by_codepoints(text_input->buffer, text_input->cursor_pos, move_by);
+        cursor->cursor_pos = str_move_pos_by_graphemes(text, cursor->cursor_pos, move_by);
     }
     
     
     if (!(flags & TextInputMove_Select))
     {
-        text_input->mark_pos = text_input->cursor_pos;
+        cursor->mark_pos = cursor->cursor_pos;
+    }
+}
+
+static void text_input_move_cursor(Text_Input *text_input, s64 move_by, u32 flags)
+{
+    text_input->is_dirty = true;
+    
+    if (text_input->cursor_count > 1)
+    {
+        text_input_load_main_cursor(text_input);
+        
+        for (u32 cursor_index = 0; cursor_index < text_input->cursor_count; cursor_index += 1)
+        {
+            text_cursor_move(text_input->buffer, text_input->word_cache,
+                             text_input->cursors + cursor_index, move_by, flags);
+        }
+        
+        text_input_normalize_cursors(text_input);
+        return;
+    }
+    
+    Text_Cursor cursor = {text_input->cursor_pos, text_input->mark_pos};
+    text_cursor_move(text_input->buffer, text_input->word_cache, &cursor, move_by, flags);
+    text_input->cursor_pos = cursor.cursor_pos;
+    text_input->mark_pos = cursor.mark_pos;
+}
+
+static void text_input_delete(Text_Input *text_input, s64 move_by, u32 flags)
+{
+    // Backspace & Delete - cursors without a selection select text in a given direction first.
+    flags |= TextInputMove_Select;
+    
+    if (text_input->cursor_count > 1)
+    {
+        text_input_load_main_cursor(text_input);
+        
+        for (u32 cursor_index = 0; cursor_index < text_input->cursor_count; cursor_index += 1)
+        {
+            Text_Cursor *cursor = text_input->cursors + cursor_index;
+            if (cursor->cursor_pos == cursor->mark_pos) {
+                text_cursor_move(text_input->buffer, text_input->word_cache, cursor, move_by, flags);
+            }
+        }
+        
+        text_input_normalize_cursors(text_input);
+    }
+    else if (!text_input_has_selection(text_input))
+    {
+        text_input_move_cursor(text_input, move_by, flags);
     }
+    
+    text_input_write(text_input, ""_f0);
 }
 
 
+static void text_input_select_word(Text_Input *text_input, s64 pos)
+{
+    // double click - selects the word segment (or a run of spaces/punctuation) at pos
+    String text = text_input->buffer;
+    pos = get_min(get_max(0, pos), (s64)text.size);
+    
+    s64 start = word_segment_start_at_or_before(text, text_input->word_cache, pos);
+    s64 end = word_segment_next(text, text_input->word_cache, start);
+    
+    text_input->mark_pos = start;
+    text_input->cursor_pos = end;
+    text_input->is_dirty = true;
+}
+
+static b32 text_input_toggle_word_selection(Text_Input *text_input, s64 pos)
+{
+    // ctrl + double click - adds the word at pos to the selection set (or removes it if it's already there)
+    // Returns false if the selection set is missing or full.
+    Text_Selection_Set *set = text_input->selections;
+    if (!set) {
+        return false;
+    }
+    
+    String text = text_input->buffer;
+    pos = get_min(get_max(0, pos), (s64)text.size);
+    
+    s64 start = word_segment_start_at_or_before(text, text_input->word_cache, pos);
+    s64 end = word_segment_next(text, text_input->word_cache, start);
+    
+    text_input->is_dirty = true;
+    if (selection_set_find(set, start) >= 0) {
+        return selection_set_remove(set, {start, end});
+    }
+    return selection_set_insert(set, {start, end});
+}
@@ -0,0 +1,620 @@
+// Generated by generate_unicode_tables.py - do not edit by hand.
+// Unicode version: 14.0.0
+// Entries: (first_codepoint << 5) | property - every run lasts until the next entry.
+
+
+enum Grapheme_Break : u8
+{
+    GraphemeBreak_Other,
+    GraphemeBreak_CR,
+    GraphemeBreak_LF,
+    GraphemeBreak_Control,
+    GraphemeBreak_Extend,
+    GraphemeBreak_ZWJ,
+    GraphemeBreak_RegionalIndicator,
+    GraphemeBreak_Prepend,
+    GraphemeBreak_SpacingMark,
+    GraphemeBreak_L,
+    GraphemeBreak_V,
+    GraphemeBreak_T,
+    GraphemeBreak_LV_LVT,
+    GraphemeBreak_ExtendedPictographic,
+    GraphemeBreak_LV,
+    GraphemeBreak_LVT,
+};
+
+static u32 unicode_grapheme_break_table[1033] =
+{
+    0x00000003, 0x00000142, 0x00000163, 0x000001A1, 0x000001C3, 0x00000400, 0x00000FE3, 0x00001400,
+    0x0000152D, 0x00001540, 0x000015A3, 0x000015CD, 0x000015E0, 0x00006004, 0x00006E00, 0x00009064,
+    0x00009140, 0x0000B224, 0x0000B7C0, 0x0000B7E4, 0x0000B800, 0x0000B824, 0x0000B860, 0x0000B884,
+    0x0000B8C0, 0x0000B8E4, 0x0000B900, 0x0000C007, 0x0000C0C0, 0x0000C204, 0x0000C360, 0x0000C383,
+    0x0000C3A0, 0x0000C964, 0x0000CC00, 0x0000CE04, 0x0000CE20, 0x0000DAC4, 0x0000DBA7, 0x0000DBC0,
+    0x0000DBE4, 0x0000DCA0, 0x0000DCE4, 0x0000DD20, 0x0000DD44, 0x0000DDC0, 0x0000E1E7, 0x0000E200,
+    0x0000E224, 0x0000E240, 0x0000E604, 0x0000E960, 0x0000F4C4, 0x0000F620, 0x0000FD64, 0x0000FE80,
+    0x0000FFA4, 0x0000FFC0, 0x000102C4, 0x00010340, 0x00010364, 0x00010480, 0x000104A4, 0x00010500,
+    0x00010524, 0x000105C0, 0x00010B24, 0x00010B80, 0x00011207, 0x00011240, 0x00011304, 0x00011400,
+    0x00011944, 0x00011C47, 0x00011C64, 0x00012068, 0x00012080, 0x00012744, 0x00012768, 0x00012784,
+    0x000127A0, 0x000127C8, 0x00012824, 0x00012928, 0x000129A4, 0x000129C8, 0x00012A00, 0x00012A24,
+    0x00012B00, 0x00012C44, 0x00012C80, 0x00013024, 0x00013048, 0x00013080, 0x00013784, 0x000137A0,
+    0x000137C4, 0x000137E8, 0x00013824, 0x000138A0, 0x000138E8, 0x00013920, 0x00013968, 0x000139A4,
+    0x000139C0, 0x00013AE4, 0x00013B00, 0x00013C44, 0x00013C80, 0x00013FC4, 0x00013FE0, 0x00014024,
+    0x00014068, 0x00014080, 0x00014784, 0x000147A0, 0x000147C8, 0x00014824, 0x00014860, 0x000148E4,
+    0x00014920, 0x00014964, 0x000149C0, 0x00014A24, 0x00014A40, 0x00014E04, 0x00014E40, 0x00014EA4,
+    0x00014EC0, 0x00015024, 0x00015068, 0x00015080, 0x00015784, 0x000157A0, 0x000157C8, 0x00015824,
+    0x000158C0, 0x000158E4, 0x00015928, 0x00015940, 0x00015968, 0x000159A4, 0x000159C0, 0x00015C44,
+    0x00015C80, 0x00015F44, 0x00016000, 0x00016024, 0x00016048, 0x00016080, 0x00016784, 0x000167A0,
+    0x000167C4, 0x00016808, 0x00016824, 0x000168A0, 0x000168E8, 0x00016920, 0x00016968, 0x000169A4,
+    0x000169C0, 0x00016AA4, 0x00016B00, 0x00016C44, 0x00016C80, 0x00017044, 0x00017060, 0x000177C4,
+    0x000177E8, 0x00017804, 0x00017828, 0x00017860, 0x000178C8, 0x00017920, 0x00017948, 0x000179A4,
+    0x000179C0, 0x00017AE4, 0x00017B00, 0x00018004, 0x00018028, 0x00018084, 0x000180A0, 0x00018784,
+    0x000187A0, 0x000187C4, 0x00018828, 0x000188A0, 0x000188C4, 0x00018920, 0x00018944, 0x000189C0,
+    0x00018AA4, 0x00018AE0, 0x00018C44, 0x00018C80, 0x00019024, 0x00019048, 0x00019080, 0x00019784,
+    0x000197A0, 0x000197C8, 0x000197E4, 0x00019808, 0x00019844, 0x00019868, 0x000198A0, 0x000198C4,
+    0x000198E8, 0x00019920, 0x00019948, 0x00019984, 0x000199C0, 0x00019AA4, 0x00019AE0, 0x00019C44,
+    0x00019C80, 0x0001A004, 0x0001A048, 0x0001A080, 0x0001A764, 0x0001A7A0, 0x0001A7C4, 0x0001A7E8,
+    0x0001A824, 0x0001A8A0, 0x0001A8C8, 0x0001A920, 0x0001A948, 0x0001A9A4, 0x0001A9C7, 0x0001A9E0,
+    0x0001AAE4, 0x0001AB00, 0x0001AC44, 0x0001AC80, 0x0001B024, 0x0001B048, 0x0001B080, 0x0001B944,
+    0x0001B960, 0x0001B9E4, 0x0001BA08, 0x0001BA44, 0x0001BAA0, 0x0001BAC4, 0x0001BAE0, 0x0001BB08,
+    0x0001BBE4, 0x0001BC00, 0x0001BE48, 0x0001BE80, 0x0001C624, 0x0001C640, 0x0001C668, 0x0001C684,
+    0x0001C760, 0x0001C8E4, 0x0001C9E0, 0x0001D624, 0x0001D640, 0x0001D668, 0x0001D684, 0x0001D7A0,
+    0x0001D904, 0x0001D9C0, 0x0001E304, 0x0001E340, 0x0001E6A4, 0x0001E6C0, 0x0001E6E4, 0x0001E700,
+    0x0001E724, 0x0001E740, 0x0001E7C8, 0x0001E800, 0x0001EE24, 0x0001EFE8, 0x0001F004, 0x0001F0A0,
+    0x0001F0C4, 0x0001F100, 0x0001F1A4, 0x0001F300, 0x0001F324, 0x0001F7A0, 0x0001F8C4, 0x0001F8E0,
+    0x000205A4, 0x00020628, 0x00020644, 0x00020700, 0x00020724, 0x00020768, 0x000207A4, 0x000207E0,
+    0x00020AC8, 0x00020B04, 0x00020B40, 0x00020BC4, 0x00020C20, 0x00020E24, 0x00020EA0, 0x00021044,
+    0x00021060, 0x00021088, 0x000210A4, 0x000210E0, 0x000211A4, 0x000211C0, 0x000213A4, 0x000213C0,
+    0x00022009, 0x00022C0A, 0x0002350B, 0x00024000, 0x00026BA4, 0x00026C00, 0x0002E244, 0x0002E2A8,
+    0x0002E2C0, 0x0002E644, 0x0002E688, 0x0002E6A0, 0x0002EA44, 0x0002EA80, 0x0002EE44, 0x0002EE80,
+    0x0002F684, 0x0002F6C8, 0x0002F6E4, 0x0002F7C8, 0x0002F8C4, 0x0002F8E8, 0x0002F924, 0x0002FA80,
+    0x0002FBA4, 0x0002FBC0, 0x00030164, 0x000301C3, 0x000301E4, 0x00030200, 0x000310A4, 0x000310E0,
+    0x00031524, 0x00031540, 0x00032404, 0x00032468, 0x000324E4, 0x00032528, 0x00032580, 0x00032608,
+    0x00032644, 0x00032668, 0x00032724, 0x00032780, 0x000342E4, 0x00034328, 0x00034364, 0x00034380,
+    0x00034AA8, 0x00034AC4, 0x00034AE8, 0x00034B04, 0x00034BE0, 0x00034C04, 0x00034C20, 0x00034C44,
+    0x00034C60, 0x00034CA4, 0x00034DA8, 0x00034E64, 0x00034FA0, 0x00034FE4, 0x00035000, 0x00035604,
+    0x000359E0, 0x00036004, 0x00036088, 0x000360A0, 0x00036684, 0x00036768, 0x00036784, 0x000367A8,
+    0x00036844, 0x00036868, 0x000368A0, 0x00036D64, 0x00036E80, 0x00037004, 0x00037048, 0x00037060,
+    0x00037428, 0x00037444, 0x000374C8, 0x00037504, 0x00037548, 0x00037564, 0x000375C0, 0x00037CC4,
+    0x00037CE8, 0x00037D04, 0x00037D48, 0x00037DA4, 0x00037DC8, 0x00037DE4, 0x00037E48, 0x00037E80,
+    0x00038488, 0x00038584, 0x00038688, 0x000386C4, 0x00038700, 0x00039A04, 0x00039A60, 0x00039A84,
+    0x00039C28, 0x00039C44, 0x00039D20, 0x00039DA4, 0x00039DC0, 0x00039E84, 0x00039EA0, 0x00039EE8,
+    0x00039F04, 0x00039F40, 0x0003B804, 0x0003C000, 0x00040163, 0x00040184, 0x000401A5, 0x000401C3,
+    0x00040200, 0x00040503, 0x000405E0, 0x0004078D, 0x000407A0, 0x0004092D, 0x00040940, 0x00040C03,
+    0x00040CA0, 0x00040CC3, 0x00040E00, 0x00041A04, 0x00041E20, 0x0004244D, 0x00042460, 0x0004272D,
+    0x00042740, 0x0004328D, 0x00043340, 0x0004352D, 0x00043560, 0x0004634D, 0x00046380, 0x0004650D,
+    0x00046520, 0x0004710D, 0x00047120, 0x000479ED, 0x00047A00, 0x00047D2D, 0x00047E80, 0x00047F0D,
+    0x00047F60, 0x0004984D, 0x00049860, 0x0004B54D, 0x0004B580, 0x0004B6CD, 0x0004B6E0, 0x0004B80D,
+    0x0004B820, 0x0004BF6D, 0x0004BFE0, 0x0004C00D, 0x0004C0C0, 0x0004C0ED, 0x0004C260, 0x0004C28D,
+    0x0004D0C0, 0x0004D20D, 0x0004E0C0, 0x0004E10D, 0x0004E260, 0x0004E28D, 0x0004E2A0, 0x0004E2CD,
+    0x0004E2E0, 0x0004E3AD, 0x0004E3C0, 0x0004E42D, 0x0004E440, 0x0004E50D, 0x0004E520, 0x0004E66D,
+    0x0004E6A0, 0x0004E88D, 0x0004E8A0, 0x0004E8ED, 0x0004E900, 0x0004E98D, 0x0004E9A0, 0x0004E9CD,
+    0x0004E9E0, 0x0004EA6D, 0x0004EAC0, 0x0004EAED, 0x0004EB00, 0x0004EC6D, 0x0004ED00, 0x0004F2AD,
+    0x0004F300, 0x0004F42D, 0x0004F440, 0x0004F60D, 0x0004F620, 0x0004F7ED, 0x0004F800, 0x0005268D,
+    0x000526C0, 0x000560AD, 0x00056100, 0x0005636D, 0x000563A0, 0x00056A0D, 0x00056A20, 0x00056AAD,
+    0x00056AC0, 0x00059DE4, 0x00059E40, 0x0005AFE4, 0x0005B000, 0x0005BC04, 0x0005C000, 0x00060544,
+    0x0006060D, 0x00060620, 0x000607AD, 0x000607C0, 0x00061324, 0x00061360, 0x000652ED, 0x00065300,
+    0x0006532D, 0x00065340, 0x0014CDE4, 0x0014CE60, 0x0014CE84, 0x0014CFC0, 0x0014D3C4, 0x0014D400,
+    0x0014DE04, 0x0014DE40, 0x00150044, 0x00150060, 0x001500C4, 0x001500E0, 0x00150164, 0x00150180,
+    0x00150468, 0x001504A4, 0x001504E8, 0x00150500, 0x00150584, 0x001505A0, 0x00151008, 0x00151040,
+    0x00151688, 0x00151884, 0x001518C0, 0x00151C04, 0x00151E40, 0x00151FE4, 0x00152000, 0x001524C4,
+    0x001525C0, 0x001528E4, 0x00152A48, 0x00152A80, 0x00152C09, 0x00152FA0, 0x00153004, 0x00153068,
+    0x00153080, 0x00153664, 0x00153688, 0x001536C4, 0x00153748, 0x00153784, 0x001537C8, 0x00153820,
+    0x00153CA4, 0x00153CC0, 0x00154524, 0x001545E8, 0x00154624, 0x00154668, 0x001546A4, 0x001546E0,
+    0x00154864, 0x00154880, 0x00154984, 0x001549A8, 0x001549C0, 0x00154F84, 0x00154FA0, 0x00155604,
+    0x00155620, 0x00155644, 0x001556A0, 0x001556E4, 0x00155720, 0x001557C4, 0x00155800, 0x00155824,
+    0x00155840, 0x00155D68, 0x00155D84, 0x00155DC8, 0x00155E00, 0x00155EA8, 0x00155EC4, 0x00155EE0,
+    0x00157C68, 0x00157CA4, 0x00157CC8, 0x00157D04, 0x00157D28, 0x00157D60, 0x00157D88, 0x00157DA4,
+    0x00157DC0, 0x0015800C, 0x001AF480, 0x001AF60A, 0x001AF8E0, 0x001AF96B, 0x001AFF80, 0x001B0003,
+    0x001C0000, 0x001F63C4, 0x001F63E0, 0x001FC004, 0x001FC200, 0x001FC404, 0x001FC600, 0x001FDFE3,
+    0x001FE000, 0x001FF3C4, 0x001FF400, 0x001FFF23, 0x001FFF80, 0x00203FA4, 0x00203FC0, 0x00205C04,
+    0x00205C20, 0x00206EC4, 0x00206F60, 0x00214024, 0x00214080, 0x002140A4, 0x002140E0, 0x00214184,
+    0x00214200, 0x00214704, 0x00214760, 0x002147E4, 0x00214800, 0x00215CA4, 0x00215CE0, 0x0021A484,
+    0x0021A500, 0x0021D564, 0x0021D5A0, 0x0021E8C4, 0x0021EA20, 0x0021F044, 0x0021F0C0, 0x00220008,
+    0x00220024, 0x00220048, 0x00220060, 0x00220704, 0x002208E0, 0x00220E04, 0x00220E20, 0x00220E64,
+    0x00220EA0, 0x00220FE4, 0x00221048, 0x00221060, 0x00221608, 0x00221664, 0x002216E8, 0x00221724,
+    0x00221760, 0x002217A7, 0x002217C0, 0x00221844, 0x00221860, 0x002219A7, 0x002219C0, 0x00222004,
+    0x00222060, 0x002224E4, 0x00222588, 0x002225A4, 0x002226A0, 0x002228A8, 0x002228E0, 0x00222E64,
+    0x00222E80, 0x00223004, 0x00223048, 0x00223060, 0x00223668, 0x002236C4, 0x002237E8, 0x00223820,
+    0x00223847, 0x00223880, 0x00223924, 0x002239A0, 0x002239C8, 0x002239E4, 0x00223A00, 0x00224588,
+    0x002245E4, 0x00224648, 0x00224684, 0x002246A8, 0x002246C4, 0x00224700, 0x002247C4, 0x002247E0,
+    0x00225BE4, 0x00225C08, 0x00225C64, 0x00225D60, 0x00226004, 0x00226048, 0x00226080, 0x00226764,
+    0x002267A0, 0x002267C4, 0x002267E8, 0x00226804, 0x00226828, 0x002268A0, 0x002268E8, 0x00226920,
+    0x00226968, 0x002269C0, 0x00226AE4, 0x00226B00, 0x00226C48, 0x00226C80, 0x00226CC4, 0x00226DA0,
+    0x00226E04, 0x00226EA0, 0x002286A8, 0x00228704, 0x00228808, 0x00228844, 0x002288A8, 0x002288C4,
+    0x002288E0, 0x00228BC4, 0x00228BE0, 0x00229604, 0x00229628, 0x00229664, 0x00229728, 0x00229744,
+    0x00229768, 0x002297A4, 0x002297C8, 0x002297E4, 0x00229828, 0x00229844, 0x00229880, 0x0022B5E4,
+    0x0022B608, 0x0022B644, 0x0022B6C0, 0x0022B708, 0x0022B784, 0x0022B7C8, 0x0022B7E4, 0x0022B820,
+    0x0022BB84, 0x0022BBC0, 0x0022C608, 0x0022C664, 0x0022C768, 0x0022C7A4, 0x0022C7C8, 0x0022C7E4,
+    0x0022C820, 0x0022D564, 0x0022D588, 0x0022D5A4, 0x0022D5C8, 0x0022D604, 0x0022D6C8, 0x0022D6E4,
+    0x0022D700, 0x0022E3A4, 0x0022E400, 0x0022E444, 0x0022E4C8, 0x0022E4E4, 0x0022E580, 0x00230588,
+    0x002305E4, 0x00230708, 0x00230724, 0x00230760, 0x00232604, 0x00232628, 0x002326C0, 0x002326E8,
+    0x00232720, 0x00232764, 0x002327A8, 0x002327C4, 0x002327E7, 0x00232808, 0x00232827, 0x00232848,
+    0x00232864, 0x00232880, 0x00233A28, 0x00233A84, 0x00233B00, 0x00233B44, 0x00233B88, 0x00233C04,
+    0x00233C20, 0x00233C88, 0x00233CA0, 0x00234024, 0x00234160, 0x00234664, 0x00234728, 0x00234747,
+    0x00234764, 0x002347E0, 0x002348E4, 0x00234900, 0x00234A24, 0x00234AE8, 0x00234B24, 0x00234B80,
+    0x00235087, 0x00235144, 0x002352E8, 0x00235304, 0x00235340, 0x002385E8, 0x00238604, 0x002386E0,
+    0x00238704, 0x002387C8, 0x002387E4, 0x00238800, 0x00239244, 0x00239500, 0x00239528, 0x00239544,
+    0x00239628, 0x00239644, 0x00239688, 0x002396A4, 0x002396E0, 0x0023A624, 0x0023A6E0, 0x0023A744,
+    0x0023A760, 0x0023A784, 0x0023A7C0, 0x0023A7E4, 0x0023A8C7, 0x0023A8E4, 0x0023A900, 0x0023B148,
+    0x0023B1E0, 0x0023B204, 0x0023B240, 0x0023B268, 0x0023B2A4, 0x0023B2C8, 0x0023B2E4, 0x0023B300,
+    0x0023DE64, 0x0023DEA8, 0x0023DEE0, 0x00268603, 0x00268720, 0x002D5E04, 0x002D5EA0, 0x002D6604,
+    0x002D66E0, 0x002DE9E4, 0x002DEA00, 0x002DEA28, 0x002DF100, 0x002DF1E4, 0x002DF260, 0x002DFC84,
+    0x002DFCA0, 0x002DFE08, 0x002DFE40, 0x003793A4, 0x003793E0, 0x00379403, 0x00379480, 0x0039E004,
+    0x0039E5C0, 0x0039E604, 0x0039E8E0, 0x003A2CA4, 0x003A2CC8, 0x003A2CE4, 0x003A2D40, 0x003A2DA8,
+    0x003A2DC4, 0x003A2E63, 0x003A2F64, 0x003A3060, 0x003A30A4, 0x003A3180, 0x003A3544, 0x003A35C0,
+    0x003A4844, 0x003A48A0, 0x003B4004, 0x003B46E0, 0x003B4764, 0x003B4DA0, 0x003B4EA4, 0x003B4EC0,
+    0x003B5084, 0x003B50A0, 0x003B5364, 0x003B5400, 0x003B5424, 0x003B5600, 0x003C0004, 0x003C00E0,
+    0x003C0104, 0x003C0320, 0x003C0364, 0x003C0440, 0x003C0464, 0x003C04A0, 0x003C04C4, 0x003C0560,
+    0x003C2604, 0x003C26E0, 0x003C55C4, 0x003C55E0, 0x003C5D84, 0x003C5E00, 0x003D1A04, 0x003D1AE0,
+    0x003D2884, 0x003D2960, 0x003E000D, 0x003E2000, 0x003E21AD, 0x003E2200, 0x003E25ED, 0x003E2600,
+    0x003E2D8D, 0x003E2E40, 0x003E2FCD, 0x003E3000, 0x003E31CD, 0x003E31E0, 0x003E322D, 0x003E3360,
+    0x003E35AD, 0x003E3CC6, 0x003E4000, 0x003E402D, 0x003E4200, 0x003E434D, 0x003E4360, 0x003E45ED,
+    0x003E4600, 0x003E464D, 0x003E4760, 0x003E478D, 0x003E4800, 0x003E492D, 0x003E7F64, 0x003E800D,
+    0x003EA7C0, 0x003EA8CD, 0x003ECA00, 0x003ED00D, 0x003EE000, 0x003EEE8D, 0x003EF000, 0x003EFAAD,
+    0x003F0000, 0x003F018D, 0x003F0200, 0x003F090D, 0x003F0A00, 0x003F0B4D, 0x003F0C00, 0x003F110D,
+    0x003F1200, 0x003F15CD, 0x003F2000, 0x003F218D, 0x003F2760, 0x003F278D, 0x003F28C0, 0x003F28ED,
+    0x003F6000, 0x003F800D, 0x003FFFC0, 0x01C00023, 0x01C00040, 0x01C00404, 0x01C01000, 0x01C02004,
+    0x01C03E00,
+};
+
+enum Word_Break : u8
+{
+    WordBreak_Other,
+    WordBreak_CR,
+    WordBreak_LF,
+    WordBreak_Newline,
+    WordBreak_Extend,
+    WordBreak_ZWJ,
+    WordBreak_RegionalIndicator,
+    WordBreak_Format,
+    WordBreak_Katakana,
+    WordBreak_HebrewLetter,
+    WordBreak_ALetter,
+    WordBreak_SingleQuote,
+    WordBreak_DoubleQuote,
+    WordBreak_MidNumLet,
+    WordBreak_MidLetter,
+    WordBreak_MidNum,
+    WordBreak_Numeric,
+    WordBreak_ExtendNumLet,
+    WordBreak_WSegSpace,
+    WordBreak_ExtendedPictographic,
+    WordBreak_OtherLetter,
+};
+
+static u32 unicode_word_break_table[2018] =
+{
+    0x00000000, 0x00000142, 0x00000163, 0x000001A1, 0x000001C0, 0x00000412, 0x00000420, 0x0000044C,
+    0x00000460, 0x000004EB, 0x00000500, 0x0000058F, 0x000005A0, 0x000005CD, 0x000005E0, 0x00000610,
+    0x0000074E, 0x0000076F, 0x00000780, 0x0000082A, 0x00000B60, 0x00000BF1, 0x00000C00, 0x00000C2A,
+    0x00000F60, 0x000010A3, 0x000010C0, 0x00001533, 0x0000154A, 0x00001560, 0x000015A7, 0x000015D3,
+    0x000015E0, 0x000016AA, 0x000016C0, 0x000016EE, 0x00001700, 0x0000174A, 0x00001760, 0x0000180A,
+    0x00001AE0, 0x00001B0A, 0x00001EE0, 0x00001F0A, 0x00005B00, 0x00005BCA, 0x00006004, 0x00006E0A,
+    0x00006EA0, 0x00006ECA, 0x00006F00, 0x00006F4A, 0x00006FCF, 0x00006FEA, 0x00007000, 0x000070CA,
+    0x000070EE, 0x0000710A, 0x00007160, 0x0000718A, 0x000071A0, 0x000071CA, 0x00007440, 0x0000746A,
+    0x00007EC0, 0x00007EEA, 0x00009040, 0x00009064, 0x0000914A, 0x0000A600, 0x0000A62A, 0x0000AAE0,
+    0x0000AB2A, 0x0000ABA0, 0x0000ABCA, 0x0000ABEE, 0x0000AC0A, 0x0000B12F, 0x0000B14A, 0x0000B160,
+    0x0000B224, 0x0000B7C0, 0x0000B7E4, 0x0000B800, 0x0000B824, 0x0000B860, 0x0000B884, 0x0000B8C0,
+    0x0000B8E4, 0x0000B900, 0x0000BA09, 0x0000BD60, 0x0000BDEA, 0x0000BE8E, 0x0000BEA0, 0x0000C18F,
+    0x0000C1C0, 0x0000C204, 0x0000C360, 0x0000C387, 0x0000C3A0, 0x0000C40A, 0x0000C964, 0x0000CC10,
+    0x0000CD40, 0x0000CD70, 0x0000CD8F, 0x0000CDA0, 0x0000CDCA, 0x0000CE04, 0x0000CE2A, 0x0000DA80,
+    0x0000DAAA, 0x0000DAC4, 0x0000DBA0, 0x0000DBE4, 0x0000DCAA, 0x0000DCE4, 0x0000DD20, 0x0000DD44,
+    0x0000DDCA, 0x0000DE10, 0x0000DF4A, 0x0000DFA0, 0x0000DFEA, 0x0000E000, 0x0000E20A, 0x0000E224,
+    0x0000E24A, 0x0000E604, 0x0000E960, 0x0000E9AA, 0x0000F4C4, 0x0000F62A, 0x0000F640, 0x0000F810,
+    0x0000F94A, 0x0000FD64, 0x0000FE8A, 0x0000FEC0, 0x0000FF0F, 0x0000FF20, 0x0000FF4A, 0x0000FF60,
+    0x0000FFA4, 0x0000FFC0, 0x0001000A, 0x000102C4, 0x0001034A, 0x00010364, 0x0001048A, 0x000104A4,
+    0x0001050A, 0x00010524, 0x000105C0, 0x0001080A, 0x00010B24, 0x00010B80, 0x00010C0A, 0x00010D60,
+    0x00010E0A, 0x00011100, 0x0001112A, 0x000111E0, 0x00011304, 0x0001140A, 0x00011944, 0x00011C40,
+    0x00011C64, 0x0001208A, 0x00012744, 0x000127AA, 0x000127C4, 0x00012A0A, 0x00012A24, 0x00012B0A,
+    0x00012C44, 0x00012C80, 0x00012CD0, 0x00012E00, 0x00012E2A, 0x00013024, 0x00013080, 0x000130AA,
+    0x000131A0, 0x000131EA, 0x00013220, 0x0001326A, 0x00013520, 0x0001354A, 0x00013620, 0x0001364A,
+    0x00013660, 0x000136CA, 0x00013740, 0x00013784, 0x000137AA, 0x000137C4, 0x000138A0, 0x000138E4,
+    0x00013920, 0x00013964, 0x000139CA, 0x000139E0, 0x00013AE4, 0x00013B00, 0x00013B8A, 0x00013BC0,
+    0x00013BEA, 0x00013C44, 0x00013C80, 0x00013CD0, 0x00013E0A, 0x00013E40, 0x00013F8A, 0x00013FA0,
+    0x00013FC4, 0x00013FE0, 0x00014024, 0x00014080, 0x000140AA, 0x00014160, 0x000141EA, 0x00014220,
+    0x0001426A, 0x00014520, 0x0001454A, 0x00014620, 0x0001464A, 0x00014680, 0x000146AA, 0x000146E0,
+    0x0001470A, 0x00014740, 0x00014784, 0x000147A0, 0x000147C4, 0x00014860, 0x000148E4, 0x00014920,
+    0x00014964, 0x000149C0, 0x00014A24, 0x00014A40, 0x00014B2A, 0x00014BA0, 0x00014BCA, 0x00014BE0,
+    0x00014CD0, 0x00014E04, 0x00014E4A, 0x00014EA4, 0x00014EC0, 0x00015024, 0x00015080, 0x000150AA,
+    0x000151C0, 0x000151EA, 0x00015240, 0x0001526A, 0x00015520, 0x0001554A, 0x00015620, 0x0001564A,
+    0x00015680, 0x000156AA, 0x00015740, 0x00015784, 0x000157AA, 0x000157C4, 0x000158C0, 0x000158E4,
+    0x00015940, 0x00015964, 0x000159C0, 0x00015A0A, 0x00015A20, 0x00015C0A, 0x00015C44, 0x00015C80,
+    0x00015CD0, 0x00015E00, 0x00015F2A, 0x00015F44, 0x00016000, 0x00016024, 0x00016080, 0x000160AA,
+    0x000161A0, 0x000161EA, 0x00016220, 0x0001626A, 0x00016520, 0x0001654A, 0x00016620, 0x0001664A,
+    0x00016680, 0x000166AA, 0x00016740, 0x00016784, 0x000167AA, 0x000167C4, 0x000168A0, 0x000168E4,
+    0x00016920, 0x00016964, 0x000169C0, 0x00016AA4, 0x00016B00, 0x00016B8A, 0x00016BC0, 0x00016BEA,
+    0x00016C44, 0x00016C80, 0x00016CD0, 0x00016E00, 0x00016E2A, 0x00016E40, 0x00017044, 0x0001706A,
+    0x00017080, 0x000170AA, 0x00017160, 0x000171CA, 0x00017220, 0x0001724A, 0x000172C0, 0x0001732A,
+    0x00017360, 0x0001738A, 0x000173A0, 0x000173CA, 0x00017400, 0x0001746A, 0x000174A0, 0x0001750A,
+    0x00017560, 0x000175CA, 0x00017740, 0x000177C4, 0x00017860, 0x000178C4, 0x00017920, 0x00017944,
+    0x000179C0, 0x00017A0A, 0x00017A20, 0x00017AE4, 0x00017B00, 0x00017CD0, 0x00017E00, 0x00018004,
+    0x000180AA, 0x000181A0, 0x000181CA, 0x00018220, 0x0001824A, 0x00018520, 0x0001854A, 0x00018740,
+    0x00018784, 0x000187AA, 0x000187C4, 0x000188A0, 0x000188C4, 0x00018920, 0x00018944, 0x000189C0,
+    0x00018AA4, 0x00018AE0, 0x00018B0A, 0x00018B60, 0x00018BAA, 0x00018BC0, 0x00018C0A, 0x00018C44,
+    0x00018C80, 0x00018CD0, 0x00018E00, 0x0001900A, 0x00019024, 0x00019080, 0x000190AA, 0x000191A0,
+    0x000191CA, 0x00019220, 0x0001924A, 0x00019520, 0x0001954A, 0x00019680, 0x000196AA, 0x00019740,
+    0x00019784, 0x000197AA, 0x000197C4, 0x000198A0, 0x000198C4, 0x00019920, 0x00019944, 0x000199C0,
+    0x00019AA4, 0x00019AE0, 0x00019BAA, 0x00019BE0, 0x00019C0A, 0x00019C44, 0x00019C80, 0x00019CD0,
+    0x00019E00, 0x00019E2A, 0x00019E60, 0x0001A004, 0x0001A08A, 0x0001A1A0, 0x0001A1CA, 0x0001A220,
+    0x0001A24A, 0x0001A764, 0x0001A7AA, 0x0001A7C4, 0x0001A8A0, 0x0001A8C4, 0x0001A920, 0x0001A944,
+    0x0001A9CA, 0x0001A9E0, 0x0001AA8A, 0x0001AAE4, 0x0001AB00, 0x0001ABEA, 0x0001AC44, 0x0001AC80,
+    0x0001ACD0, 0x0001AE00, 0x0001AF4A, 0x0001B000, 0x0001B024, 0x0001B080, 0x0001B0AA, 0x0001B2E0,
+    0x0001B34A, 0x0001B640, 0x0001B66A, 0x0001B780, 0x0001B7AA, 0x0001B7C0, 0x0001B80A, 0x0001B8E0,
+    0x0001B944, 0x0001B960, 0x0001B9E4, 0x0001BAA0, 0x0001BAC4, 0x0001BAE0, 0x0001BB04, 0x0001BC00,
+    0x0001BCD0, 0x0001BE00, 0x0001BE44, 0x0001BE80, 0x0001C034, 0x0001C624, 0x0001C654, 0x0001C684,
+    0x0001C760, 0x0001C814, 0x0001C8E4, 0x0001C9E0, 0x0001CA10, 0x0001CB40, 0x0001D034, 0x0001D060,
+    0x0001D094, 0x0001D0A0, 0x0001D0D4, 0x0001D160, 0x0001D194, 0x0001D480, 0x0001D4B4, 0x0001D4C0,
+    0x0001D4F4, 0x0001D624, 0x0001D654, 0x0001D684, 0x0001D7B4, 0x0001D7C0, 0x0001D814, 0x0001D8A0,
+    0x0001D8D4, 0x0001D8E0, 0x0001D904, 0x0001D9C0, 0x0001DA10, 0x0001DB40, 0x0001DB94, 0x0001DC00,
+    0x0001E00A, 0x0001E020, 0x0001E304, 0x0001E340, 0x0001E410, 0x0001E540, 0x0001E6A4, 0x0001E6C0,
+    0x0001E6E4, 0x0001E700, 0x0001E724, 0x0001E740, 0x0001E7C4, 0x0001E80A, 0x0001E900, 0x0001E92A,
+    0x0001EDA0, 0x0001EE24, 0x0001F0A0, 0x0001F0C4, 0x0001F10A, 0x0001F1A4, 0x0001F300, 0x0001F324,
+    0x0001F7A0, 0x0001F8C4, 0x0001F8E0, 0x00020014, 0x00020564, 0x000207F4, 0x00020810, 0x00020940,
+    0x00020A14, 0x00020AC4, 0x00020B54, 0x00020BC4, 0x00020C34, 0x00020C44, 0x00020CB4, 0x00020CE4,
+    0x00020DD4, 0x00020E24, 0x00020EB4, 0x00021044, 0x000211D4, 0x000211E4, 0x00021210, 0x00021344,
+    0x000213C0, 0x0002140A, 0x000218C0, 0x000218EA, 0x00021900, 0x000219AA, 0x000219C0, 0x00021A0A,
+    0x00021F60, 0x00021F8A, 0x00024920, 0x0002494A, 0x000249C0, 0x00024A0A, 0x00024AE0, 0x00024B0A,
+    0x00024B20, 0x00024B4A, 0x00024BC0, 0x00024C0A, 0x00025120, 0x0002514A, 0x000251C0, 0x0002520A,
+    0x00025620, 0x0002564A, 0x000256C0, 0x0002570A, 0x000257E0, 0x0002580A, 0x00025820, 0x0002584A,
+    0x000258C0, 0x0002590A, 0x00025AE0, 0x00025B0A, 0x00026220, 0x0002624A, 0x000262C0, 0x0002630A,
+    0x00026B60, 0x00026BA4, 0x00026C00, 0x0002700A, 0x00027200, 0x0002740A, 0x00027EC0, 0x00027F0A,
+    0x00027FC0, 0x0002802A, 0x0002CDA0, 0x0002CDEA, 0x0002D012, 0x0002D02A, 0x0002D360, 0x0002D40A,
+    0x0002DD60, 0x0002DDCA, 0x0002DF20, 0x0002E00A, 0x0002E244, 0x0002E2C0, 0x0002E3EA, 0x0002E644,
+    0x0002E6A0, 0x0002E80A, 0x0002EA44, 0x0002EA80, 0x0002EC0A, 0x0002EDA0, 0x0002EDCA, 0x0002EE20,
+    0x0002EE44, 0x0002EE80, 0x0002F014, 0x0002F684, 0x0002FA80, 0x0002FAF4, 0x0002FB00, 0x0002FB94,
+    0x0002FBA4, 0x0002FBC0, 0x0002FC10, 0x0002FD40, 0x00030164, 0x000301C7, 0x000301E4, 0x00030210,
+    0x00030340, 0x0003040A, 0x00030F20, 0x0003100A, 0x000310A4, 0x000310EA, 0x00031524, 0x0003154A,
+    0x00031560, 0x0003160A, 0x00031EC0, 0x0003200A, 0x000323E0, 0x00032404, 0x00032580, 0x00032604,
+    0x00032780, 0x000328D0, 0x00032A14, 0x00032DC0, 0x00032E14, 0x00032EA0, 0x00033014, 0x00033580,
+    0x00033614, 0x00033940, 0x00033A10, 0x00033B40, 0x0003400A, 0x000342E4, 0x00034380, 0x00034414,
+    0x00034AA4, 0x00034BE0, 0x00034C04, 0x00034FA0, 0x00034FE4, 0x00035010, 0x00035140, 0x00035210,
+    0x00035340, 0x000354F4, 0x00035500, 0x00035604, 0x000359E0, 0x00036004, 0x000360AA, 0x00036684,
+    0x000368AA, 0x000369A0, 0x00036A10, 0x00036B40, 0x00036D64, 0x00036E80, 0x00037004, 0x0003706A,
+    0x00037424, 0x000375CA, 0x00037610, 0x0003774A, 0x00037CC4, 0x00037E80, 0x0003800A, 0x00038484,
+    0x00038700, 0x00038810, 0x00038940, 0x000389AA, 0x00038A10, 0x00038B4A, 0x00038FC0, 0x0003900A,
+    0x00039120, 0x0003920A, 0x00039760, 0x000397AA, 0x00039800, 0x00039A04, 0x00039A60, 0x00039A84,
+    0x00039D2A, 0x00039DA4, 0x00039DCA, 0x00039E84, 0x00039EAA, 0x00039EE4, 0x00039F4A, 0x00039F60,
+    0x0003A00A, 0x0003B804, 0x0003C00A, 0x0003E2C0, 0x0003E30A, 0x0003E3C0, 0x0003E40A, 0x0003E8C0,
+    0x0003E90A, 0x0003E9C0, 0x0003EA0A, 0x0003EB00, 0x0003EB2A, 0x0003EB40, 0x0003EB6A, 0x0003EB80,
+    0x0003EBAA, 0x0003EBC0, 0x0003EBEA, 0x0003EFC0, 0x0003F00A, 0x0003F6A0, 0x0003F6CA, 0x0003F7A0,
+    0x0003F7CA, 0x0003F7E0, 0x0003F84A, 0x0003F8A0, 0x0003F8CA, 0x0003F9A0, 0x0003FA0A, 0x0003FA80,
+    0x0003FACA, 0x0003FB80, 0x0003FC0A, 0x0003FDA0, 0x0003FE4A, 0x0003FEA0, 0x0003FECA, 0x0003FFA0,
+    0x00040012, 0x000400E0, 0x00040112, 0x00040160, 0x00040184, 0x000401A5, 0x000401C7, 0x00040200,
+    0x0004030D, 0x00040340, 0x0004048D, 0x000404A0, 0x000404EE, 0x00040503, 0x00040547, 0x000405F1,
+    0x00040600, 0x00040793, 0x000407A0, 0x000407F1, 0x00040820, 0x0004088F, 0x000408A0, 0x00040933,
+    0x00040940, 0x00040A91, 0x00040AA0, 0x00040BF2, 0x00040C07, 0x00040CA0, 0x00040CC7, 0x00040E00,
+    0x00040E2A, 0x00040E40, 0x00040FEA, 0x00041000, 0x0004120A, 0x000413A0, 0x00041A04, 0x00041E20,
+    0x0004204A, 0x00042060, 0x000420EA, 0x00042100, 0x0004214A, 0x00042280, 0x000422AA, 0x000422C0,
+    0x0004232A, 0x000423C0, 0x00042453, 0x00042460, 0x0004248A, 0x000424A0, 0x000424CA, 0x000424E0,
+    0x0004250A, 0x00042520, 0x0004254A, 0x000425C0, 0x000425EA, 0x00042740, 0x0004278A, 0x00042800,
+    0x000428AA, 0x00042940, 0x000429CA, 0x000429E0, 0x00042C0A, 0x00043120, 0x00043293, 0x00043340,
+    0x00043533, 0x00043560, 0x00046353, 0x00046380, 0x00046513, 0x00046520, 0x00047113, 0x00047120,
+    0x000479F3, 0x00047A00, 0x00047D33, 0x00047E80, 0x00047F13, 0x00047F60, 0x000496CA, 0x00049D40,
+    0x0004B553, 0x0004B580, 0x0004B6D3, 0x0004B6E0, 0x0004B813, 0x0004B820, 0x0004BF73, 0x0004BFE0,
+    0x0004C013, 0x0004C0C0, 0x0004C0F3, 0x0004C260, 0x0004C293, 0x0004D0C0, 0x0004D213, 0x0004E0C0,
+    0x0004E113, 0x0004E260, 0x0004E293, 0x0004E2A0, 0x0004E2D3, 0x0004E2E0, 0x0004E3B3, 0x0004E3C0,
+    0x0004E433, 0x0004E440, 0x0004E513, 0x0004E520, 0x0004E673, 0x0004E6A0, 0x0004E893, 0x0004E8A0,
+    0x0004E8F3, 0x0004E900, 0x0004E993, 0x0004E9A0, 0x0004E9D3, 0x0004E9E0, 0x0004EA73, 0x0004EAC0,
+    0x0004EAF3, 0x0004EB00, 0x0004EC73, 0x0004ED00, 0x0004F2B3, 0x0004F300, 0x0004F433, 0x0004F440,
+    0x0004F613, 0x0004F620, 0x0004F7F3, 0x0004F800, 0x00052693, 0x000526C0, 0x000560B3, 0x00056100,
+    0x00056373, 0x000563A0, 0x00056A13, 0x00056A20, 0x00056AB3, 0x00056AC0, 0x0005800A, 0x00059CA0,
+    0x00059D6A, 0x00059DE4, 0x00059E4A, 0x00059E80, 0x0005A00A, 0x0005A4C0, 0x0005A4EA, 0x0005A500,
+    0x0005A5AA, 0x0005A5C0, 0x0005A60A, 0x0005AD00, 0x0005ADEA, 0x0005AE00, 0x0005AFE4, 0x0005B00A,
+    0x0005B2E0, 0x0005B40A, 0x0005B4E0, 0x0005B50A, 0x0005B5E0, 0x0005B60A, 0x0005B6E0, 0x0005B70A,
+    0x0005B7E0, 0x0005B80A, 0x0005B8E0, 0x0005B90A, 0x0005B9E0, 0x0005BA0A, 0x0005BAE0, 0x0005BB0A,
+    0x0005BBE0, 0x0005BC04, 0x0005C000, 0x0005C5EA, 0x0005C600, 0x00060012, 0x00060020, 0x000600B4,
+    0x00060100, 0x00060434, 0x00060544, 0x00060613, 0x00060628, 0x000606C0, 0x00060714, 0x0006078A,
+    0x000607B3, 0x000607C0, 0x00060834, 0x000612E0, 0x00061324, 0x00061368, 0x000613B4, 0x00061408,
+    0x00061F60, 0x00061F88, 0x00062000, 0x000620AA, 0x00062600, 0x0006262A, 0x000631E0, 0x0006340A,
+    0x00063800, 0x00063E08, 0x00064000, 0x000652F3, 0x00065300, 0x00065333, 0x00065340, 0x00065A08,
+    0x00065FE0, 0x00066008, 0x00066B00, 0x00068014, 0x0009B800, 0x0009C014, 0x0014000A, 0x001491A0,
+    0x00149A0A, 0x00149FC0, 0x0014A00A, 0x0014C1A0, 0x0014C20A, 0x0014C410, 0x0014C54A, 0x0014C580,
+    0x0014C80A, 0x0014CDE4, 0x0014CE60, 0x0014CE84, 0x0014CFC0, 0x0014CFEA, 0x0014D3C4, 0x0014D40A,
+    0x0014DE04, 0x0014DE40, 0x0014E10A, 0x0014F960, 0x0014FA0A, 0x0014FA40, 0x0014FA6A, 0x0014FA80,
+    0x0014FAAA, 0x0014FB40, 0x0014FE4A, 0x00150044, 0x0015006A, 0x001500C4, 0x001500EA, 0x00150164,
+    0x0015018A, 0x00150464, 0x00150500, 0x00150584, 0x001505A0, 0x0015080A, 0x00150E80, 0x00151004,
+    0x0015104A, 0x00151684, 0x001518C0, 0x00151A10, 0x00151B40, 0x00151C04, 0x00151E4A, 0x00151F00,
+    0x00151F6A, 0x00151F80, 0x00151FAA, 0x00151FE4, 0x00152010, 0x0015214A, 0x001524C4, 0x001525C0,
+    0x0015260A, 0x001528E4, 0x00152A80, 0x00152C0A, 0x00152FA0, 0x00153004, 0x0015308A, 0x00153664,
+    0x00153820, 0x001539EA, 0x00153A10, 0x00153B40, 0x00153C14, 0x00153CA4, 0x00153CD4, 0x00153E10,
+    0x00153F54, 0x00153FE0, 0x0015400A, 0x00154524, 0x001546E0, 0x0015480A, 0x00154864, 0x0015488A,
+    0x00154984, 0x001549C0, 0x00154A10, 0x00154B40, 0x00154C14, 0x00154EE0, 0x00154F54, 0x00154F64,
+    0x00154FD4, 0x00155604, 0x00155634, 0x00155644, 0x001556B4, 0x001556E4, 0x00155734, 0x001557C4,
+    0x00155814, 0x00155824, 0x00155854, 0x00155860, 0x00155B74, 0x00155BC0, 0x00155C0A, 0x00155D64,
+    0x00155E00, 0x00155E4A, 0x00155EA4, 0x00155EE0, 0x0015602A, 0x001560E0, 0x0015612A, 0x001561E0,
+    0x0015622A, 0x001562E0, 0x0015640A, 0x001564E0, 0x0015650A, 0x001565E0, 0x0015660A, 0x00156D40,
+    0x00156E0A, 0x00157C64, 0x00157D60, 0x00157D84, 0x00157DC0, 0x00157E10, 0x00157F40, 0x0015800A,
+    0x001AF480, 0x001AF60A, 0x001AF8E0, 0x001AF96A, 0x001AFF80, 0x001F2014, 0x001F4DC0, 0x001F4E14,
+    0x001F5B40, 0x001F600A, 0x001F60E0, 0x001F626A, 0x001F6300, 0x001F63A9, 0x001F63C4, 0x001F63EA,
+    0x001F6409, 0x001F6520, 0x001F6549, 0x001F66E0, 0x001F6709, 0x001F67A0, 0x001F67C9, 0x001F67E0,
+    0x001F6809, 0x001F6840, 0x001F6869, 0x001F68A0, 0x001F68C9, 0x001F69EA, 0x001F7640, 0x001F7A6A,
+    0x001FA7C0, 0x001FAA0A, 0x001FB200, 0x001FB24A, 0x001FB900, 0x001FBE0A, 0x001FBF80, 0x001FC004,
+    0x001FC20F, 0x001FC220, 0x001FC26E, 0x001FC28F, 0x001FC2A0, 0x001FC404, 0x001FC600, 0x001FC671,
+    0x001FC6A0, 0x001FC9B1, 0x001FCA0F, 0x001FCA20, 0x001FCA4D, 0x001FCA60, 0x001FCA8F, 0x001FCAAE,
+    0x001FCAC0, 0x001FCE0A, 0x001FCEA0, 0x001FCECA, 0x001FDFA0, 0x001FDFE7, 0x001FE000, 0x001FE0ED,
+    0x001FE100, 0x001FE18F, 0x001FE1A0, 0x001FE1CD, 0x001FE1E0, 0x001FE210, 0x001FE34E, 0x001FE36F,
+    0x001FE380, 0x001FE42A, 0x001FE760, 0x001FE7F1, 0x001FE800, 0x001FE82A, 0x001FEB60, 0x001FECC8,
+    0x001FF3C4, 0x001FF40A, 0x001FF7E0, 0x001FF84A, 0x001FF900, 0x001FF94A, 0x001FFA00, 0x001FFA4A,
+    0x001FFB00, 0x001FFB4A, 0x001FFBA0, 0x001FFF27, 0x001FFF80, 0x0020000A, 0x00200180, 0x002001AA,
+    0x002004E0, 0x0020050A, 0x00200760, 0x0020078A, 0x002007C0, 0x002007EA, 0x002009C0, 0x00200A0A,
+    0x00200BC0, 0x0020100A, 0x00201F60, 0x0020280A, 0x00202EA0, 0x00203FA4, 0x00203FC0, 0x0020500A,
+    0x002053A0, 0x0020540A, 0x00205A20, 0x00205C04, 0x00205C20, 0x0020600A, 0x00206400, 0x002065AA,
+    0x00206960, 0x00206A0A, 0x00206EC4, 0x00206F60, 0x0020700A, 0x002073C0, 0x0020740A, 0x00207880,
+    0x0020790A, 0x00207A00, 0x00207A2A, 0x00207AC0, 0x0020800A, 0x002093C0, 0x00209410, 0x00209540,
+    0x0020960A, 0x00209A80, 0x00209B0A, 0x00209F80, 0x0020A00A, 0x0020A500, 0x0020A60A, 0x0020AC80,
+    0x0020AE0A, 0x0020AF60, 0x0020AF8A, 0x0020B160, 0x0020B18A, 0x0020B260, 0x0020B28A, 0x0020B2C0,
+    0x0020B2EA, 0x0020B440, 0x0020B46A, 0x0020B640, 0x0020B66A, 0x0020B740, 0x0020B76A, 0x0020B7A0,
+    0x0020C00A, 0x0020E6E0, 0x0020E80A, 0x0020EAC0, 0x0020EC0A, 0x0020ED00, 0x0020F00A, 0x0020F0C0,
+    0x0020F0EA, 0x0020F620, 0x0020F64A, 0x0020F760, 0x0021000A, 0x002100C0, 0x0021010A, 0x00210120,
+    0x0021014A, 0x002106C0, 0x002106EA, 0x00210720, 0x0021078A, 0x002107A0, 0x002107EA, 0x00210AC0,
+    0x00210C0A, 0x00210EE0, 0x0021100A, 0x002113E0, 0x00211C0A, 0x00211E60, 0x00211E8A, 0x00211EC0,
+    0x0021200A, 0x002122C0, 0x0021240A, 0x00212740, 0x0021300A, 0x00213700, 0x002137CA, 0x00213800,
+    0x0021400A, 0x00214024, 0x00214080, 0x002140A4, 0x002140E0, 0x00214184, 0x0021420A, 0x00214280,
+    0x002142AA, 0x00214300, 0x0021432A, 0x002146C0, 0x00214704, 0x00214760, 0x002147E4, 0x00214800,
+    0x00214C0A, 0x00214FA0, 0x0021500A, 0x002153A0, 0x0021580A, 0x00215900, 0x0021592A, 0x00215CA4,
+    0x00215CE0, 0x0021600A, 0x002166C0, 0x0021680A, 0x00216AC0, 0x00216C0A, 0x00216E60, 0x0021700A,
+    0x00217240, 0x0021800A, 0x00218920, 0x0021900A, 0x00219660, 0x0021980A, 0x00219E60, 0x0021A00A,
+    0x0021A484, 0x0021A500, 0x0021A610, 0x0021A740, 0x0021D00A, 0x0021D540, 0x0021D564, 0x0021D5A0,
+    0x0021D60A, 0x0021D640, 0x0021E00A, 0x0021E3A0, 0x0021E4EA, 0x0021E500, 0x0021E60A, 0x0021E8C4,
+    0x0021EA20, 0x0021EE0A, 0x0021F044, 0x0021F0C0, 0x0021F60A, 0x0021F8A0, 0x0021FC0A, 0x0021FEE0,
+    0x00220004, 0x0022006A, 0x00220704, 0x002208E0, 0x00220CD0, 0x00220E04, 0x00220E2A, 0x00220E64,
+    0x00220EAA, 0x00220EC0, 0x00220FE4, 0x0022106A, 0x00221604, 0x00221760, 0x00221844, 0x00221860,
+    0x00221A0A, 0x00221D20, 0x00221E10, 0x00221F40, 0x00222004, 0x0022206A, 0x002224E4, 0x002226A0,
+    0x002226D0, 0x00222800, 0x0022288A, 0x002228A4, 0x002228EA, 0x00222900, 0x00222A0A, 0x00222E64,
+    0x00222E80, 0x00222ECA, 0x00222EE0, 0x00223004, 0x0022306A, 0x00223664, 0x0022382A, 0x002238A0,
+    0x00223924, 0x002239A0, 0x002239C4, 0x00223A10, 0x00223B4A, 0x00223B60, 0x00223B8A, 0x00223BA0,
+    0x0022400A, 0x00224240, 0x0022426A, 0x00224584, 0x00224700, 0x002247C4, 0x002247E0, 0x0022500A,
+    0x002250E0, 0x0022510A, 0x00225120, 0x0022514A, 0x002251C0, 0x002251EA, 0x002253C0, 0x002253EA,
+    0x00225520, 0x0022560A, 0x00225BE4, 0x00225D60, 0x00225E10, 0x00225F40, 0x00226004, 0x00226080,
+    0x002260AA, 0x002261A0, 0x002261EA, 0x00226220, 0x0022626A, 0x00226520, 0x0022654A, 0x00226620,
+    0x0022664A, 0x00226680, 0x002266AA, 0x00226740, 0x00226764, 0x002267AA, 0x002267C4, 0x002268A0,
+    0x002268E4, 0x00226920, 0x00226964, 0x002269C0, 0x00226A0A, 0x00226A20, 0x00226AE4, 0x00226B00,
+    0x00226BAA, 0x00226C44, 0x00226C80, 0x00226CC4, 0x00226DA0, 0x00226E04, 0x00226EA0, 0x0022800A,
+    0x002286A4, 0x002288EA, 0x00228960, 0x00228A10, 0x00228B40, 0x00228BC4, 0x00228BEA, 0x00228C40,
+    0x0022900A, 0x00229604, 0x0022988A, 0x002298C0, 0x002298EA, 0x00229900, 0x00229A10, 0x00229B40,
+    0x0022B00A, 0x0022B5E4, 0x0022B6C0, 0x0022B704, 0x0022B820, 0x0022BB0A, 0x0022BB84, 0x0022BBC0,
+    0x0022C00A, 0x0022C604, 0x0022C820, 0x0022C88A, 0x0022C8A0, 0x0022CA10, 0x0022CB40, 0x0022D00A,
+    0x0022D564, 0x0022D70A, 0x0022D720, 0x0022D810, 0x0022D940, 0x0022E014, 0x0022E360, 0x0022E3A4,
+    0x0022E580, 0x0022E610, 0x0022E740, 0x0022E814, 0x0022E8E0, 0x0023000A, 0x00230584, 0x00230760,
+    0x0023140A, 0x00231C10, 0x00231D40, 0x00231FEA, 0x002320E0, 0x0023212A, 0x00232140, 0x0023218A,
+    0x00232280, 0x002322AA, 0x002322E0, 0x0023230A, 0x00232604, 0x002326C0, 0x002326E4, 0x00232720,
+    0x00232764, 0x002327EA, 0x00232804, 0x0023282A, 0x00232844, 0x00232880, 0x00232A10, 0x00232B40,
+    0x0023340A, 0x00233500, 0x0023354A, 0x00233A24, 0x00233B00, 0x00233B44, 0x00233C2A, 0x00233C40,
+    0x00233C6A, 0x00233C84, 0x00233CA0, 0x0023400A, 0x00234024, 0x0023416A, 0x00234664, 0x0023474A,
+    0x00234764, 0x002347E0, 0x002348E4, 0x00234900, 0x00234A0A, 0x00234A24, 0x00234B8A, 0x00235144,
+    0x00235340, 0x002353AA, 0x002353C0, 0x0023560A, 0x00235F20, 0x0023800A, 0x00238120, 0x0023814A,
+    0x002385E4, 0x002386E0, 0x00238704, 0x0023880A, 0x00238820, 0x00238A10, 0x00238B40, 0x00238E4A,
+    0x00239200, 0x00239244, 0x00239500, 0x00239524, 0x002396E0, 0x0023A00A, 0x0023A0E0, 0x0023A10A,
+    0x0023A140, 0x0023A16A, 0x0023A624, 0x0023A6E0, 0x0023A744, 0x0023A760, 0x0023A784, 0x0023A7C0,
+    0x0023A7E4, 0x0023A8CA, 0x0023A8E4, 0x0023A900, 0x0023AA10, 0x0023AB40, 0x0023AC0A, 0x0023ACC0,
+    0x0023ACEA, 0x0023AD20, 0x0023AD4A, 0x0023B144, 0x0023B1E0, 0x0023B204, 0x0023B240, 0x0023B264,
+    0x0023B30A, 0x0023B320, 0x0023B410, 0x0023B540, 0x0023DC0A, 0x0023DE64, 0x0023DEE0, 0x0023F60A,
+    0x0023F620, 0x0024000A, 0x00247340, 0x0024800A, 0x00248DE0, 0x0024900A, 0x0024A880, 0x0025F20A,
+    0x0025FE20, 0x0026000A, 0x002685E0, 0x00268607, 0x00268720, 0x0028800A, 0x0028C8E0, 0x002D000A,
+    0x002D4720, 0x002D480A, 0x002D4BE0, 0x002D4C10, 0x002D4D40, 0x002D4E0A, 0x002D57E0, 0x002D5810,
+    0x002D5940, 0x002D5A0A, 0x002D5DC0, 0x002D5E04, 0x002D5EA0, 0x002D600A, 0x002D6604, 0x002D66E0,
+    0x002D680A, 0x002D6880, 0x002D6A10, 0x002D6B40, 0x002D6C6A, 0x002D6F00, 0x002D6FAA, 0x002D7200,
+    0x002DC80A, 0x002DD000, 0x002DE00A, 0x002DE960, 0x002DE9E4, 0x002DEA0A, 0x002DEA24, 0x002DF100,
+    0x002DF1E4, 0x002DF26A, 0x002DF400, 0x002DFC14, 0x002DFC40, 0x002DFC6A, 0x002DFC84, 0x002DFCA0,
+    0x002DFE04, 0x002DFE40, 0x002E000A, 0x0030FF00, 0x00310014, 0x00319AC0, 0x0031A00A, 0x0031A120,
+    0x0035FE08, 0x0035FE80, 0x0035FEA8, 0x0035FF80, 0x0035FFA8, 0x0035FFE0, 0x00360008, 0x00360034,
+    0x0036004A, 0x003623F4, 0x00362408, 0x00362460, 0x00362A14, 0x00362A60, 0x00362C88, 0x00362D00,
+    0x00362E14, 0x00365F80, 0x0037800A, 0x00378D60, 0x00378E0A, 0x00378FA0, 0x0037900A, 0x00379120,
+    0x0037920A, 0x00379340, 0x003793A4, 0x003793E0, 0x00379407, 0x00379480, 0x0039E004, 0x0039E5C0,
+    0x0039E604, 0x0039E8E0, 0x003A2CA4, 0x003A2D40, 0x003A2DA4, 0x003A2E67, 0x003A2F64, 0x003A3060,
+    0x003A30A4, 0x003A3180, 0x003A3544, 0x003A35C0, 0x003A4844, 0x003A48A0, 0x003A800A, 0x003A8AA0,
+    0x003A8ACA, 0x003A93A0, 0x003A93CA, 0x003A9400, 0x003A944A, 0x003A9460, 0x003A94AA, 0x003A94E0,
+    0x003A952A, 0x003A95A0, 0x003A95CA, 0x003A9740, 0x003A976A, 0x003A9780, 0x003A97AA, 0x003A9880,
+    0x003A98AA, 0x003AA0C0, 0x003AA0EA, 0x003AA160, 0x003AA1AA, 0x003AA2A0, 0x003AA2CA, 0x003AA3A0,
+    0x003AA3CA, 0x003AA740, 0x003AA76A, 0x003AA7E0, 0x003AA80A, 0x003AA8A0, 0x003AA8CA, 0x003AA8E0,
+    0x003AA94A, 0x003AAA20, 0x003AAA4A, 0x003AD4C0, 0x003AD50A, 0x003AD820, 0x003AD84A, 0x003ADB60,
+    0x003ADB8A, 0x003ADF60, 0x003ADF8A, 0x003AE2A0, 0x003AE2CA, 0x003AE6A0, 0x003AE6CA, 0x003AE9E0,
+    0x003AEA0A, 0x003AEDE0, 0x003AEE0A, 0x003AF120, 0x003AF14A, 0x003AF520, 0x003AF54A, 0x003AF860,
+    0x003AF88A, 0x003AF980, 0x003AF9D0, 0x003B0000, 0x003B4004, 0x003B46E0, 0x003B4764, 0x003B4DA0,
+    0x003B4EA4, 0x003B4EC0, 0x003B5084, 0x003B50A0, 0x003B5364, 0x003B5400, 0x003B5424, 0x003B5600,
+    0x003BE00A, 0x003BE3E0, 0x003C0004, 0x003C00E0, 0x003C0104, 0x003C0320, 0x003C0364, 0x003C0440,
+    0x003C0464, 0x003C04A0, 0x003C04C4, 0x003C0560, 0x003C200A, 0x003C25A0, 0x003C2604, 0x003C26EA,
+    0x003C27C0, 0x003C2810, 0x003C2940, 0x003C29CA, 0x003C29E0, 0x003C520A, 0x003C55C4, 0x003C55E0,
+    0x003C580A, 0x003C5D84, 0x003C5E10, 0x003C5F40, 0x003CFC0A, 0x003CFCE0, 0x003CFD0A, 0x003CFD80,
+    0x003CFDAA, 0x003CFDE0, 0x003CFE0A, 0x003CFFE0, 0x003D000A, 0x003D18A0, 0x003D1A04, 0x003D1AE0,
+    0x003D200A, 0x003D2884, 0x003D296A, 0x003D2980, 0x003D2A10, 0x003D2B40, 0x003DC00A, 0x003DC080,
+    0x003DC0AA, 0x003DC400, 0x003DC42A, 0x003DC460, 0x003DC48A, 0x003DC4A0, 0x003DC4EA, 0x003DC500,
+    0x003DC52A, 0x003DC660, 0x003DC68A, 0x003DC700, 0x003DC72A, 0x003DC740, 0x003DC76A, 0x003DC780,
+    0x003DC84A, 0x003DC860, 0x003DC8EA, 0x003DC900, 0x003DC92A, 0x003DC940, 0x003DC96A, 0x003DC980,
+    0x003DC9AA, 0x003DCA00, 0x003DCA2A, 0x003DCA60, 0x003DCA8A, 0x003DCAA0, 0x003DCAEA, 0x003DCB00,
+    0x003DCB2A, 0x003DCB40, 0x003DCB6A, 0x003DCB80, 0x003DCBAA, 0x003DCBC0, 0x003DCBEA, 0x003DCC00,
+    0x003DCC2A, 0x003DCC60, 0x003DCC8A, 0x003DCCA0, 0x003DCCEA, 0x003DCD60, 0x003DCD8A, 0x003DCE60,
+    0x003DCE8A, 0x003DCF00, 0x003DCF2A, 0x003DCFA0, 0x003DCFCA, 0x003DCFE0, 0x003DD00A, 0x003DD140,
+    0x003DD16A, 0x003DD380, 0x003DD42A, 0x003DD480, 0x003DD4AA, 0x003DD540, 0x003DD56A, 0x003DD780,
+    0x003E0013, 0x003E2000, 0x003E21B3, 0x003E2200, 0x003E25F3, 0x003E2600, 0x003E2D93, 0x003E2E40,
+    0x003E2FD3, 0x003E3000, 0x003E31D3, 0x003E31E0, 0x003E3233, 0x003E3360, 0x003E35B3, 0x003E3CC6,
+    0x003E4000, 0x003E4028, 0x003E4073, 0x003E4200, 0x003E4268, 0x003E4280, 0x003E4353, 0x003E4360,
+    0x003E45F3, 0x003E4600, 0x003E4653, 0x003E4760, 0x003E4793, 0x003E4800, 0x003E4933, 0x003E7F64,
+    0x003E8013, 0x003EA7C0, 0x003EA8D3, 0x003ECA00, 0x003ED013, 0x003EE000, 0x003EEE93, 0x003EF000,
+    0x003EFAB3, 0x003F0000, 0x003F0193, 0x003F0200, 0x003F0913, 0x003F0A00, 0x003F0B53, 0x003F0C00,
+    0x003F1113, 0x003F1200, 0x003F15D3, 0x003F2000, 0x003F2193, 0x003F2760, 0x003F2793, 0x003F28C0,
+    0x003F28F3, 0x003F6000, 0x003F7E10, 0x003F7F40, 0x003F8013, 0x003FFFC0, 0x00400014, 0x0054DC00,
+    0x0054E014, 0x0056E720, 0x0056E814, 0x005703C0, 0x00570414, 0x0059D440, 0x0059D614, 0x005D7C20,
+    0x005F0014, 0x005F43C0, 0x00600014, 0x00626960, 0x01C00027, 0x01C00040, 0x01C00404, 0x01C01000,
+    0x01C02004, 0x01C03E00,
+};
+
+enum Bidi_Class : u8
+{
+    Bidi_L,
+    Bidi_R,
+    Bidi_AL,
+    Bidi_EN,
+    Bidi_ES,
+    Bidi_ET,
+    Bidi_AN,
+    Bidi_CS,
+    Bidi_NSM,
+    Bidi_BN,
+    Bidi_B,
+    Bidi_S,
+    Bidi_WS,
+    Bidi_ON,
+    Bidi_LRE,
+    Bidi_LRO,
+    Bidi_RLE,
+    Bidi_RLO,
+    Bidi_PDF,
+    Bidi_LRI,
+    Bidi_RLI,
+    Bidi_FSI,
+    Bidi_PDI,
+};
+
+static u32 unicode_bidi_class_table[1184] =
+{
+    0x00000009, 0x0000012B, 0x0000014A, 0x0000016B, 0x0000018C, 0x000001AA, 0x000001C9, 0x0000038A,
+    0x000003EB, 0x0000040C, 0x0000042D, 0x00000465, 0x000004CD, 0x00000564, 0x00000587, 0x000005A4,
+    0x000005C7, 0x00000603, 0x00000747, 0x0000076D, 0x00000820, 0x00000B6D, 0x00000C20, 0x00000F6D,
+    0x00000FE9, 0x000010AA, 0x000010C9, 0x00001407, 0x0000142D, 0x00001445, 0x000014CD, 0x00001540,
+    0x0000156D, 0x000015A9, 0x000015CD, 0x00001605, 0x00001643, 0x0000168D, 0x000016A0, 0x000016CD,
+    0x00001723, 0x00001740, 0x0000176D, 0x00001800, 0x00001AED, 0x00001B00, 0x00001EED, 0x00001F00,
+    0x0000572D, 0x00005760, 0x0000584D, 0x00005A00, 0x00005A4D, 0x00005C00, 0x00005CAD, 0x00005DC0,
+    0x00005DED, 0x00006008, 0x00006E00, 0x00006E8D, 0x00006EC0, 0x00006FCD, 0x00006FE0, 0x0000708D,
+    0x000070C0, 0x000070ED, 0x00007100, 0x00007ECD, 0x00007EE0, 0x00009068, 0x00009140, 0x0000B14D,
+    0x0000B160, 0x0000B1AD, 0x0000B1E5, 0x0000B201, 0x0000B228, 0x0000B7C1, 0x0000B7E8, 0x0000B801,
+    0x0000B828, 0x0000B861, 0x0000B888, 0x0000B8C1, 0x0000B8E8, 0x0000B901, 0x0000C006, 0x0000C0CD,
+    0x0000C102, 0x0000C125, 0x0000C162, 0x0000C187, 0x0000C1A2, 0x0000C1CD, 0x0000C208, 0x0000C362,
+    0x0000C968, 0x0000CC06, 0x0000CD45, 0x0000CD66, 0x0000CDA2, 0x0000CE08, 0x0000CE22, 0x0000DAC8,
+    0x0000DBA6, 0x0000DBCD, 0x0000DBE8, 0x0000DCA2, 0x0000DCE8, 0x0000DD2D, 0x0000DD48, 0x0000DDC2,
+    0x0000DE03, 0x0000DF42, 0x0000E228, 0x0000E242, 0x0000E608, 0x0000E962, 0x0000F4C8, 0x0000F622,
+    0x0000F801, 0x0000FD68, 0x0000FE81, 0x0000FECD, 0x0000FF41, 0x0000FFA8, 0x0000FFC1, 0x000102C8,
+    0x00010341, 0x00010368, 0x00010481, 0x000104A8, 0x00010501, 0x00010528, 0x000105C1, 0x00010B28,
+    0x00010B81, 0x00010C02, 0x00011206, 0x00011242, 0x00011308, 0x00011402, 0x00011948, 0x00011C46,
+    0x00011C68, 0x00012060, 0x00012748, 0x00012760, 0x00012788, 0x000127A0, 0x00012828, 0x00012920,
+    0x000129A8, 0x000129C0, 0x00012A28, 0x00012B00, 0x00012C48, 0x00012C80, 0x00013028, 0x00013040,
+    0x00013788, 0x000137A0, 0x00013828, 0x000138A0, 0x000139A8, 0x000139C0, 0x00013C48, 0x00013C80,
+    0x00013E45, 0x00013E80, 0x00013F65, 0x00013F80, 0x00013FC8, 0x00013FE0, 0x00014028, 0x00014060,
+    0x00014788, 0x000147A0, 0x00014828, 0x00014860, 0x000148E8, 0x00014920, 0x00014968, 0x000149C0,
+    0x00014A28, 0x00014A40, 0x00014E08, 0x00014E40, 0x00014EA8, 0x00014EC0, 0x00015028, 0x00015060,
+    0x00015788, 0x000157A0, 0x00015828, 0x000158C0, 0x000158E8, 0x00015920, 0x000159A8, 0x000159C0,
+    0x00015C48, 0x00015C80, 0x00015E25, 0x00015E40, 0x00015F48, 0x00016000, 0x00016028, 0x00016040,
+    0x00016788, 0x000167A0, 0x000167E8, 0x00016800, 0x00016828, 0x000168A0, 0x000169A8, 0x000169C0,
+    0x00016AA8, 0x00016AE0, 0x00016C48, 0x00016C80, 0x00017048, 0x00017060, 0x00017808, 0x00017820,
+    0x000179A8, 0x000179C0, 0x00017E6D, 0x00017F25, 0x00017F4D, 0x00017F60, 0x00018008, 0x00018020,
+    0x00018088, 0x000180A0, 0x00018788, 0x000187A0, 0x000187C8, 0x00018820, 0x000188C8, 0x00018920,
+    0x00018948, 0x000189C0, 0x00018AA8, 0x00018AE0, 0x00018C48, 0x00018C80, 0x00018F0D, 0x00018FE0,
+    0x00019028, 0x00019040, 0x00019788, 0x000197A0, 0x00019988, 0x000199C0, 0x00019C48, 0x00019C80,
+    0x0001A008, 0x0001A040, 0x0001A768, 0x0001A7A0, 0x0001A828, 0x0001A8A0, 0x0001A9A8, 0x0001A9C0,
+    0x0001AC48, 0x0001AC80, 0x0001B028, 0x0001B040, 0x0001B948, 0x0001B960, 0x0001BA48, 0x0001BAA0,
+    0x0001BAC8, 0x0001BAE0, 0x0001C628, 0x0001C640, 0x0001C688, 0x0001C760, 0x0001C7E5, 0x0001C800,
+    0x0001C8E8, 0x0001C9E0, 0x0001D628, 0x0001D640, 0x0001D688, 0x0001D7A0, 0x0001D908, 0x0001D9C0,
+    0x0001E308, 0x0001E340, 0x0001E6A8, 0x0001E6C0, 0x0001E6E8, 0x0001E700, 0x0001E728, 0x0001E74D,
+    0x0001E7C0, 0x0001EE28, 0x0001EFE0, 0x0001F008, 0x0001F0A0, 0x0001F0C8, 0x0001F100, 0x0001F1A8,
+    0x0001F300, 0x0001F328, 0x0001F7A0, 0x0001F8C8, 0x0001F8E0, 0x000205A8, 0x00020620, 0x00020648,
+    0x00020700, 0x00020728, 0x00020760, 0x000207A8, 0x000207E0, 0x00020B08, 0x00020B40, 0x00020BC8,
+    0x00020C20, 0x00020E28, 0x00020EA0, 0x00021048, 0x00021060, 0x000210A8, 0x000210E0, 0x000211A8,
+    0x000211C0, 0x000213A8, 0x000213C0, 0x00026BA8, 0x00026C00, 0x0002720D, 0x00027340, 0x0002800D,
+    0x00028020, 0x0002D00C, 0x0002D020, 0x0002D36D, 0x0002D3A0, 0x0002E248, 0x0002E2A0, 0x0002E648,
+    0x0002E680, 0x0002EA48, 0x0002EA80, 0x0002EE48, 0x0002EE80, 0x0002F688, 0x0002F6C0, 0x0002F6E8,
+    0x0002F7C0, 0x0002F8C8, 0x0002F8E0, 0x0002F928, 0x0002FA80, 0x0002FB65, 0x0002FB80, 0x0002FBA8,
+    0x0002FBC0, 0x0002FE0D, 0x0002FF40, 0x0003000D, 0x00030168, 0x000301C9, 0x000301E8, 0x00030200,
+    0x000310A8, 0x000310E0, 0x00031528, 0x00031540, 0x00032408, 0x00032460, 0x000324E8, 0x00032520,
+    0x00032648, 0x00032660, 0x00032728, 0x00032780, 0x0003280D, 0x00032820, 0x0003288D, 0x000328C0,
+    0x00033BCD, 0x00034000, 0x000342E8, 0x00034320, 0x00034368, 0x00034380, 0x00034AC8, 0x00034AE0,
+    0x00034B08, 0x00034BE0, 0x00034C08, 0x00034C20, 0x00034C48, 0x00034C60, 0x00034CA8, 0x00034DA0,
+    0x00034E68, 0x00034FA0, 0x00034FE8, 0x00035000, 0x00035608, 0x000359E0, 0x00036008, 0x00036080,
+    0x00036688, 0x000366A0, 0x000366C8, 0x00036760, 0x00036788, 0x000367A0, 0x00036848, 0x00036860,
+    0x00036D68, 0x00036E80, 0x00037008, 0x00037040, 0x00037448, 0x000374C0, 0x00037508, 0x00037540,
+    0x00037568, 0x000375C0, 0x00037CC8, 0x00037CE0, 0x00037D08, 0x00037D40, 0x00037DA8, 0x00037DC0,
+    0x00037DE8, 0x00037E40, 0x00038588, 0x00038680, 0x000386C8, 0x00038700, 0x00039A08, 0x00039A60,
+    0x00039A88, 0x00039C20, 0x00039C48, 0x00039D20, 0x00039DA8, 0x00039DC0, 0x00039E88, 0x00039EA0,
+    0x00039F08, 0x00039F40, 0x0003B808, 0x0003C000, 0x0003F7AD, 0x0003F7C0, 0x0003F7ED, 0x0003F840,
+    0x0003F9AD, 0x0003FA00, 0x0003FBAD, 0x0003FC00, 0x0003FDAD, 0x0003FE00, 0x0003FFAD, 0x0003FFE0,
+    0x0004000C, 0x00040169, 0x000401C0, 0x000401E1, 0x0004020D, 0x0004050C, 0x0004052A, 0x0004054E,
+    0x00040570, 0x00040592, 0x000405AF, 0x000405D1, 0x000405E7, 0x00040605, 0x000406AD, 0x00040887,
+    0x000408AD, 0x00040BEC, 0x00040C09, 0x00040CA0, 0x00040CD3, 0x00040CF4, 0x00040D15, 0x00040D36,
+    0x00040D49, 0x00040E03, 0x00040E20, 0x00040E83, 0x00040F44, 0x00040F8D, 0x00040FE0, 0x00041003,
+    0x00041144, 0x0004118D, 0x000411E0, 0x00041405, 0x00041A08, 0x00041E20, 0x0004200D, 0x00042040,
+    0x0004206D, 0x000420E0, 0x0004210D, 0x00042140, 0x0004228D, 0x000422A0, 0x000422CD, 0x00042320,
+    0x000423CD, 0x00042480, 0x000424AD, 0x000424C0, 0x000424ED, 0x00042500, 0x0004252D, 0x00042540,
+    0x000425C5, 0x000425E0, 0x0004274D, 0x00042780, 0x0004280D, 0x000428A0, 0x0004294D, 0x000429C0,
+    0x00042A0D, 0x00042C00, 0x0004312D, 0x00043180, 0x0004320D, 0x00044244, 0x00044265, 0x0004428D,
+    0x000466C0, 0x00046F6D, 0x000472A0, 0x000472CD, 0x000484E0, 0x0004880D, 0x00048960, 0x00048C0D,
+    0x00049103, 0x00049380, 0x00049D4D, 0x0004D580, 0x0004D5AD, 0x00050000, 0x0005200D, 0x00056E80,
+    0x00056ECD, 0x000572C0, 0x000572ED, 0x00058000, 0x00059CAD, 0x00059D60, 0x00059DE8, 0x00059E40,
+    0x00059F2D, 0x0005A000, 0x0005AFE8, 0x0005B000, 0x0005BC08, 0x0005C00D, 0x0005CBC0, 0x0005D00D,
+    0x0005D340, 0x0005D36D, 0x0005DE80, 0x0005E00D, 0x0005FAC0, 0x0005FE0D, 0x0005FF80, 0x0006000C,
+    0x0006002D, 0x000600A0, 0x0006010D, 0x00060420, 0x00060548, 0x000605C0, 0x0006060D, 0x00060620,
+    0x000606CD, 0x00060700, 0x000607AD, 0x00060800, 0x00061328, 0x0006136D, 0x000613A0, 0x0006140D,
+    0x00061420, 0x00061F6D, 0x00061F80, 0x0006380D, 0x00063C80, 0x000643AD, 0x000643E0, 0x00064A0D,
+    0x00064C00, 0x00064F8D, 0x00064FE0, 0x0006562D, 0x00065800, 0x0006598D, 0x00065A00, 0x00066EED,
+    0x00066F60, 0x00067BCD, 0x00067C00, 0x00067FED, 0x00068000, 0x0009B80D, 0x0009C000, 0x0014920D,
+    0x001498E0, 0x0014C1AD, 0x0014C200, 0x0014CDE8, 0x0014CE6D, 0x0014CE88, 0x0014CFCD, 0x0014D000,
+    0x0014D3C8, 0x0014D400, 0x0014DE08, 0x0014DE40, 0x0014E00D, 0x0014E440, 0x0014F10D, 0x0014F120,
+    0x00150048, 0x00150060, 0x001500C8, 0x001500E0, 0x00150168, 0x00150180, 0x001504A8, 0x001504E0,
+    0x0015050D, 0x00150588, 0x001505A0, 0x00150705, 0x00150740, 0x00150E8D, 0x00150F00, 0x00151888,
+    0x001518C0, 0x00151C08, 0x00151E40, 0x00151FE8, 0x00152000, 0x001524C8, 0x001525C0, 0x001528E8,
+    0x00152A40, 0x00153008, 0x00153060, 0x00153668, 0x00153680, 0x001536C8, 0x00153740, 0x00153788,
+    0x001537C0, 0x00153CA8, 0x00153CC0, 0x00154528, 0x001545E0, 0x00154628, 0x00154660, 0x001546A8,
+    0x001546E0, 0x00154868, 0x00154880, 0x00154988, 0x001549A0, 0x00154F88, 0x00154FA0, 0x00155608,
+    0x00155620, 0x00155648, 0x001556A0, 0x001556E8, 0x00155720, 0x001557C8, 0x00155800, 0x00155828,
+    0x00155840, 0x00155D88, 0x00155DC0, 0x00155EC8, 0x00155EE0, 0x00156D4D, 0x00156D80, 0x00157CA8,
+    0x00157CC0, 0x00157D08, 0x00157D20, 0x00157DA8, 0x00157DC0, 0x001F63A1, 0x001F63C8, 0x001F63E1,
+    0x001F6524, 0x001F6541, 0x001F6A02, 0x001FA7CD, 0x001FAA02, 0x001FB9ED, 0x001FBA09, 0x001FBE02,
+    0x001FBFAD, 0x001FC008, 0x001FC20D, 0x001FC340, 0x001FC408, 0x001FC60D, 0x001FCA07, 0x001FCA2D,
+    0x001FCA47, 0x001FCA60, 0x001FCA8D, 0x001FCAA7, 0x001FCACD, 0x001FCBE5, 0x001FCC0D, 0x001FCC44,
+    0x001FCC8D, 0x001FCCE0, 0x001FCD0D, 0x001FCD25, 0x001FCD6D, 0x001FCD80, 0x001FCE02, 0x001FDFE9,
+    0x001FE000, 0x001FE02D, 0x001FE065, 0x001FE0CD, 0x001FE164, 0x001FE187, 0x001FE1A4, 0x001FE1C7,
+    0x001FE203, 0x001FE347, 0x001FE36D, 0x001FE420, 0x001FE76D, 0x001FE820, 0x001FEB6D, 0x001FECC0,
+    0x001FFC05, 0x001FFC4D, 0x001FFCA5, 0x001FFCE0, 0x001FFD0D, 0x001FFDE0, 0x001FFF2D, 0x001FFFC9,
+    0x00200000, 0x0020202D, 0x00202040, 0x0020280D, 0x002031A0, 0x0020320D, 0x002033A0, 0x0020340D,
+    0x00203420, 0x00203FA8, 0x00203FC0, 0x00205C08, 0x00205C23, 0x00205F80, 0x00206EC8, 0x00206F60,
+    0x00210001, 0x002123ED, 0x00212401, 0x00214028, 0x00214081, 0x002140A8, 0x002140E1, 0x00214188,
+    0x00214201, 0x00214708, 0x00214761, 0x002147E8, 0x00214801, 0x00215CA8, 0x00215CE1, 0x0021672D,
+    0x00216801, 0x0021A002, 0x0021A488, 0x0021A502, 0x0021A606, 0x0021A742, 0x0021A801, 0x0021CC06,
+    0x0021CFE1, 0x0021D568, 0x0021D5A1, 0x0021D802, 0x0021E001, 0x0021E602, 0x0021E8C8, 0x0021EA22,
+    0x0021EE01, 0x0021F048, 0x0021F0C1, 0x00220000, 0x00220028, 0x00220040, 0x00220708, 0x002208E0,
+    0x00220A4D, 0x00220CC0, 0x00220E08, 0x00220E20, 0x00220E68, 0x00220EA0, 0x00220FE8, 0x00221040,
+    0x00221668, 0x002216E0, 0x00221728, 0x00221760, 0x00221848, 0x00221860, 0x00222008, 0x00222060,
+    0x002224E8, 0x00222580, 0x002225A8, 0x002226A0, 0x00222E68, 0x00222E80, 0x00223008, 0x00223040,
+    0x002236C8, 0x002237E0, 0x00223928, 0x002239A0, 0x002239E8, 0x00223A00, 0x002245E8, 0x00224640,
+    0x00224688, 0x002246A0, 0x002246C8, 0x00224700, 0x002247C8, 0x002247E0, 0x00225BE8, 0x00225C00,
+    0x00225C68, 0x00225D60, 0x00226008, 0x00226040, 0x00226768, 0x002267A0, 0x00226808, 0x00226820,
+    0x00226CC8, 0x00226DA0, 0x00226E08, 0x00226EA0, 0x00228708, 0x00228800, 0x00228848, 0x002288A0,
+    0x002288C8, 0x002288E0, 0x00228BC8, 0x00228BE0, 0x00229668, 0x00229720, 0x00229748, 0x00229760,
+    0x002297E8, 0x00229820, 0x00229848, 0x00229880, 0x0022B648, 0x0022B6C0, 0x0022B788, 0x0022B7C0,
+    0x0022B7E8, 0x0022B820, 0x0022BB88, 0x0022BBC0, 0x0022C668, 0x0022C760, 0x0022C7A8, 0x0022C7C0,
+    0x0022C7E8, 0x0022C820, 0x0022CC0D, 0x0022CDA0, 0x0022D568, 0x0022D580, 0x0022D5A8, 0x0022D5C0,
+    0x0022D608, 0x0022D6C0, 0x0022D6E8, 0x0022D700, 0x0022E3A8, 0x0022E400, 0x0022E448, 0x0022E4C0,
+    0x0022E4E8, 0x0022E580, 0x002305E8, 0x00230700, 0x00230728, 0x00230760, 0x00232768, 0x002327A0,
+    0x002327C8, 0x002327E0, 0x00232868, 0x00232880, 0x00233A88, 0x00233B00, 0x00233B48, 0x00233B80,
+    0x00233C08, 0x00233C20, 0x00234028, 0x002340E0, 0x00234128, 0x00234160, 0x00234668, 0x00234720,
+    0x00234768, 0x002347E0, 0x002348E8, 0x00234900, 0x00234A28, 0x00234AE0, 0x00234B28, 0x00234B80,
+    0x00235148, 0x002352E0, 0x00235308, 0x00235340, 0x00238608, 0x002386E0, 0x00238708, 0x002387C0,
+    0x00239248, 0x00239500, 0x00239548, 0x00239620, 0x00239648, 0x00239680, 0x002396A8, 0x002396E0,
+    0x0023A628, 0x0023A6E0, 0x0023A748, 0x0023A760, 0x0023A788, 0x0023A7C0, 0x0023A7E8, 0x0023A8C0,
+    0x0023A8E8, 0x0023A900, 0x0023B208, 0x0023B240, 0x0023B2A8, 0x0023B2C0, 0x0023B2E8, 0x0023B300,
+    0x0023DE68, 0x0023DEA0, 0x0023FAAD, 0x0023FBA5, 0x0023FC2D, 0x0023FE40, 0x002D5E08, 0x002D5EA0,
+    0x002D6608, 0x002D66E0, 0x002DE9E8, 0x002DEA00, 0x002DF1E8, 0x002DF260, 0x002DFC4D, 0x002DFC60,
+    0x002DFC88, 0x002DFCA0, 0x003793A8, 0x003793E0, 0x00379409, 0x00379480, 0x0039E008, 0x0039E5C0,
+    0x0039E608, 0x0039E8E0, 0x003A2CE8, 0x003A2D40, 0x003A2E69, 0x003A2F68, 0x003A3060, 0x003A30A8,
+    0x003A3180, 0x003A3548, 0x003A35C0, 0x003A3D2D, 0x003A3D60, 0x003A400D, 0x003A4848, 0x003A48AD,
+    0x003A48C0, 0x003A600D, 0x003A6AE0, 0x003ADB6D, 0x003ADB80, 0x003AE2AD, 0x003AE2C0, 0x003AE9ED,
+    0x003AEA00, 0x003AF12D, 0x003AF140, 0x003AF86D, 0x003AF880, 0x003AF9C3, 0x003B0000, 0x003B4008,
+    0x003B46E0, 0x003B4768, 0x003B4DA0, 0x003B4EA8, 0x003B4EC0, 0x003B5088, 0x003B50A0, 0x003B5368,
+    0x003B5400, 0x003B5428, 0x003B5600, 0x003C0008, 0x003C00E0, 0x003C0108, 0x003C0320, 0x003C0368,
+    0x003C0440, 0x003C0468, 0x003C04A0, 0x003C04C8, 0x003C0560, 0x003C2608, 0x003C26E0, 0x003C55C8,
+    0x003C55E0, 0x003C5D88, 0x003C5E00, 0x003C5FE5, 0x003C6000, 0x003D0001, 0x003D1A08, 0x003D1AE1,
+    0x003D2888, 0x003D2961, 0x003D8E02, 0x003D9801, 0x003DA002, 0x003DAA01, 0x003DC002, 0x003DDE0D,
+    0x003DDE42, 0x003DE001, 0x003E000D, 0x003E0580, 0x003E060D, 0x003E1280, 0x003E140D, 0x003E15E0,
+    0x003E162D, 0x003E1800, 0x003E182D, 0x003E1A00, 0x003E1A2D, 0x003E1EC0, 0x003E2003, 0x003E216D,
+    0x003E2200, 0x003E25ED, 0x003E2600, 0x003E2D4D, 0x003E2E00, 0x003E35AD, 0x003E35C0, 0x003E4C0D,
+    0x003E4CC0, 0x003E600D, 0x003EDB00, 0x003EDBAD, 0x003EDDA0, 0x003EDE0D, 0x003EDFA0, 0x003EE00D,
+    0x003EEE80, 0x003EF00D, 0x003EFB20, 0x003EFC0D, 0x003EFD80, 0x003EFE0D, 0x003EFE20, 0x003F000D,
+    0x003F0180, 0x003F020D, 0x003F0900, 0x003F0A0D, 0x003F0B40, 0x003F0C0D, 0x003F1100, 0x003F120D,
+    0x003F15C0, 0x003F160D, 0x003F1640, 0x003F200D, 0x003F4A80, 0x003F4C0D, 0x003F4DC0, 0x003F4E0D,
+    0x003F4EA0, 0x003F4F0D, 0x003F4FA0, 0x003F500D, 0x003F50E0, 0x003F520D, 0x003F55A0, 0x003F560D,
+    0x003F5760, 0x003F580D, 0x003F58C0, 0x003F5A0D, 0x003F5B40, 0x003F5C0D, 0x003F5D00, 0x003F5E0D,
+    0x003F5EE0, 0x003F600D, 0x003F7260, 0x003F728D, 0x003F7960, 0x003F7E03, 0x003F7F40, 0x003FFFC9,
+    0x00400000, 0x005FFFC9, 0x00600000, 0x007FFFC9, 0x00800000, 0x009FFFC9, 0x00A00000, 0x00BFFFC9,
+    0x00C00000, 0x00DFFFC9, 0x00E00000, 0x00FFFFC9, 0x01000000, 0x011FFFC9, 0x01200000, 0x013FFFC9,
+    0x01400000, 0x015FFFC9, 0x01600000, 0x017FFFC9, 0x01800000, 0x019FFFC9, 0x01A00000, 0x01BFFFC9,
+    0x01C02008, 0x01C03E09, 0x01C20000, 0x01DFFFC9, 0x01E00000, 0x01FFFFC9, 0x02000000, 0x021FFFC9,
+};
+